@@ -39,6 +39,7 @@ exclusion = [
     "sdk/python/docs/conf.py",
     "sdk/python/touca/cli/__init__.py",
     "sdk/cpp/docs/sphinx/conf.py",
+    "sdk/cpp/include/touca/impl/comparison_schema.hpp",
     "sdk/cpp/include/touca/impl/schema.hpp",
     "web/next-env.d.ts",
 ]
@@ -0,0 +1,94 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+/**
+ * Measures how fast numeric arrays are compared element by element.
+ *
+ * usage: touca_benchmark_compare_arrays [size]
+ *
+ * Arrays of each numeric type, with one in every thousand elements
+ * changed, are compared with each kernel that the processor supports and
+ * as data points, which includes packing their elements.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "touca/core/array_kernels.hpp"
+#include "touca/core/comparison.hpp"
+#include "touca/core/types.hpp"
+
+using Clock = std::chrono::steady_clock;
+using touca::detail::ArrayKernel;
+
+double elapsed_seconds(const Clock::time_point& start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename T>
+void run(const std::string& name, const std::size_t size) {
+  std::vector<T> src(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    src[i] = static_cast<T>(i % 1000);
+  }
+  auto dst = src;
+  for (std::size_t i = 0; i < size; i += 1000) {
+    dst[i] = static_cast<T>(dst[i] + 1);
+  }
+
+  std::cout << fmt::format("{:<10}", name);
+  std::size_t matches = 0u;
+  for (const auto kernel :
+       {ArrayKernel::Scalar, ArrayKernel::SSE2, ArrayKernel::AVX2}) {
+    if (touca::detail::best_array_kernel() < kernel) {
+      std::cout << fmt::format(" {:>10}", "-");
+      continue;
+    }
+    const auto start = Clock::now();
+    const auto& cmp = touca::detail::compare_numeric_arrays(
+        src.data(), dst.data(), size, 64, kernel);
+    const auto time = elapsed_seconds(start);
+    if (kernel == ArrayKernel::Scalar) {
+      matches = cmp.matches;
+    } else if (matches != cmp.matches) {
+      throw std::runtime_error("kernels do not agree");
+    }
+    std::cout << fmt::format(" {:>10.3f}", time * 1e3);
+  }
+
+  touca::array lhs;
+  touca::array rhs;
+  for (std::size_t i = 0; i < size; ++i) {
+    lhs.add(src[i]);
+    rhs.add(dst[i]);
+  }
+  const touca::data_point left(lhs);
+  const touca::data_point right(rhs);
+  const auto start = Clock::now();
+  const auto& cmp = touca::compare(left, right);
+  const auto time = elapsed_seconds(start);
+  std::cout << fmt::format(" {:>10.3f} {:>8.4f}\n", time * 1e3, cmp.score);
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t size =
+      argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000u;
+  if (size == 0u) {
+    std::cerr << "size of arrays must be positive\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << fmt::format("arrays of {} elements, milliseconds\n\n", size);
+  std::cout << fmt::format("{:<10} {:>10} {:>10} {:>10} {:>10} {:>8}\n",
+                           "type", "scalar", "sse2", "avx2", "compare",
+                           "score");
+  run<std::int64_t>("signed", size);
+  run<std::uint64_t>("unsigned", size);
+  run<float>("float", size);
+  run<double>("double", size);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+/**
+ * Measures how well each supported codec compresses serialized testcases.
+ *
+ * usage: touca_benchmark_compression [result-file ...]
+ *
+ * Testcases are read from the given binary result files. When no file is
+ * given, a synthetic set of testcases is generated instead.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+#include "touca/core/compression.hpp"
+#include "touca/core/deserialize.hpp"
+#include "touca/core/testcase.hpp"
+
+using Buffer = std::vector<std::uint8_t>;
+using Clock = std::chrono::steady_clock;
+
+struct Codec {
+  touca::Compression codec;
+  int level;
+  std::string name;
+};
+
+std::vector<Buffer> synthesize_testcases(const std::size_t count) {
+  std::vector<Buffer> buffers;
+  for (auto i = 0u; i < count; ++i) {
+    touca::Testcase testcase("acme", "students", "1.0",
+                             fmt::format("student-{:05}", i));
+    testcase.check("username", touca::data_point::string(
+                                   fmt::format("student-{:05}", i)));
+    testcase.check("is_active", touca::data_point::boolean(i % 3 != 0));
+    testcase.check("courses_count", touca::data_point::number_unsigned(i % 7));
+    for (auto j = 0u; j < 64u; ++j) {
+      const auto gpa = 2.0 + ((i * 31 + j) % 200) / 100.0;
+      const auto course = fmt::format("course-{}", j % 9);
+      testcase.add_array_element("gpa", touca::data_point::number_double(gpa));
+      testcase.add_array_element("courses", touca::data_point::string(course));
+    }
+    testcase.add_metric("duration", static_cast<unsigned>(i % 100));
+    buffers.emplace_back(testcase.flatbuffers());
+  }
+  return buffers;
+}
+
+std::vector<Buffer> load_testcases(const std::vector<std::string>& paths) {
+  std::vector<Buffer> buffers;
+  for (const auto& path : paths) {
+    for (const auto& kvp : touca::deserialize_file(path)) {
+      buffers.emplace_back(kvp.second->flatbuffers());
+    }
+  }
+  return buffers;
+}
+
+double elapsed_seconds(const Clock::time_point& start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void run(const Codec& codec, const std::vector<Buffer>& buffers,
+         const std::size_t raw_size) {
+  std::vector<Buffer> frames;
+  frames.reserve(buffers.size());
+  std::size_t frame_size = 0u;
+  const auto compress_start = Clock::now();
+  for (const auto& buffer : buffers) {
+    frames.emplace_back(touca::detail::compress(codec.codec, codec.level,
+                                                buffer.data(), buffer.size()));
+    frame_size += frames.back().size();
+  }
+  const auto compress_time = elapsed_seconds(compress_start);
+
+  const auto decompress_start = Clock::now();
+  for (auto i = 0u; i < frames.size(); ++i) {
+    const auto& output =
+        touca::detail::decompress(codec.codec, frames[i].data(),
+                                  frames[i].size(), buffers[i].size());
+    if (output != buffers[i]) {
+      throw std::runtime_error("decompressed testcase does not match input");
+    }
+  }
+  const auto decompress_time = elapsed_seconds(decompress_start);
+
+  const auto megabytes = raw_size / (1024.0 * 1024.0);
+  std::cout << fmt::format("{:<10} {:>10} {:>8.3f} {:>12.1f} {:>12.1f}\n",
+                           codec.name, frame_size,
+                           static_cast<double>(raw_size) / frame_size,
+                           megabytes / compress_time,
+                           megabytes / decompress_time);
+}
+
+int main(int argc, char* argv[]) {
+  const std::vector<std::string> paths(argv + 1, argv + argc);
+  const auto& buffers =
+      paths.empty() ? synthesize_testcases(2000u) : load_testcases(paths);
+  std::size_t raw_size = 0u;
+  for (const auto& buffer : buffers) {
+    raw_size += buffer.size();
+  }
+  std::cout << fmt::format("{} testcases, {} bytes\n\n", buffers.size(),
+                           raw_size);
+  std::cout << fmt::format("{:<10} {:>10} {:>8} {:>12} {:>12}\n", "codec",
+                           "bytes", "ratio", "comp MB/s", "decomp MB/s");
+
+  const std::vector<Codec> codecs = {
+      {touca::Compression::Lz4, 0, "lz4"},
+      {touca::Compression::Lz4, 9, "lz4hc-9"},
+      {touca::Compression::Zstd, 1, "zstd-1"},
+      {touca::Compression::Zstd, 3, "zstd-3"},
+      {touca::Compression::Zstd, 9, "zstd-9"},
+      {touca::Compression::Zstd, 19, "zstd-19"}};
+  for (const auto& codec : codecs) {
+    if (touca::is_supported(codec.codec)) {
+      run(codec, buffers, raw_size);
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+/**
+ * Measures how fast data points are rendered as strings, as is done for
+ * every value that is included in the comparison results.
+ *
+ * usage: touca_benchmark_to_string [iterations]
+ *
+ * Each kind of value is rendered with the writer that `to_string` used
+ * before, with `to_string` and with `to_string` into a reused buffer.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fmt/format.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "touca/core/types.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct Sample {
+  std::string name;
+  touca::data_point value;
+};
+
+std::vector<Sample> make_samples() {
+  const std::vector<std::pair<std::string, double>> grades(
+      16, std::make_pair(std::string("course-1"), 3.75));
+  touca::object student("Student");
+  student.add("username", "student-00001");
+  student.add("is_active", true);
+  student.add("credits", std::vector<unsigned>(16, 4u));
+  student.add("grades", grades);
+  return {
+      {"signed", touca::data_point::number_signed(-1234567)},
+      {"unsigned", touca::data_point::number_unsigned(1234567u)},
+      {"boolean", touca::data_point::boolean(true)},
+      {"double", touca::data_point::number_double(3.14159)},
+      {"string", touca::data_point::string("student-00001")},
+      {"object", touca::data_point(student)}};
+}
+
+double elapsed_seconds(const Clock::time_point& start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::string render_with_writer(const touca::data_point& value) {
+  if (value.type() == touca::detail::internal_type::string) {
+    return *value.as_string();
+  }
+  rapidjson::StringBuffer strbuf;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(strbuf);
+  writer.SetMaxDecimalPlaces(3);
+  value.write_json(writer);
+  return strbuf.GetString();
+}
+
+void run(const Sample& sample, const std::size_t iterations) {
+  std::size_t size = 0u;
+  const auto writer_start = Clock::now();
+  for (auto i = 0u; i < iterations; ++i) {
+    size += render_with_writer(sample.value).size();
+  }
+  const auto writer_time = elapsed_seconds(writer_start);
+
+  const auto string_start = Clock::now();
+  for (auto i = 0u; i < iterations; ++i) {
+    size += sample.value.to_string().size();
+  }
+  const auto string_time = elapsed_seconds(string_start);
+
+  std::string buffer;
+  const auto buffer_start = Clock::now();
+  for (auto i = 0u; i < iterations; ++i) {
+    sample.value.to_string(buffer);
+    size += buffer.size();
+  }
+  const auto buffer_time = elapsed_seconds(buffer_start);
+
+  if (buffer != render_with_writer(sample.value) ||
+      size != 3 * iterations * buffer.size()) {
+    throw std::runtime_error("rendered values do not match");
+  }
+  const auto ns = 1e9 / iterations;
+  std::cout << fmt::format("{:<10} {:>10.1f} {:>10.1f} {:>10.1f} {:>8.2f}\n",
+                           sample.name, writer_time * ns, string_time * ns,
+                           buffer_time * ns, writer_time / buffer_time);
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t iterations =
+      argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000u;
+  if (iterations == 0u) {
+    std::cerr << "number of iterations must be positive\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << fmt::format("{} iterations, nanoseconds per value\n\n",
+                           iterations);
+  std::cout << fmt::format("{:<10} {:>10} {:>10} {:>10} {:>8}\n", "value",
+                           "writer", "to_string", "buffer", "speedup");
+  for (const auto& sample : make_samples()) {
+    run(sample, iterations);
+  }
+  return EXIT_SUCCESS;
+}
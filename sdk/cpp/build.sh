@@ -11,6 +11,7 @@ usage: $(basename "$0") [ -h | --long-options]
   --with-tests              include client library unittests in build
   --with-cli                include client-side utility application in build
   --with-examples           include sample regression test tool in build
+  --with-benchmarks         include performance benchmarks in build
   --without-runner          exclude regression test runner
   --all                     include all components
 
@@ -207,6 +208,7 @@ build_build () {
         -DTOUCA_BUILD_TESTS="$(cmake_option "with-tests")"
         -DTOUCA_BUILD_CLI="$(cmake_option "with-cli")"
         -DTOUCA_BUILD_EXAMPLES="$(cmake_option "with-examples")"
+        -DTOUCA_BUILD_BENCHMARKS="$(cmake_option "with-benchmarks")"
         -DTOUCA_BUILD_RUNNER="$(cmake_option "with-runner")"
         -DTOUCA_ENABLE_COVERAGE="$(cmake_option "with-coverage")"
     )
@@ -326,18 +328,25 @@ build_docs () {
 
 build_schema () {
     if [ $# -ne 1 ]; then return 1; fi
-    check_prerequisite_commands "flatc"
+    check_prerequisite_commands "flatc" "clang-format"
     local dir_root
     dir_root="$(dirname "$(dirname "${TOUCA_CLIENT_ROOT_DIR}")")"
-    local file_schema="${dir_root}/config/flatbuffers/touca.fbs"
+    local dir_schema="${dir_root}/config/flatbuffers"
     local dir_out="${TOUCA_CLIENT_ROOT_DIR}/include/touca/impl/"
-    if [ ! -f "$file_schema" ]; then
-        log_error "schema file does not exit: ${file_schema}"
-    fi
-    flatc --cpp --scoped-enums -o "$dir_out" "$file_schema"
+    for file_schema in "${dir_schema}/touca.fbs" "${dir_schema}/comparison.fbs"; do
+        if [ ! -f "$file_schema" ]; then
+            log_error "schema file does not exit: ${file_schema}"
+        fi
+    done
+    flatc --cpp --scoped-enums -o "$dir_out" "${dir_schema}/touca.fbs"
     mv "$dir_out/touca_generated.h" "$dir_out/schema.hpp"
-    log_info "regenerated flatbuffers code based on schema file"
-    clang-format -i "$dir_out/schema.hpp" \
+    # comparison results have a schema of their own that builds on the first
+    flatc --cpp --scoped-enums -o "$dir_out" "${dir_schema}/comparison.fbs"
+    sed -e 's|#include "touca_generated.h"|#include "touca/impl/schema.hpp"|' \
+        "$dir_out/comparison_generated.h" > "$dir_out/comparison_schema.hpp"
+    rm "$dir_out/comparison_generated.h"
+    log_info "regenerated flatbuffers code based on schema files"
+    clang-format -i "$dir_out/schema.hpp" "$dir_out/comparison_schema.hpp" \
         --style="{Language: Cpp, BasedOnStyle: Google, DerivePointerAlignment: false, PointerAlignment: Left}"
 }
 
@@ -366,6 +375,7 @@ declare -A BUILD_OPTIONS=(
     ["with-tests"]=0
     ["with-cli"]=0
     ["with-examples"]=0
+    ["with-benchmarks"]=0
     ["with-runner"]=1
     ["with-coverage"]=0
 )
@@ -431,6 +441,9 @@ for arg in "$@"; do
         "--with-examples")
             BUILD_OPTIONS["with-examples"]=1
             ;;
+        "--with-benchmarks")
+            BUILD_OPTIONS["with-benchmarks"]=1
+            ;;
         "--without-runner")
             BUILD_OPTIONS["with-runner"]=0
             ;;
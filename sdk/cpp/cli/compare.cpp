@@ -2,6 +2,11 @@
 
 #include <unordered_map>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
 #include "cxxopts.hpp"
 #include "operations.hpp"
 #include "touca/core/comparison.hpp"
@@ -13,7 +18,18 @@ bool CompareOperation::parse_impl(int argc, char* argv[]) {
   // clang-format off
     options.add_options("main")
         ("src", "file or directory to compare", cxxopts::value<std::string>())
-        ("dst", "file or directory to compare against", cxxopts::value<std::string>());
+        ("dst", "file or directory to compare against", cxxopts::value<std::string>())
+        ("verify", "how to verify given files: full, checksum or lazy", cxxopts::value<std::string>()->default_value("full"))
+        ("format", "format of the comparison result: json, or binary which is held in memory until all testcases are compared", cxxopts::value<std::string>()->default_value("json"))
+        ("preview-size", "maximum number of bytes with which to report each value, or 0 for no limit", cxxopts::value<std::size_t>()->default_value("0"))
+        ("summary", "report no more than an overview of each common testcase", cxxopts::value<bool>()->default_value("false"))
+        ("jobs", "number of threads with which to compare testcases, or 0 for one per hardware thread", cxxopts::value<std::size_t>()->default_value("1"))
+        ("cache-dir", "directory in which to keep comparison results of testcases for later runs", cxxopts::value<std::string>())
+        ("cache-size", "maximum size of kept comparison results in megabytes, or 0 for no limit", cxxopts::value<std::size_t>()->default_value("256"))
+        ("align-arrays", "match elements of arrays of objects by identity instead of position", cxxopts::value<bool>()->default_value("false"))
+        ("identity", "member whose value identifies objects of aligned arrays, instead of their content", cxxopts::value<std::string>())
+        ("max-hunks", "maximum number of ranges of different lines to report for each string of many lines", cxxopts::value<std::size_t>()->default_value("5"))
+        ("max-line-edits", "maximum number of different lines up to which strings are compared line by line", cxxopts::value<std::size_t>()->default_value("1000"));
   // clang-format on
   options.allow_unrecognised_options();
 
@@ -39,14 +55,49 @@ bool CompareOperation::parse_impl(int argc, char* argv[]) {
   _src = result["src"].as<std::string>();
   _dst = result["dst"].as<std::string>();
 
+  try {
+    _options.verify =
+        touca::parse_verify_mode(result["verify"].as<std::string>());
+    _options.format =
+        touca::parse_comparison_format(result["format"].as<std::string>());
+  } catch (const std::exception& ex) {
+    print_error(touca::detail::format("{}\n", ex.what()));
+    return false;
+  }
+
+  _options.preview_size = result["preview-size"].as<std::size_t>();
+  _options.summary_only = result["summary"].as<bool>();
+  _options.jobs = result["jobs"].as<std::size_t>();
+  if (result.count("cache-dir")) {
+    _options.cache_directory = result["cache-dir"].as<std::string>();
+  }
+  _options.cache_size =
+      static_cast<std::uintmax_t>(result["cache-size"].as<std::size_t>())
+      << 20;
+  if (result["align-arrays"].as<bool>()) {
+    _options.array_alignment = touca::ArrayAlignment::Identity;
+  }
+  if (result.count("identity")) {
+    _options.identity_member = result["identity"].as<std::string>();
+  }
+  _options.max_hunks = result["max-hunks"].as<std::size_t>();
+  _options.max_line_edits = result["max-line-edits"].as<std::size_t>();
+
   return true;
 }
 
 bool CompareOperation::run_impl() const {
   try {
-    const auto& res = touca::compare(touca::deserialize_file(_src),
-                                     touca::deserialize_file(_dst));
-    fmt::print(stdout, "{}\n", res.json());
+#ifdef _WIN32
+    // keep windows from translating line feeds in binary output
+    if (_options.format == touca::ComparisonFormat::Binary) {
+      _setmode(_fileno(stdout), _O_BINARY);
+    }
+#endif
+    touca::write_comparison(stdout, _src, _dst, _options);
+    if (_options.format == touca::ComparisonFormat::Json) {
+      fmt::print(stdout, "\n");
+    }
     return true;
   } catch (const std::exception& ex) {
     print_error(
@@ -5,6 +5,9 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include "touca/core/comparison.hpp"
 
 struct Operation {
   enum class Command { compare, unknown, view };
@@ -45,6 +48,7 @@ struct ViewOperation : public Operation {
 
  private:
   std::string _src;
+  std::vector<std::string> _testcases;
 };
 
 struct CompareOperation : public Operation {
@@ -56,6 +60,7 @@ struct CompareOperation : public Operation {
  private:
   std::string _src;
   std::string _dst;
+  touca::ComparisonOptions _options;
 };
 
 void print_error(const std::string& msg);
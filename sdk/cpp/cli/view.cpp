@@ -4,12 +4,14 @@
 #include "operations.hpp"
 #include "touca/core/deserialize.hpp"
 #include "touca/core/filesystem.hpp"
+#include "touca/core/result_file.hpp"
 
 bool ViewOperation::parse_impl(int argc, char* argv[]) {
   cxxopts::Options options("touca_cli --mode=view");
   // clang-format off
     options.add_options("main")
-        ("src", "result file to view in json format", cxxopts::value<std::string>());
+        ("src", "result file to view in json format", cxxopts::value<std::string>())
+        ("testcase", "name of a testcase to view (can be repeated)", cxxopts::value<std::vector<std::string>>());
   // clang-format on
   options.allow_unrecognised_options();
   const auto& result = options.parse(argc, argv);
@@ -19,6 +21,9 @@ bool ViewOperation::parse_impl(int argc, char* argv[]) {
     return false;
   }
   _src = result["src"].as<std::string>();
+  if (result.count("testcase")) {
+    _testcases = result["testcase"].as<std::vector<std::string>>();
+  }
   if (!touca::filesystem::is_regular_file(_src)) {
     print_error(touca::detail::format("file `{}` does not exist\n", _src));
     return false;
@@ -28,8 +33,16 @@ bool ViewOperation::parse_impl(int argc, char* argv[]) {
 
 bool ViewOperation::run_impl() const {
   try {
-    const auto& elements_map = touca::deserialize_file(_src);
-    fmt::print(stdout, "{}\n", elements_map_to_json(elements_map));
+    touca::ElementsMap elements_map;
+    if (_testcases.empty()) {
+      elements_map = touca::deserialize_file(_src);
+    }
+    for (const auto& name : _testcases) {
+      elements_map.emplace(name, std::make_shared<touca::Testcase>(
+                                     touca::read_testcase(_src, name)));
+    }
+    touca::write_json(stdout, elements_map);
+    fmt::print(stdout, "\n");
     return true;
   } catch (const std::exception& ex) {
     print_error(
@@ -59,6 +59,30 @@ class TOUCA_CLIENT_API ClientImpl {
             const std::vector<std::string>& testcases, const DataFormat format,
             const bool overwrite) const;
 
+  /**
+   * Provides the content that `save` would write to disk for given
+   * testcases, so that it can be written separately.
+   */
+  std::vector<std::uint8_t> serialize(const std::vector<std::string>& testcases,
+                                      const DataFormat format) const;
+
+  /**
+   * Serializes a given testcase for `ResultFileWriter`, which stores each
+   * testcase on its own.
+   *
+   * @param testcase name of the testcase to serialize
+   * @param options options of the result file to which the testcase is
+   *                appended
+   */
+  std::vector<std::uint8_t> serialize_message(
+      const std::string& testcase, const SerializationOptions& options) const;
+
+  /**
+   * @return options with which testcases are encoded when they are stored
+   *         in binary format
+   */
+  SerializationOptions serialization_options() const;
+
   Post::Status post(const Post::Options& options = {}) const;
 
   void seal() const;
@@ -85,11 +109,11 @@ class TOUCA_CLIENT_API ClientImpl {
   std::vector<Testcase> find_testcases(
       const std::vector<std::string>& names) const;
 
-  void save_json(const touca::filesystem::path& path,
-                 const std::vector<Testcase>& testcases) const;
+  std::vector<const Testcase*> list_testcases(
+      const std::vector<std::string>& names) const;
 
-  void save_flatbuffers(const touca::filesystem::path& path,
-                        const std::vector<Testcase>& testcases) const;
+  std::vector<std::uint8_t> serialize_flatbuffers(
+      const std::vector<Testcase>& testcases) const;
 
   void notify_loggers(const touca::logger::Level severity,
                       const std::string& msg) const;
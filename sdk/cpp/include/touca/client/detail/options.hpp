@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <vector>
@@ -96,6 +97,32 @@ struct ClientOptions {
    * functions such as `touca::check` will affect the newly declared test case.
    */
   bool concurrency = true;
+
+  /**
+   * Use compact encodings when writing test results to binary files
+   *
+   * Determines whether result files written to the local filesystem should
+   * store homogeneous arrays of booleans and numbers as packed vectors, store
+   * keys and metadata in a string table shared by all testcases instead of
+   * repeating them in every testcase, and store values captured more than once
+   * in the same testcase only once. Such files are smaller and faster to read,
+   * but cannot be read by earlier versions of the Touca SDKs and CLI. Test
+   * results submitted to the Touca server are not affected by this option.
+   * Defaults to `false`.
+   */
+  bool compact_binary = false;
+
+  /**
+   * Compress testcases in binary result files
+   *
+   * Name of the codec with which testcases in result files written to the local
+   * filesystem are compressed: `none`, `zstd` or `lz4`. Each testcase is
+   * compressed on its own so that it can still be read without reading the rest
+   * of the file. Available codecs depend on the libraries found when the SDK
+   * was built. Compressed files cannot be read by earlier versions of the Touca
+   * SDKs and CLI. Defaults to `none`.
+   */
+  std::string compression = "none";
 };
 
 #ifdef TOUCA_INCLUDE_RUNNER
@@ -155,6 +182,28 @@ struct RunnerOptions : public ClientOptions {
    */
   bool save_json = false;
 
+  /**
+   * Store the binary test results of all test cases of a workflow, along
+   * with their captured output, into a single indexed `touca.bin` file in
+   * the results directory of the version under test, instead of creating a
+   * separate directory for each test case. Results of test cases that run
+   * again replace their earlier copy in the file, which is rewritten
+   * without the replaced results once they take up more than a quarter of
+   * it. Has no effect unless `save_binary` is set.
+   */
+  bool archive_results = false;
+
+  /**
+   * When to flush result files written to the local filesystem to stable
+   * storage: `never`, `file` for each file as soon as it is written,
+   * `batch` for files written since the last flush whenever the runner
+   * waits on the disk, or `run` for all files at the end of each workflow.
+   * Result files are always written to a temporary file first and renamed
+   * into place, so that a crash never leaves a partially written file
+   * behind. Defaults to `never`.
+   */
+  std::string sync_policy = "never";
+
   /**
    * Overwrite the locally generated test results for a given testcase if the
    * results directory already exists.
@@ -226,6 +275,8 @@ struct RunnerOptions : public ClientOptions {
 
 #endif
 
+struct SerializationOptions;
+
 struct Post {
   enum class Status : unsigned char { Sent, Fail, Skip, Pass, Diff };
   struct Options {
@@ -251,6 +302,19 @@ void set_client_options(const ClientOptions& options);
 
 /** see ClientImpl::get_client_transport */
 const std::unique_ptr<Transport>& get_client_transport();
+
+/** see ClientImpl::serialization_options */
+SerializationOptions get_serialization_options();
+
+/** see ClientImpl::serialize */
+std::vector<std::uint8_t> serialize_binary(const std::string& testcase);
+
+/** see ClientImpl::serialize */
+std::vector<std::uint8_t> serialize_json(const std::string& testcase);
+
+/** see ClientImpl::serialize_message */
+std::vector<std::uint8_t> serialize_message(
+    const std::string& testcase, const SerializationOptions& options);
 #endif
 
 }  // namespace detail
@@ -0,0 +1,72 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "touca/lib_api.hpp"
+
+namespace touca {
+namespace detail {
+
+/**
+ * Instruction sets with which numeric arrays may be compared. Kernels that
+ * the processor does not support are never used, even if requested.
+ */
+enum class ArrayKernel : unsigned char {
+  Scalar, /**< portable element by element comparison */
+  SSE2,   /**< compares 128 bits of each array at a time */
+  AVX2    /**< compares 256 bits of each array at a time */
+};
+
+/**
+ * @return fastest kernel that the processor supports
+ */
+TOUCA_CLIENT_API ArrayKernel best_array_kernel();
+
+/**
+ * Outcome of comparing two numeric arrays of the same size element by
+ * element, with each pair of elements scored the same way as two numbers
+ * that are compared on their own.
+ */
+struct TOUCA_CLIENT_API NumericArrayComparison {
+  /** number of elements that are identical in both arrays */
+  std::size_t matches = 0;
+  /** sum of the scores of elements that are different, in index order */
+  double score = 0.0;
+  /** indices of the first few elements that are different, in order */
+  std::vector<std::size_t> mismatches;
+};
+
+/**
+ * Compares two numeric arrays of a given size element by element in a
+ * single pass.
+ *
+ * @param max_mismatches maximum number of indices of different elements
+ *                       to collect
+ * @param kernel instruction set to use, if the processor supports it
+ */
+TOUCA_CLIENT_API NumericArrayComparison compare_numeric_arrays(
+    const std::int64_t* src, const std::int64_t* dst, const std::size_t size,
+    const std::size_t max_mismatches,
+    const ArrayKernel kernel = best_array_kernel());
+
+TOUCA_CLIENT_API NumericArrayComparison compare_numeric_arrays(
+    const std::uint64_t* src, const std::uint64_t* dst,
+    const std::size_t size, const std::size_t max_mismatches,
+    const ArrayKernel kernel = best_array_kernel());
+
+TOUCA_CLIENT_API NumericArrayComparison compare_numeric_arrays(
+    const float* src, const float* dst, const std::size_t size,
+    const std::size_t max_mismatches,
+    const ArrayKernel kernel = best_array_kernel());
+
+TOUCA_CLIENT_API NumericArrayComparison compare_numeric_arrays(
+    const double* src, const double* dst, const std::size_t size,
+    const std::size_t max_mismatches,
+    const ArrayKernel kernel = best_array_kernel());
+
+}  // namespace detail
+}  // namespace touca
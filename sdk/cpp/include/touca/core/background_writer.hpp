@@ -0,0 +1,110 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "touca/core/filesystem.hpp"
+#include "touca/lib_api.hpp"
+
+namespace touca {
+namespace detail {
+
+/**
+ * Persists content on a dedicated thread so that the caller can carry on
+ * while its previous results are written to disk.
+ *
+ * Tasks run one at a time, in the order they were submitted. The number of
+ * bytes held by queued tasks is bounded: submitting a task blocks while the
+ * queue is full, so that a slow disk holds back the caller instead of
+ * letting queued content grow without limit. Content is only guaranteed to
+ * be written once `flush` returns, and to be on stable storage only if the
+ * writer was given a sync policy other than `SyncPolicy::Never`.
+ */
+class TOUCA_CLIENT_API BackgroundWriter {
+ public:
+  /**
+   * @param capacity maximum number of bytes held by queued tasks. A task
+   *                 larger than this limit is accepted once the queue is
+   *                 empty.
+   * @param policy when to flush written files to stable storage. With
+   *               `SyncPolicy::PerBatch`, files are flushed together
+   *               whenever the writer catches up with its queue.
+   */
+  explicit BackgroundWriter(const std::size_t capacity = 64u << 20,
+                            const SyncPolicy policy = SyncPolicy::Never);
+
+  /**
+   * Waits for queued tasks to complete. Errors that were not reported by
+   * `flush` are discarded.
+   */
+  ~BackgroundWriter();
+
+  BackgroundWriter(const BackgroundWriter&) = delete;
+  BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+  /**
+   * Queues writing given content to a file with given path, atomically
+   * replacing the file if it already exists.
+   *
+   * @param path path to the file to write
+   * @param content content of the file
+   */
+  void write(const std::string& path, std::vector<std::uint8_t> content);
+
+  /**
+   * Queues a task to run on the background thread after all tasks that
+   * were submitted before it.
+   *
+   * @param task function to run on the background thread
+   * @param size number of bytes held by the task, counted towards the
+   *             capacity of the queue
+   * @param path path to a file that the task writes, if any, to be flushed
+   *             to stable storage according to the sync policy
+   */
+  void post(std::function<void()> task, const std::size_t size = 0,
+            const std::string& path = std::string());
+
+  /**
+   * Waits until all tasks submitted so far have completed and, unless the
+   * sync policy is `SyncPolicy::Never`, their files are on stable storage.
+   *
+   * @throw touca::detail::runtime_error if any of those tasks failed, with
+   *        the error of the first task that failed
+   */
+  void flush();
+
+ private:
+  struct Task {
+    std::function<void()> run;
+    std::size_t size;
+    std::string path;
+  };
+
+  void run();
+  void sync_files();
+
+  std::size_t _capacity;
+  SyncPolicy _policy;
+  std::set<std::string> _unsynced;
+  std::size_t _queued_size = 0;
+  std::deque<Task> _tasks;
+  bool _busy = false;
+  bool _stopped = false;
+  std::string _error;
+  std::mutex _mutex;
+  std::condition_variable _task_added;
+  std::condition_variable _task_done;
+  std::thread _thread;
+};
+
+}  // namespace detail
+}  // namespace touca
@@ -2,17 +2,33 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "rapidjson/fwd.h"
+#include "touca/core/deserialize.hpp"
+#include "touca/core/filesystem.hpp"
 #include "touca/core/testcase.hpp"
 #include "touca/core/types.hpp"
 
 namespace touca {
+namespace fbs {
+struct Dictionary;
+struct Message;
+}  // namespace fbs
+
+namespace detail {
+class ComparisonCache;
+class ThreadPool;
+}  // namespace detail
 
 /**
  * @enum touca::MatchType
@@ -23,35 +39,259 @@ enum class MatchType : unsigned char {
   None     /**< Indicates that compared objects were different */
 };
 
+/**
+ * @enum touca::ArrayAlignment
+ * @brief describes how elements of two arrays of objects are matched
+ */
+enum class ArrayAlignment : unsigned char {
+  /** Elements are matched by their position */
+  Index,
+  /**
+   * Elements are matched by their identity, regardless of their position:
+   * objects that have the identity member are identified by its value and
+   * other objects by their content. Elements without a counterpart are
+   * reported as new or missing.
+   */
+  Identity
+};
+
+/**
+ * @enum touca::ComparisonFormat
+ * @brief describes the format in which comparison results are written
+ */
+enum class ComparisonFormat : unsigned char {
+  Json,  /**< json document */
+  Binary /**< flatbuffers data of type `fbs::FileComparison` */
+};
+
+/**
+ * @param name name of a comparison format: `json` or `binary`
+ * @throw touca::detail::runtime_error if the format is unknown
+ */
+TOUCA_CLIENT_API ComparisonFormat
+parse_comparison_format(const std::string& name);
+
+/**
+ * Options that determine how result files are compared.
+ */
+struct TOUCA_CLIENT_API ComparisonOptions {
+  /** how thoroughly to verify the content of both files */
+  VerifyMode verify = VerifyMode::Full;
+  /**
+   * maximum number of bytes with which each compared value is kept and
+   * reported, or zero to keep values in full
+   */
+  std::size_t preview_size = 0;
+  /**
+   * whether to compute match and score of compared values without
+   * describing their differences. Descriptions are generated on demand for
+   * values that are still available. Values of result files in binary
+   * format are not kept.
+   */
+  bool summary_only = false;
+  /**
+   * number of threads with which to compare common testcases, or zero to
+   * use one thread per hardware thread
+   */
+  std::size_t jobs = 1;
+  /**
+   * directory in which to keep comparison results of testcases of result
+   * files in binary format, so that pairs of testcases that were compared
+   * before, even in a previous run, are not compared again. Comparison
+   * results are not kept if empty.
+   */
+  std::string cache_directory;
+  /**
+   * maximum number of bytes that kept comparison results may take on disk,
+   * or zero for no limit
+   */
+  std::uintmax_t cache_size = std::uintmax_t(256) << 20;
+  /** how elements of arrays whose elements are all objects are matched */
+  ArrayAlignment array_alignment = ArrayAlignment::Index;
+  /**
+   * name of the member whose value identifies objects when arrays are
+   * aligned by identity, or empty to identify objects by their content
+   */
+  std::string identity_member;
+  /**
+   * maximum number of ranges of different lines to describe when strings
+   * of more than one line are compared line by line
+   */
+  std::size_t max_hunks = 5;
+  /**
+   * maximum number of lines to insert or remove when comparing strings of
+   * more than one line, which bounds the time and memory that comparing
+   * them takes. Strings that differ by more lines are scored only by the
+   * lines at their start and end that are identical.
+   */
+  std::size_t max_line_edits = 1000;
+  /** format in which `write_comparison` writes comparison results */
+  ComparisonFormat format = ComparisonFormat::Json;
+};
+
+namespace detail {
+
+/**
+ * Version of the way comparison results are kept in the comparison cache.
+ * Since cached results are reused as they are, this version should change
+ * whenever values are compared or rendered differently.
+ */
+constexpr std::uint32_t comparison_cache_version = 3;
+
+/**
+ * Identifies comparison results of two sets of assertions and results in
+ * the comparison cache by their digests, by the options that affect the
+ * comparison results and by the version of the comparison cache, so that
+ * results kept by other versions are never used.
+ *
+ * @return name of the entry of the comparison cache, made of hex digits
+ */
+TOUCA_CLIENT_API std::string comparison_cache_key(
+    const std::uint64_t srcDigest, const std::uint64_t dstDigest,
+    const ComparisonOptions& options,
+    const std::uint32_t version = comparison_cache_version);
+
+}  // namespace detail
+
+/**
+ * Value that took part in a comparison. Values are kept as they are and only
+ * rendered as strings when comparison results are reported, optionally cut
+ * short so that huge values do not dominate the report.
+ */
+class TOUCA_CLIENT_API ComparedValue {
+ public:
+  ComparedValue() = default;
+
+  /**
+   * Refers to a given value without copying it. The value must outlive this
+   * object and remain unchanged, unless `freeze` is called before then.
+   */
+  explicit ComparedValue(const data_point& value);
+
+  /**
+   * Holds a value that was already rendered.
+   *
+   * @param type type of the value
+   * @param preview rendered value or, if the value was cut short, the part
+   *                of the value that was rendered
+   * @param truncated whether the value was cut short
+   */
+  ComparedValue(const touca::detail::internal_type type, std::string preview,
+                const bool truncated = false);
+
+  /**
+   * @return whether this object holds no value
+   */
+  bool empty() const noexcept;
+
+  /**
+   * @return type of the value that this object holds
+   */
+  touca::detail::internal_type type() const noexcept { return _type; }
+
+  /**
+   * @return value that this object refers to, or `nullptr` if the value was
+   *         already rendered
+   */
+  const data_point* value() const noexcept { return _value; }
+
+  /**
+   * @return value that was already rendered, without the trailing ellipsis
+   *         of values that were cut short
+   */
+  const std::string& preview() const noexcept { return _preview; }
+
+  /**
+   * @return whether the value that was already rendered was cut short
+   */
+  bool truncated() const noexcept { return _truncated; }
+
+  /**
+   * Renders the value that this object holds. Values longer than a given
+   * size are cut short and marked with a trailing ellipsis.
+   *
+   * @param out string to hold the rendered value
+   * @param max_size maximum number of bytes of the value to render, or zero
+   *                 to render the value in full
+   */
+  void render(std::string& out, const std::size_t max_size = 0) const;
+
+  /** @see render */
+  std::string str(const std::size_t max_size = 0) const;
+
+  /**
+   * @return whether the value that this object holds renders in full as a
+   *         given string
+   */
+  bool operator==(const std::string& other) const;
+
+  /**
+   * Renders the value right away, so that this object no longer refers to
+   * it and it can be discarded.
+   *
+   * @param max_size maximum number of bytes of the value to keep, or zero
+   *                 to keep the value in full
+   */
+  void freeze(const std::size_t max_size = 0);
+
+ private:
+  const data_point* _value = nullptr;
+  std::string _preview;
+  bool _truncated = false;
+  touca::detail::internal_type _type = touca::detail::internal_type::unknown;
+};
+
+/**
+ * Outcome of comparing two values. Outcomes that belong to a
+ * `TestcaseComparison` refer to the compared values, which the comparison
+ * keeps alive. Outcomes returned by `compare` hold rendered copies of the
+ * compared values instead.
+ */
 struct TOUCA_CLIENT_API TypeComparison {
-  std::string srcValue;
-  std::string dstValue;
+  ComparedValue srcValue;
+  ComparedValue dstValue;
   touca::detail::internal_type srcType = touca::detail::internal_type::unknown;
   touca::detail::internal_type dstType = touca::detail::internal_type::unknown;
   double score = 0.0;
   std::set<std::string> desc;
   MatchType match = MatchType::None;
+  /** whether differences were described when the values were compared */
+  bool described = true;
+
+  /**
+   * @return descriptions of the differences between the compared values,
+   *         generated on demand if they were not described when compared
+   *         and both values are still available
+   */
+  std::set<std::string> describe() const;
 };
 
 struct TOUCA_CLIENT_API Cellar {
   using ComparisonMap = std::unordered_map<std::string, TypeComparison>;
-  using KeyMap = std::map<std::string, data_point>;
+  using KeyMap = std::map<std::string, ComparedValue>;
   enum class Category { Common, Missing, Fresh };
 
   ComparisonMap common;
   KeyMap missing;
   KeyMap fresh;
 
-  rapidjson::Value json(RJAllocator& allocator) const;
+  /**
+   * @param max_size maximum number of bytes with which each value is
+   *                 reported, or zero to report values in full
+   */
+  rapidjson::Value json(RJAllocator& allocator,
+                        const std::size_t max_size = 0) const;
 
  private:
   std::string stringify(const touca::detail::internal_type type) const;
 
   rapidjson::Value build_json_solo(const KeyMap& elements,
                                    const Category category,
+                                   const std::size_t max_size,
                                    RJAllocator& allocator) const;
 
   rapidjson::Value build_json_common(const ComparisonMap& elements,
+                                     const std::size_t max_size,
                                      RJAllocator& allocator) const;
 };
 
@@ -71,23 +311,81 @@ class TOUCA_CLIENT_API TestcaseComparison {
     rapidjson::Value json(RJAllocator& allocator) const;
   };
 
-  explicit TestcaseComparison(const Testcase& src, const Testcase& dst);
+  /**
+   * Compares two testcases that need not outlive the comparison. Values are
+   * described and rendered right away, even in summary mode, up to the
+   * preview size of the given options.
+   */
+  explicit TestcaseComparison(
+      const Testcase& src, const Testcase& dst,
+      const ComparisonOptions& options = ComparisonOptions());
 
-  rapidjson::Value json(RJAllocator& allocator) const;
+  /**
+   * Compares two testcases whose ownership is shared with the comparison.
+   * Values are only rendered once the comparison is reported, so they must
+   * remain unchanged.
+   */
+  explicit TestcaseComparison(
+      const std::shared_ptr<const Testcase>& src,
+      const std::shared_ptr<const Testcase>& dst,
+      const ComparisonOptions& options = ComparisonOptions());
+
+  /**
+   * Compares two testcases directly on their flatbuffers representation.
+   * Values are decoded only if they are found to be different.
+   * Testcases written with a string table should be accompanied by the
+   * string table of their result file. Since the flatbuffers data need not
+   * outlive the comparison, values are rendered right away, up to the
+   * preview size of the given options.
+   *
+   * If a cache is given, comparison results of assertions and results are
+   * taken from the cache if the same assertions and results were compared
+   * before with the same options, and kept in the cache otherwise. Metadata
+   * and metrics, which change from one run to the next, are always
+   * compared.
+   */
+  explicit TestcaseComparison(
+      const fbs::Message& src, const fbs::Message& dst,
+      const fbs::Dictionary* srcDictionary = nullptr,
+      const fbs::Dictionary* dstDictionary = nullptr,
+      const ComparisonOptions& options = ComparisonOptions(),
+      detail::ComparisonCache* cache = nullptr);
+
+  /**
+   * @param max_size maximum number of bytes with which each value is
+   *                 reported, or zero to report values in full
+   */
+  rapidjson::Value json(RJAllocator& allocator,
+                        const std::size_t max_size = 0) const;
 
   Overview overview() const;
 
  private:
+  /**
+   * @param detached whether to describe and render values right away, so
+   *                 that the comparison no longer refers to the testcases
+   */
+  TestcaseComparison(const Testcase& src, const Testcase& dst,
+                     const ComparisonOptions& options, const bool detached);
+
   double score_results() const;
 
+  /**
+   * @param pool pool on which to compare values in parallel, if any
+   */
   void init_cellar(const ResultsMap& src, const ResultsMap& dst,
-                   const ResultCategory& type, Cellar& result);
+                   const ResultCategory& type,
+                   const ComparisonOptions& options, const bool detached,
+                   detail::ThreadPool* pool, Cellar& result);
 
   void init_cellar(const MetricsMap& src, const MetricsMap& dst,
                    Cellar& result);
 
   void init_metadata(const Testcase& tc, Testcase::Metadata& meta);
 
+  // builds the binary representation of comparison results
+  friend class comparison_builder;
+
   // metadata
   Testcase::Metadata _srcMeta;
   Testcase::Metadata _dstMeta;
@@ -95,9 +393,12 @@ class TOUCA_CLIENT_API TestcaseComparison {
   Cellar _assumptions;
   Cellar _results;
   Cellar _metrics;
-  // pointers to testcases we are comparing
-  const Testcase& _src;
-  const Testcase& _dst;
+  // total duration of common metrics
+  std::int32_t _srcDuration = 0;
+  std::int32_t _dstDuration = 0;
+  // testcases whose values are referred to by the comparison results
+  std::shared_ptr<const Testcase> _src;
+  std::shared_ptr<const Testcase> _dst;
 };
 
 /**
@@ -111,24 +412,126 @@ struct TOUCA_CLIENT_API ElementsMapComparison {
   ElementsMap fresh;
   ElementsMap missing;
   std::map<std::string, TestcaseComparison> common;
+  /**
+   * maximum number of bytes with which each value is reported, or zero to
+   * report values in full
+   */
+  std::size_t previewSize = 0;
+  /** whether to report no more than an overview of common testcases */
+  bool summaryOnly = false;
 
   /**
    * @brief provides description of this object in json format.
    *
+   * @details Common testcases are described by their overview alone if
+   *          `summaryOnly` is set.
+   *
    * @return string representation of the comparison result
    *         between two result files in json format
    */
   std::string json() const;
+
+  /**
+   * @brief provides description of this object in binary format.
+   *
+   * @details Describes the same comparison results as `json`, as
+   *          flatbuffers data of type `fbs::FileComparison`, so that they
+   *          can be read in place without being parsed. Common testcases
+   *          and their keys are sorted by name, so that they can be looked
+   *          up with `LookupByKey`, and are described along with their
+   *          overview.
+   *
+   * @return comparison result between two result files in binary format
+   */
+  std::vector<std::uint8_t> binary() const;
 };
 
+/**
+ * Compares two values. The outcome holds rendered copies of the values, so
+ * the values can be discarded right after.
+ */
 TOUCA_CLIENT_API TypeComparison compare(const data_point& src,
                                         const data_point& dst);
 
+/**
+ * Same as above but with given options. Differences are described even in
+ * summary mode, since they could not be described on demand once the
+ * values are discarded, and values are kept up to the preview size of the
+ * given options.
+ */
+TOUCA_CLIENT_API TypeComparison compare(const data_point& src,
+                                        const data_point& dst,
+                                        const ComparisonOptions& options);
+
 TOUCA_CLIENT_API TestcaseComparison compare(const Testcase& src,
                                             const Testcase& dst);
 
-TOUCA_CLIENT_API ElementsMapComparison compare(const ElementsMap& src,
-                                               const ElementsMap& dst);
+/**
+ * Compares two sets of testcases. The outcome shares ownership of the
+ * testcases but refers to their values, which must remain unchanged.
+ */
+TOUCA_CLIENT_API ElementsMapComparison
+compare(const ElementsMap& src, const ElementsMap& dst,
+        const ComparisonOptions& options = ComparisonOptions());
+
+/**
+ * @brief compares two result files without deserializing their content.
+ *
+ * @details Walks the flatbuffers representation of the testcases in both
+ *          files side by side and only decodes values that are different.
+ *          Produces the same output as comparing the outcome of calling
+ *          `deserialize_file` on both files, at a fraction of the cost.
+ *          Result files in json format are deserialized instead, and
+ *          their numbers take the types of the numbers they are compared
+ *          with in a binary result file.
+ *
+ * @param src path to the result file to compare
+ * @param dst path to the result file to compare against
+ * @param mode how thoroughly to verify the content of both files
+ */
+TOUCA_CLIENT_API ElementsMapComparison
+compare_files(const touca::filesystem::path& src,
+              const touca::filesystem::path& dst,
+              const VerifyMode mode = VerifyMode::Full);
+
+/**
+ * @brief same as the other `compare_files` but with given options.
+ *
+ * @details Values of result files in binary format are kept no longer than
+ *          the preview size of the options, so that memory required for
+ *          the comparison does not grow with the size of those values.
+ */
+TOUCA_CLIENT_API ElementsMapComparison
+compare_files(const touca::filesystem::path& src,
+              const touca::filesystem::path& dst,
+              const ComparisonOptions& options);
+
+/**
+ * @brief compares two result files and writes the comparison result to a
+ *        given file in the format of the given options as it is produced.
+ *
+ * @details Produces the same output as the json or binary representation
+ *          of the outcome of `compare_files`, except that fresh and missing
+ *          testcases are listed in the order of their names. Testcases are
+ *          decoded and compared a few at a time in the order of their names
+ *          and their comparison results are discarded as soon as they are
+ *          written, so that memory use does not grow with the number of
+ *          testcases. Only the metadata of fresh and missing testcases is
+ *          decoded. Result files with a footer index are read one testcase
+ *          at a time, others are loaded in their entirety before they are
+ *          compared. Comparison results in binary format are written once
+ *          all testcases are compared, and take as much memory as their
+ *          size on disk until then.
+ *
+ * @param file file open for writing
+ * @param src path to the result file to compare
+ * @param dst path to the result file to compare against
+ * @param options how to compare the result files
+ */
+TOUCA_CLIENT_API void write_comparison(
+    std::FILE* file, const touca::filesystem::path& src,
+    const touca::filesystem::path& dst,
+    const ComparisonOptions& options = ComparisonOptions());
 
 TOUCA_CLIENT_API std::map<std::string, data_point> flatten(
     const data_point& input);
@@ -0,0 +1,80 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "touca/core/filesystem.hpp"
+#include "touca/lib_api.hpp"
+
+namespace touca {
+namespace detail {
+
+/**
+ * Comparison results kept on disk, so that comparing the same pair of
+ * testcases again, even in a later run, can skip the comparison.
+ *
+ * Each entry is stored in a file of its own, named after its key, along
+ * with a digest of its content so that entries that were cut short or
+ * changed are never used. Entries are written to a temporary file and
+ * renamed into place, so that any number of processes may share the same
+ * directory. Once entries take more space than allowed, the entries that
+ * were least recently used are removed.
+ */
+class TOUCA_CLIENT_API ComparisonCache {
+ public:
+  /**
+   * @param directory directory that holds the entries, created if it does
+   *                  not already exist
+   * @param max_size maximum number of bytes that entries may take on disk,
+   *                 or zero for no limit
+   * @throw touca::detail::runtime_error if the directory cannot be created
+   */
+  ComparisonCache(const touca::filesystem::path& directory,
+                  const std::uintmax_t max_size);
+
+  /**
+   * Finds the entry with a given key and marks it as recently used.
+   *
+   * @param key name of the entry, made of letters and digits
+   * @param content buffer to hold content of the entry
+   * @return whether an intact entry with the given key was found
+   */
+  bool load(const std::string& key, std::vector<std::uint8_t>& content);
+
+  /**
+   * Stores an entry with a given key, unless one already exists. Entries
+   * that cannot be written are skipped, since the cache only ever saves
+   * work.
+   */
+  void store(const std::string& key, const std::vector<std::uint8_t>& content);
+
+  /**
+   * @return number of bytes that entries take on disk, as far as this
+   *         object knows
+   */
+  std::uintmax_t size() const;
+
+  /** @return number of entries found by `load` so far */
+  std::size_t hits() const;
+
+  /** @return number of entries not found by `load` so far */
+  std::size_t misses() const;
+
+ private:
+  touca::filesystem::path entry_path(const std::string& key) const;
+  void evict();
+
+  touca::filesystem::path _directory;
+  std::uintmax_t _max_size;
+  std::uintmax_t _size = 0;
+  std::size_t _hits = 0;
+  std::size_t _misses = 0;
+  mutable std::mutex _mutex;
+};
+
+}  // namespace detail
+}  // namespace touca
@@ -0,0 +1,62 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "touca/lib_api.hpp"
+
+namespace touca {
+
+/**
+ * Codecs with which testcases may be compressed in binary result files.
+ * Values match those of `fbs::Compression`.
+ */
+enum class Compression : std::uint8_t { None = 0, Zstd = 1, Lz4 = 2 };
+
+/**
+ * @return whether this build of the SDK can compress and decompress data
+ *         with a given codec. Support for each codec depends on whether its
+ *         library was available when the SDK was built.
+ */
+TOUCA_CLIENT_API bool is_supported(const Compression codec);
+
+/**
+ * @param name name of a codec: `none`, `zstd` or `lz4`. An empty name is
+ *             treated as `none`.
+ * @throw touca::detail::runtime_error if the codec is unknown
+ */
+TOUCA_CLIENT_API Compression parse_compression(const std::string& name);
+
+namespace detail {
+
+/**
+ * Compresses a given block of memory into a single self-contained frame.
+ *
+ * @param level codec-specific compression level, where zero selects the
+ *              default level of the codec
+ * @throw touca::detail::runtime_error if the codec is not supported
+ */
+TOUCA_CLIENT_API std::vector<std::uint8_t> compress(const Compression codec,
+                                                    const int level,
+                                                    const std::uint8_t* data,
+                                                    const std::size_t size);
+
+/**
+ * Decompresses a frame produced by `compress`. The given size of the data
+ * before it was compressed is checked against the frame before memory is
+ * allocated for it.
+ *
+ * @param raw_size size of the data before it was compressed
+ * @throw touca::detail::runtime_error if the codec is not supported, the
+ *        frame is corrupted or it does not decompress to `raw_size` bytes
+ */
+TOUCA_CLIENT_API std::vector<std::uint8_t> decompress(
+    const Compression codec, const std::uint8_t* data, const std::size_t size,
+    const std::size_t raw_size);
+
+}  // namespace detail
+}  // namespace touca
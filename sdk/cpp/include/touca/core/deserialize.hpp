@@ -3,23 +3,184 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <string>
 #include <vector>
 
 #include "touca/core/filesystem.hpp"
+#include "touca/core/result_file.hpp"
 #include "touca/core/testcase.hpp"
 
+namespace flatbuffers {
+struct String;
+}  // namespace flatbuffers
+
 namespace touca {
 class data_point;
 namespace fbs {
+struct Dictionary;
+struct Message;
+struct MessageBuffer;
+struct Messages;
+struct Metadata;
 struct TypeWrapper;
 }  // namespace fbs
 
-data_point TOUCA_CLIENT_API deserialize_value(const fbs::TypeWrapper* ptr);
+/**
+ * @param name name of a verification mode: `full`, `checksum` or `lazy`
+ * @throw touca::detail::runtime_error if the mode is unknown
+ */
+TOUCA_CLIENT_API VerifyMode parse_verify_mode(const std::string& name);
+
+/**
+ * Finds the string that a given field refers to. Result files written with
+ * a string table store the position of each key in that table instead of the
+ * key itself.
+ *
+ * @param value string stored inline, if any
+ * @param id position of the string in the dictionary
+ * @param dictionary string table of the result file, if any
+ * @throw touca::detail::runtime_error if the id is out of range
+ * @return inline string if present, the dictionary entry otherwise, or
+ *         `nullptr` if neither is available
+ */
+const flatbuffers::String* TOUCA_CLIENT_API
+lookup_string(const flatbuffers::String* value, std::uint32_t id,
+              const fbs::Dictionary* dictionary);
+
+/**
+ * @return string table of a given set of messages or `nullptr` if its
+ *         testcases store their keys inline
+ */
+const fbs::Dictionary* TOUCA_CLIENT_API
+find_dictionary(const fbs::Messages* messages);
+
+/**
+ * @param content entire content of a result file
+ * @return string table of the result file or `nullptr` if its testcases
+ *         store their keys inline
+ */
+const fbs::Dictionary* TOUCA_CLIENT_API
+find_dictionary(const std::string& content);
+
+/**
+ * Provides the serialized testcase held by a given entry of a result file,
+ * decompressing it first if it is compressed.
+ *
+ * @param buffer entry of a result file
+ * @param storage buffer to hold the decompressed testcase, if necessary
+ * @param verify whether to verify the structure of the testcase
+ * @throw touca::detail::runtime_error if the testcase cannot be decompressed
+ *        or fails verification
+ * @return pointer into either the given entry or `storage`
+ */
+const fbs::Message* TOUCA_CLIENT_API read_message(
+    const fbs::MessageBuffer* buffer, std::vector<std::uint8_t>& storage,
+    const bool verify = false);
+
+/**
+ * Provides the serialized testcase at a given position of a result file
+ * written by `ResultFileWriter`, decompressing it first if it is compressed.
+ *
+ * @param content entire content of the result file
+ * @param entry position of the testcase as found by `read_records`
+ */
+const fbs::Message* TOUCA_CLIENT_API read_message(
+    const std::string& content, const ResultFileEntry& entry,
+    std::vector<std::uint8_t>& storage, const bool verify = false);
+
+/**
+ * Calls a given function with each testcase in the content of a result
+ * file, regardless of whether the file was written by `Testcase::serialize`
+ * or `ResultFileWriter`. Testcases of the former are visited in the order
+ * they were written and those of the latter in reverse order, so that the
+ * latest copy of a testcase that was appended more than once comes first.
+ *
+ * @param content entire content of the result file
+ * @param verify whether to verify the structure of each testcase
+ * @param func function called with each testcase and the buffer holding it
+ *             if it had to be decompressed. The function may take ownership
+ *             of the content of that buffer.
+ */
+TOUCA_CLIENT_API void for_each_message(
+    const std::string& content, const bool verify,
+    const std::function<void(const fbs::Message*, std::vector<std::uint8_t>&)>&
+        func);
+
+data_point TOUCA_CLIENT_API deserialize_value(
+    const fbs::TypeWrapper* ptr, const fbs::Dictionary* dictionary = nullptr);
+
+Testcase::Metadata TOUCA_CLIENT_API deserialize_metadata(
+    const fbs::Metadata* ptr, const fbs::Dictionary* dictionary = nullptr);
+
+Testcase TOUCA_CLIENT_API deserialize_testcase(
+    const fbs::Message& message, const fbs::Dictionary* dictionary = nullptr);
 
 Testcase TOUCA_CLIENT_API
-deserialize_testcase(const std::vector<std::uint8_t>& buffer);
+deserialize_testcase(const std::vector<std::uint8_t>& buffer,
+                     const fbs::Dictionary* dictionary = nullptr);
+
+/**
+ * @return whether given content of a result file is in json format, as
+ *         opposed to one of the binary formats
+ */
+TOUCA_CLIENT_API bool is_json_result(const std::string& content);
+
+/**
+ * Loads testcases from the content of a result file in json format, as written
+ * by `ClientImpl::save` or `touca_cli view`. Files without a `formatVersion`
+ * field store each value as a string; such strings are parsed back into the
+ * values they represent. Since json does not distinguish numeric types,
+ * integers are loaded as signed numbers, unless they are too large to fit one,
+ * and other numbers as double-precision numbers.
+ *
+ * @param content entire content of the result file, parsed in place
+ * @throw touca::detail::runtime_error if the content is not valid json or
+ *        does not follow the format of result files
+ */
+TOUCA_CLIENT_API ElementsMap deserialize_json(std::string content);
+
+/**
+ * Loads content of a result file and verifies that it represents valid
+ * flatbuffers data of type `fbs::Messages`. Content of result files in json
+ * format is returned as is.
+ *
+ * @param path path to the result file
+ * @param mode how thoroughly to verify the content of the file
+ * @throw touca::detail::runtime_error if the file is missing or invalid
+ * @return content of the result file
+ */
+std::string TOUCA_CLIENT_API
+load_result_file(const touca::filesystem::path& path,
+                 const VerifyMode mode = VerifyMode::Full);
+
+/**
+ * Same as above, except that testcases are left to be verified when they
+ * are read, so that compressed testcases are decompressed only once.
+ *
+ * @param verify_testcases set to whether testcases of the returned content
+ *                         should be verified when they are read, which is
+ *                         the case unless the file is in json format or
+ *                         matched its checksum
+ */
+std::string TOUCA_CLIENT_API load_result_file(
+    const touca::filesystem::path& path, const VerifyMode mode,
+    bool& verify_testcases);
+
+/**
+ * Loads testcases from content of a result file in any of the formats
+ * accepted by `load_result_file`.
+ *
+ * @param content content of the result file as returned by the
+ *                `load_result_file` that leaves testcases to be verified
+ *                when they are read
+ * @param verify_testcases whether to verify testcases as they are read
+ */
+ElementsMap TOUCA_CLIENT_API deserialize_content(std::string content,
+                                                 const bool verify_testcases);
 
 ElementsMap TOUCA_CLIENT_API
-deserialize_file(const touca::filesystem::path& path);
+deserialize_file(const touca::filesystem::path& path,
+                 const VerifyMode mode = VerifyMode::Full);
 
 }  // namespace touca
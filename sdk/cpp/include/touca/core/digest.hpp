@@ -0,0 +1,41 @@
+// Copyright 2022 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "touca/lib_api.hpp"
+
+namespace touca {
+namespace detail {
+
+/**
+ * Incremental implementation of the 64-bit variant of the xxHash
+ * non-cryptographic hash function. Output is identical to the reference
+ * `XXH64` implementation for the same input and seed.
+ */
+class TOUCA_CLIENT_API xxh64 {
+ public:
+  explicit xxh64(const std::uint64_t seed = 0);
+
+  void update(const void* data, const std::size_t size);
+
+  std::uint64_t digest() const;
+
+ private:
+  std::uint64_t _seed;
+  std::uint64_t _total = 0;
+  std::uint64_t _acc[4];
+  std::uint8_t _buffer[32];
+  std::size_t _buffered = 0;
+};
+
+/**
+ * Computes xxh64 digest of a given block of memory.
+ */
+TOUCA_CLIENT_API std::uint64_t digest(const void* data,
+                                      const std::size_t size);
+
+}  // namespace detail
+}  // namespace touca
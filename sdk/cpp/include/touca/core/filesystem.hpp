@@ -29,6 +29,9 @@ namespace filesystem = ghc::filesystem;
 }
 #endif
 
+#include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <ios>
 #include <memory>
 #include <string>
@@ -75,11 +78,77 @@ struct runtime_error : public std::runtime_error {
 TOUCA_CLIENT_API std::string load_text_file(
     const std::string& path, const std::ios_base::openmode mode = std::ios::in);
 
+/**
+ * Creates the directory that should contain a file with given path, if it
+ * does not already exist.
+ *
+ * @throw touca::detail::runtime_error if the directory cannot be created
+ */
+TOUCA_CLIENT_API void create_parent_directory(const std::string& path);
+
+/**
+ * Determines when content written to disk is flushed to stable storage.
+ */
+enum class SyncPolicy : std::uint8_t {
+  /** leave it to the operating system */
+  Never,
+  /** as soon as each file is written */
+  PerFile,
+  /** once for all files written since the last batch */
+  PerBatch,
+  /** once for all files written, at the end of the run */
+  EndOfRun
+};
+
+/**
+ * @param name name of a sync policy: `never`, `file`, `batch` or `run`
+ * @throw touca::detail::runtime_error if the policy is unknown
+ */
+TOUCA_CLIENT_API SyncPolicy parse_sync_policy(const std::string& name);
+
+/**
+ * Flushes content of a file that was already written, along with the entry
+ * of the file in its directory, to stable storage.
+ *
+ * @throw touca::detail::runtime_error if the file could not be flushed
+ */
+TOUCA_CLIENT_API void sync_file(const std::string& path);
+
+/**
+ * Writes content to a temporary file next to a given path and renames it to
+ * that path, so that readers find either the previous file or the complete
+ * new one, never a partially written file. The temporary file has a unique
+ * name and is removed if the content could not be written.
+ *
+ * @param sync whether to flush the file to stable storage before renaming
+ *             it, and its directory after
+ * @throw touca::detail::runtime_error if the file could not be written
+ */
 TOUCA_CLIENT_API void save_text_file(const std::string& path,
-                                     const std::string& content);
+                                     const std::string& content,
+                                     const bool sync = false);
 
+/** @see save_text_file */
 TOUCA_CLIENT_API void save_binary_file(const std::string& path,
-                                       const std::vector<uint8_t>& content);
+                                       const std::vector<uint8_t>& content,
+                                       const bool sync = false);
+
+/** @see save_text_file */
+TOUCA_CLIENT_API void save_file(const std::string& path, const char* data,
+                                const std::size_t size, const bool binary,
+                                const bool sync);
+
+/**
+ * Same as `save_text_file` but lets a given function write content of the
+ * file, so that the content need not be held in memory all at once.
+ *
+ * @param write function that writes content of the file to a given stream
+ * @param binary whether to open the file in binary mode
+ */
+TOUCA_CLIENT_API void save_file(const std::string& path,
+                                const std::function<void(std::FILE*)>& write,
+                                const bool binary = false,
+                                const bool sync = false);
 
 }  // namespace detail
 }  // namespace touca
@@ -0,0 +1,317 @@
+// Copyright 2022 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "touca/core/compression.hpp"
+#include "touca/core/digest.hpp"
+#include "touca/core/filesystem.hpp"
+#include "touca/core/testcase.hpp"
+
+namespace touca {
+namespace fbs {
+struct Dictionary;
+}  // namespace fbs
+
+/**
+ * Position and digest of a serialized testcase within a result file.
+ */
+struct TOUCA_CLIENT_API ResultFileEntry {
+  /** number of bytes from the start of the file to the serialized message */
+  std::uint64_t offset;
+  /** size of the serialized message in bytes */
+  std::uint64_t size;
+  /** xxh64 digest of the serialized message */
+  std::uint64_t digest;
+  /** codec with which the serialized message is compressed */
+  Compression compression;
+  /** size of the serialized message before it was compressed */
+  std::uint64_t raw_size;
+};
+
+using ResultFileIndex = std::map<std::string, ResultFileEntry>;
+
+/**
+ * Position of each file stored alongside the testcases of a result file,
+ * keyed by name of the testcase to which the file belongs and then by name
+ * of the file.
+ */
+using ResultFileAttachments =
+    std::map<std::string, std::map<std::string, ResultFileEntry>>;
+
+/**
+ * @return whether given content of a result file was written by
+ *         `ResultFileWriter`, as opposed to `Testcase::serialize`
+ */
+TOUCA_CLIENT_API bool is_result_stream(const std::string& content);
+
+/**
+ * Finds the testcases in the content of a result file written by
+ * `ResultFileWriter`, in the order they were written. Reading stops at the
+ * first record that was not fully written. Records that hold attachments
+ * are skipped.
+ *
+ * @param content entire content of a result file
+ * @return position of each complete testcase in the content
+ */
+TOUCA_CLIENT_API std::vector<ResultFileEntry> read_records(
+    const std::string& content);
+
+/**
+ * Outcome of checking content of a result file against the checksum
+ * recorded in its footer.
+ */
+enum class ChecksumStatus { Missing, Match, Mismatch };
+
+/**
+ * Determines how thoroughly result files are checked when they are loaded.
+ */
+enum class VerifyMode : std::uint8_t {
+  /** verify the structure of the file and of all of its testcases */
+  Full,
+  /**
+   * compare the file against the checksum recorded in its footer and
+   * verify nothing else. Files without a checksum are fully verified.
+   */
+  Checksum,
+  /**
+   * verify the structure of the file and its string table when loading it
+   * and verify each testcase only once it is read.
+   */
+  Lazy
+};
+
+/**
+ * Appends a footer to the serialized content of a result file that maps
+ * name of each testcase to the position of its serialized message within
+ * the file. The footer follows the `fbs::Messages` data so that readers
+ * unaware of it can continue to read the file as before. It also records
+ * a checksum of everything that precedes it.
+ *
+ * @param content serialized `fbs::Messages` data, as produced by
+ *                `Testcase::serialize`
+ */
+TOUCA_CLIENT_API void append_footer(std::vector<std::uint8_t>& content);
+
+/**
+ * Checks content of a result file against the checksum recorded in its
+ * footer, without verifying its structure.
+ *
+ * @param content entire content of a result file
+ * @throw touca::detail::runtime_error if the file has an invalid footer
+ * @return `ChecksumStatus::Missing` if the file has no footer or its footer
+ *         has no checksum
+ */
+TOUCA_CLIENT_API ChecksumStatus verify_checksum(const std::string& content);
+
+/**
+ * Reads the footer index of a result file without loading the rest of
+ * its content.
+ *
+ * @param path path to the result file
+ * @throw touca::detail::runtime_error if the file is missing or its footer
+ *        is invalid
+ * @return index of testcases in the file or an empty index if the file was
+ *         written without a footer
+ */
+TOUCA_CLIENT_API ResultFileIndex
+read_index(const touca::filesystem::path& path);
+
+/**
+ * Loads a single testcase from a result file. When the file has a footer
+ * index, only the serialized message of the given testcase is read from
+ * disk. Otherwise, the entire file is deserialized.
+ *
+ * @param path path to the result file
+ * @param name name of the testcase to load
+ * @throw touca::detail::runtime_error if the file is invalid or does not
+ *        include the given testcase
+ */
+TOUCA_CLIENT_API Testcase read_testcase(const touca::filesystem::path& path,
+                                        const std::string& name);
+
+/**
+ * Reads testcases of a result file one at a time through the footer index
+ * of the file, without loading the rest of its content. Testcases may be
+ * read from multiple threads at once.
+ */
+class TOUCA_CLIENT_API ResultFileReader {
+ public:
+  /**
+   * Reads the footer index and the string table of a result file.
+   *
+   * Since testcases are read one at a time, each testcase is verified as
+   * it is read in both `VerifyMode::Full` and `VerifyMode::Lazy`. In
+   * `VerifyMode::Checksum`, the file is read once to compare it against
+   * the checksum recorded in its footer and, if it matches, only the
+   * digest of each testcase is checked as it is read.
+   *
+   * @param path path to the result file
+   * @param mode how thoroughly to verify the content of the file
+   * @throw touca::detail::runtime_error if the file is missing, its footer
+   *        or string table is invalid or it does not match its checksum
+   */
+  explicit ResultFileReader(const touca::filesystem::path& path,
+                            const VerifyMode mode = VerifyMode::Full);
+
+  /**
+   * @return index of testcases in the file or an empty index if the file was
+   *         written without a footer
+   */
+  const ResultFileIndex& index() const { return _index; }
+
+  /**
+   * @return string table of the result file or `nullptr` if its testcases
+   *         store their keys inline
+   */
+  const fbs::Dictionary* dictionary() const;
+
+  /**
+   * Reads the serialized message of a given testcase, decompressing it if
+   * it is compressed and verifying its digest and structure.
+   *
+   * @param name name of the testcase to read
+   * @throw touca::detail::runtime_error if the file does not include the
+   *        given testcase or the testcase is corrupted
+   * @return serialized `fbs::Message` data
+   */
+  std::vector<std::uint8_t> read_message(const std::string& name) const;
+
+ private:
+  std::string _path;
+  ResultFileIndex _index;
+  std::vector<std::uint8_t> _dictionary;
+  bool _verify = true;
+};
+
+/**
+ * Loads a file that was stored alongside a testcase of a result file
+ * written by `ResultFileWriter`. If the file was attached more than once,
+ * the copy attached last is returned.
+ *
+ * @param path path to the result file
+ * @param testcase name of the testcase to which the file belongs
+ * @param name name of the attached file
+ * @throw touca::detail::runtime_error if the result file is invalid or has
+ *        no such attachment
+ */
+TOUCA_CLIENT_API std::string read_attachment(
+    const touca::filesystem::path& path, const std::string& testcase,
+    const std::string& name);
+
+/**
+ * Writes testcases to a result file one at a time, as soon as each testcase
+ * is complete, so that no testcase has to be held in memory or written twice.
+ *
+ * Each testcase is appended as a record that ends with the digest of its
+ * content. If the process stops before a record is fully written, that
+ * record is ignored by readers and discarded when the file is opened again.
+ * The file can be read before it is finalized, but only finalizing it adds
+ * the footer index that allows loading testcases individually. Appending a
+ * testcase that is already in the file supersedes its earlier copy.
+ */
+class TOUCA_CLIENT_API ResultFileWriter {
+ public:
+  /**
+   * Opens a result file for appending testcases. Testcases already in the
+   * file are kept, including those of a file that was finalized before.
+   *
+   * @param path path to the result file
+   * @param options options that determine how testcases are encoded.
+   *                Testcases are always written without a string table.
+   * @throw touca::detail::runtime_error if the file cannot be opened or
+   *        was not written by `ResultFileWriter`
+   */
+  explicit ResultFileWriter(
+      const touca::filesystem::path& path,
+      const SerializationOptions& options = SerializationOptions());
+
+  /**
+   * Appends a testcase to the result file.
+   *
+   * @throw touca::detail::runtime_error if the file is finalized, the
+   *        testcase is 4 GiB or larger once encoded or it could not be
+   *        written
+   */
+  void append(const Testcase& testcase);
+
+  /**
+   * Appends a testcase that was already serialized to the result file.
+   *
+   * @param testcase name of the testcase
+   * @param message testcase serialized by `Testcase::flatbuffers` with the
+   *                options returned by `options`
+   * @throw touca::detail::runtime_error if the file is finalized, the
+   *        testcase is 4 GiB or larger once encoded or it could not be
+   *        written
+   */
+  void append(const std::string& testcase, std::vector<std::uint8_t> message);
+
+  /**
+   * Stores a file, such as the output captured while running a testcase,
+   * alongside the testcases of the result file.
+   *
+   * @param testcase name of the testcase to which the file belongs
+   * @param name name of the file
+   * @param content content of the file
+   * @throw touca::detail::runtime_error if the result file is finalized,
+   *        the file is 4 GiB or larger once encoded or it could not be
+   *        written
+   */
+  void attach(const std::string& testcase, const std::string& name,
+              const std::string& content);
+
+  /**
+   * Writes the footer index of the result file and closes it. If records
+   * of superseded testcases and attachments take up more than a quarter of
+   * the file, the file is rewritten without them instead.
+   *
+   * @param sync whether to flush the file to stable storage. A rewritten
+   *             file is flushed before it replaces the original one.
+   * @throw touca::detail::runtime_error if the file could not be written
+   */
+  void finalize(const bool sync = false);
+
+  /**
+   * @return position of the testcases written to the result file so far
+   */
+  const ResultFileIndex& index() const { return _index; }
+
+  /**
+   * @return position of the files attached to the result file so far
+   */
+  const ResultFileAttachments& attachments() const { return _attachments; }
+
+  /**
+   * @return options with which testcases are encoded in the result file
+   */
+  const SerializationOptions& options() const { return _options; }
+
+  /**
+   * @return path to the result file
+   */
+  const std::string& path() const { return _path; }
+
+ private:
+  ResultFileEntry write_record(const std::uint8_t kind,
+                               std::vector<std::uint8_t> content);
+  void write(const std::vector<std::uint8_t>& content);
+  void compact(const bool sync);
+  void supersede(ResultFileEntry& current, const ResultFileEntry& entry);
+
+  std::string _path;
+  SerializationOptions _options;
+  ResultFileIndex _index;
+  ResultFileAttachments _attachments;
+  std::ofstream _file;
+  std::uint64_t _size = 0;
+  std::uint64_t _superseded = 0;
+  touca::detail::xxh64 _checksum;
+};
+
+}  // namespace touca
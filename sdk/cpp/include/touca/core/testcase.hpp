@@ -3,6 +3,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdio>
 #include <map>
 #include <unordered_map>
 
@@ -80,11 +81,33 @@ class TOUCA_CLIENT_API Testcase {
    */
   void clear();
 
+  /**
+   * Converts numbers captured as assumptions and checks of this testcase to
+   * the numeric types of their counterparts in a given testcase, where the
+   * conversion preserves their value. Useful for testcases loaded from json
+   * result files, which do not record the types of numbers.
+   *
+   * @param reference testcase whose numeric types to adopt
+   */
+  void conform_numbers(const Testcase& reference);
+
   MetricsMap metrics() const;
 
   rapidjson::Value json(RJAllocator& allocator) const;
 
-  std::vector<uint8_t> flatbuffers() const;
+  /**
+   * Writes the same json representation that `json` builds to a given
+   * rapidjson writer as it is visited, without building a document.
+   *
+   * @param writer rapidjson writer
+   * @return false if the writer rejected any part of the testcase
+   */
+  template <typename Writer>
+  bool write_json(Writer& writer) const;
+
+  std::vector<uint8_t> flatbuffers(
+      const SerializationOptions& options = SerializationOptions(),
+      detail::string_table* strings = nullptr) const;
 
   Metadata metadata() const;
 
@@ -97,9 +120,12 @@ class TOUCA_CLIENT_API Testcase {
    * data compliant with Touca flatbuffers schema.
    *
    * @param testcases list of `Testcase` objects to be serialized
+   * @param options options that determine how test results are encoded
    * @return serialized binary data in flatbuffers format
    */
-  static std::vector<uint8_t> serialize(const std::vector<Testcase>& testcases);
+  static std::vector<uint8_t> serialize(
+      const std::vector<Testcase>& testcases,
+      const SerializationOptions& options = SerializationOptions());
 
  private:
   bool _posted;
@@ -110,9 +136,96 @@ class TOUCA_CLIENT_API Testcase {
   std::unordered_map<std::string, std::chrono::system_clock::time_point> _tocs;
 };
 
+namespace detail {
+
+/**
+ * Version of the json representation of testcases that `Testcase::json` and
+ * `Testcase::write_json` produce, written as the `formatVersion` field of each
+ * testcase. Testcases written by earlier versions have no such field and hold
+ * each value as a string rendered by `data_point::to_string`. Since version 2,
+ * values are written as native json values.
+ */
+constexpr unsigned json_format_version = 2;
+
+template <typename Writer>
+bool write_json_entry(Writer& writer, const std::string& key,
+                      const data_point& value) {
+  return writer.StartObject() && writer.Key("key") &&
+         detail::write_json_string(writer, key) && writer.Key("value") &&
+         value.write_json(writer) && writer.EndObject();
+}
+
+template <typename Writer>
+bool write_json_entries(Writer& writer, const char* name,
+                        const ResultsMap& results,
+                        const ResultCategory category) {
+  if (!writer.Key(name) || !writer.StartArray()) {
+    return false;
+  }
+  for (const auto& entry : results) {
+    if (entry.second.typ == category &&
+        !write_json_entry(writer, entry.first, entry.second.val)) {
+      return false;
+    }
+  }
+  return writer.EndArray();
+}
+
+}  // namespace detail
+
+template <typename Writer>
+bool Testcase::write_json(Writer& writer) const {
+  if (!writer.StartObject() || !writer.Key("formatVersion") ||
+      !writer.Uint(detail::json_format_version) || !writer.Key("metadata") ||
+      !writer.StartObject() || !writer.Key("teamslug") ||
+      !detail::write_json_string(writer, _metadata.teamslug) ||
+      !writer.Key("testsuite") ||
+      !detail::write_json_string(writer, _metadata.testsuite) ||
+      !writer.Key("version") ||
+      !detail::write_json_string(writer, _metadata.version) ||
+      !writer.Key("testcase") ||
+      !detail::write_json_string(writer, _metadata.testcase) ||
+      !writer.Key("builtAt") ||
+      !detail::write_json_string(writer, _metadata.builtAt) ||
+      !writer.EndObject() ||
+      !detail::write_json_entries(writer, "results", _resultsMap,
+                                  ResultCategory::Check) ||
+      !detail::write_json_entries(writer, "assertion", _resultsMap,
+                                  ResultCategory::Assert) ||
+      !writer.Key("metrics") || !writer.StartArray()) {
+    return false;
+  }
+  for (const auto& entry : metrics()) {
+    if (!detail::write_json_entry(writer, entry.first, entry.second.value)) {
+      return false;
+    }
+  }
+  return writer.EndArray() && writer.EndObject();
+}
+
 using ElementsMap = std::unordered_map<std::string, std::shared_ptr<Testcase>>;
 
+/**
+ * @return json array of given testcases, in the given order
+ */
+TOUCA_CLIENT_API std::string testcases_to_json(
+    const std::vector<const Testcase*>& testcases);
+
+/**
+ * Writes a json array of given testcases to a given file, one value at a
+ * time, so that memory use does not grow with size of the testcases.
+ *
+ * @param file file open for writing
+ * @param testcases testcases to write, in the given order
+ */
+TOUCA_CLIENT_API void write_json(std::FILE* file,
+                                 const std::vector<const Testcase*>& testcases);
+
 TOUCA_CLIENT_API std::string elements_map_to_json(
     const ElementsMap& elements_map);
 
+/** @see write_json */
+TOUCA_CLIENT_API void write_json(std::FILE* file,
+                                 const ElementsMap& elements_map);
+
 }  // namespace touca
@@ -0,0 +1,73 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "touca/lib_api.hpp"
+
+namespace touca {
+namespace detail {
+
+/**
+ * Range of consecutive lines that are different in two texts, along with
+ * the range of lines that they correspond to in the other text. Lines are
+ * counted from zero.
+ */
+struct TOUCA_CLIENT_API TextHunk {
+  std::size_t src_line = 0;
+  std::size_t src_count = 0;
+  std::size_t dst_line = 0;
+  std::size_t dst_count = 0;
+};
+
+/**
+ * Outcome of comparing two texts line by line.
+ */
+struct TOUCA_CLIENT_API TextComparison {
+  /** number of lines of each text */
+  std::size_t src_lines = 0;
+  std::size_t dst_lines = 0;
+  /**
+   * number of lines that both texts have in common, or if the comparison
+   * was not complete, the number of lines at the start and end of both
+   * texts that are identical
+   */
+  std::size_t common_lines = 0;
+  /** whether the texts were compared within the given budget */
+  bool complete = true;
+  /** total number of ranges of lines that are different */
+  std::size_t hunk_count = 0;
+  /** first few ranges of lines that are different, in order */
+  std::vector<TextHunk> hunks;
+
+  /**
+   * @return share of the lines of both texts that they have in common,
+   *         from zero for texts with no line in common to one for
+   *         identical texts
+   */
+  double similarity() const;
+};
+
+/**
+ * Finds the shortest sequence of lines to insert and remove that turns
+ * one text into another, using the Myers difference algorithm after
+ * setting aside the lines at the start and end of both texts that are
+ * identical. Takes time proportional to the number of lines times the
+ * number of lines to insert or remove, and memory proportional to the
+ * square of the number of lines to insert or remove, both of which are
+ * bounded by a given budget.
+ *
+ * @param max_hunks maximum number of ranges of different lines to collect
+ * @param max_edits maximum number of lines to insert or remove, beyond
+ *                  which the texts are not compared any further
+ */
+TOUCA_CLIENT_API TextComparison compare_lines(const std::string& src,
+                                              const std::string& dst,
+                                              const std::size_t max_hunks,
+                                              const std::size_t max_edits);
+
+}  // namespace detail
+}  // namespace touca
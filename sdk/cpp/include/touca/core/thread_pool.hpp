@@ -0,0 +1,95 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "touca/lib_api.hpp"
+
+namespace touca {
+namespace detail {
+
+/**
+ * Runs batches of independent tasks on a fixed set of threads.
+ *
+ * Each thread keeps its own queue of tasks. Threads run the tasks they
+ * queued most recently first and, once their own queue is empty, steal the
+ * oldest tasks of other threads. The thread that submits a batch helps run
+ * queued tasks until its batch is complete, so that tasks may submit nested
+ * batches to the same pool without blocking any of its threads.
+ */
+class TOUCA_CLIENT_API ThreadPool {
+ public:
+  /**
+   * @param size number of threads that run tasks, including the thread that
+   *             submits them, or zero to use one thread per hardware thread
+   */
+  explicit ThreadPool(const std::size_t size = 0);
+
+  /**
+   * Stops the threads of this pool. Must not be called while a batch is
+   * running.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @return number of threads that run tasks, including the thread that
+   *         submits them
+   */
+  std::size_t size() const { return _queues.size(); }
+
+  /**
+   * @return pool that is running a task on the calling thread, if any, so
+   *         that the task can split its work into a nested batch
+   */
+  static ThreadPool* current();
+
+  /**
+   * Runs given tasks in no particular order and waits until all of them
+   * have completed.
+   *
+   * @param tasks functions to run, possibly at the same time
+   * @throw touca::detail::runtime_error if any of the tasks failed, with
+   *        the error of the first task that failed
+   */
+  void run(std::vector<std::function<void()>> tasks);
+
+ private:
+  struct Batch;
+
+  struct Task {
+    std::function<void()> run;
+    Batch* batch;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::size_t own_queue() const;
+  bool pop(const std::size_t index, Task& task);
+  void execute(Task& task);
+  void work(const std::size_t index);
+
+  std::vector<std::unique_ptr<Queue>> _queues;
+  std::atomic<std::size_t> _queued{0};
+  bool _stopped = false;
+  std::mutex _mutex;
+  std::condition_variable _changed;
+  std::vector<std::thread> _threads;
+};
+
+}  // namespace detail
+}  // namespace touca
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
@@ -10,10 +11,12 @@
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "rapidjson/fwd.h"
+#include "touca/core/compression.hpp"
 #include "touca/core/variant.hpp"
 #include "touca/lib_api.hpp"
 
@@ -62,6 +65,97 @@ using number_double_t = double;
 
 }  // namespace detail
 
+/**
+ * Options that determine how test results are encoded in binary format.
+ * Defaults produce the encoding accepted by all versions of the Touca server.
+ */
+struct TOUCA_CLIENT_API SerializationOptions {
+  /**
+   * Store non-empty arrays whose elements are all booleans or all numbers of
+   * the same type as packed vectors of scalars rather than arrays of
+   * individually wrapped values.
+   */
+  bool packed_arrays = false;
+
+  /**
+   * Store keys, object names and member names once per result file in a
+   * string table shared by all of its testcases and refer to them by their
+   * position in that table.
+   */
+  bool string_table = false;
+
+  /**
+   * Serialize objects, arrays and strings that appear more than once in the
+   * same testcase only once and refer to that copy wherever they appear.
+   * Unlike other options, this encoding is readable by all versions of the
+   * Touca SDKs and server.
+   */
+  bool deduplicate = false;
+
+  /**
+   * Codec with which each testcase is compressed, independently of other
+   * testcases so that they can still be read and decompressed on their own.
+   */
+  Compression compression = Compression::None;
+
+  /**
+   * Codec-specific compression level. Zero selects the default level of
+   * the codec.
+   */
+  int compression_level = 0;
+};
+
+namespace detail {
+
+/**
+ * Strings shared by testcases that are serialized into the same result file.
+ */
+class TOUCA_CLIENT_API string_table {
+ public:
+  /**
+   * @return position of a given string in the table, after adding it to the
+   *         table if it was not already present
+   */
+  std::uint32_t add(const std::string& value);
+
+  const std::vector<std::string>& values() const { return _values; }
+
+ private:
+  std::unordered_map<std::string, std::uint32_t> _ids;
+  std::vector<std::string> _values;
+};
+
+/**
+ * Values serialized into the same flatbuffers builder, indexed by a digest
+ * of their content, so that identical values can share a single serialized
+ * copy. Values must outlive the cache and remain unchanged while in use.
+ */
+class TOUCA_CLIENT_API subtree_cache {
+ public:
+  /**
+   * @return offset of a previously serialized value identical to a given
+   *         value, or zero if there is no such value
+   */
+  std::uint32_t find(const data_point& value);
+
+  /**
+   * Records the offset at which a given value is serialized.
+   */
+  void add(const data_point& value, std::uint32_t offset);
+
+ private:
+  std::uint64_t hash(const data_point& value);
+
+  static bool is_same(const data_point& lhs, const data_point& rhs);
+
+  std::unordered_map<const data_point*, std::uint64_t> _digests;
+  std::unordered_multimap<std::uint64_t,
+                          std::pair<const data_point*, std::uint32_t>>
+      _offsets;
+};
+
+}  // namespace detail
+
 struct TOUCA_CLIENT_API array final {
   friend class data_point;
 
@@ -136,6 +230,7 @@ class TOUCA_CLIENT_API data_point {
       const data_point& input);
   friend rapidjson::Value to_json(const data_point& value,
                                   RJAllocator& allocator);
+  friend class detail::subtree_cache;
 
  public:
   data_point(const array& value)
@@ -226,12 +321,44 @@ class TOUCA_CLIENT_API data_point {
 
   std::string to_string() const;
 
+  /**
+   * Same as `to_string` but replaces the content of a given string, so that
+   * callers that render many values can reuse its allocated storage.
+   *
+   * @param out string to hold the rendered value
+   */
+  void to_string(std::string& out) const;
+
+  /**
+   * Same as `to_string` but renders no more than a given number of bytes,
+   * so that huge values can be previewed without rendering them in full.
+   *
+   * @param out string to hold the rendered value
+   * @param max_size maximum number of bytes to render
+   * @return whether the value was rendered in full
+   */
+  bool to_string(std::string& out, const std::size_t max_size) const;
+
+  /**
+   * Writes json representation of this value to a given rapidjson writer as
+   * it is visited, without building an intermediate document. NaN and
+   * infinite numbers are written as `NaN`, `Infinity` and `-Infinity`.
+   *
+   * @param writer rapidjson writer
+   * @return false if the writer rejected any part of the value
+   */
+  template <typename Writer>
+  bool write_json(Writer& writer) const;
+
   touca::detail::number_signed_t as_metric() const noexcept {
     return touca::detail::get<detail::number_signed_t>(_value);
   }
 
   flatbuffers::Offset<fbs::TypeWrapper> serialize(
-      flatbuffers::FlatBufferBuilder& builder) const;
+      flatbuffers::FlatBufferBuilder& builder,
+      const SerializationOptions& options = SerializationOptions(),
+      detail::string_table* strings = nullptr,
+      detail::subtree_cache* subtrees = nullptr) const;
 
  private:
   // default, null
@@ -292,6 +419,118 @@ class TOUCA_CLIENT_API data_point {
       _value;
 };
 
+namespace detail {
+
+template <typename Writer>
+bool write_json_key(Writer& writer, const std::string& key) {
+  return writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size()));
+}
+
+template <typename Writer>
+bool write_json_string(Writer& writer, const std::string& value) {
+  return writer.String(value.data(),
+                       static_cast<rapidjson::SizeType>(value.size()));
+}
+
+/**
+ * Writes a given number to a given rapidjson writer. Json has no
+ * representation for NaN and infinite numbers, which rapidjson writers
+ * reject unless they are created with `kWriteNanAndInfFlag`. We write them
+ * as the `NaN`, `Infinity` and `-Infinity` literals that such writers would
+ * produce, whatever the flags of the given writer, so that they can be
+ * read back by rapidjson readers with `kParseNanAndInfFlag` and by most
+ * other json parsers that accept these literals.
+ */
+template <typename Writer>
+bool write_json_number(Writer& writer, const double value) {
+  if (std::isnan(value)) {
+    return writer.RawValue("NaN", 3, rapidjson::kNumberType);
+  }
+  if (std::isinf(value)) {
+    return value < 0 ? writer.RawValue("-Infinity", 9, rapidjson::kNumberType)
+                     : writer.RawValue("Infinity", 8, rapidjson::kNumberType);
+  }
+  return writer.Double(value);
+}
+
+/**
+ * Output stream for rapidjson writers that appends to a given string and
+ * drops whatever would grow the string beyond a given size.
+ */
+class string_output_stream {
+ public:
+  using Ch = char;
+
+  explicit string_output_stream(std::string& out,
+                                const std::size_t max_size = std::string::npos)
+      : _out(out), _max_size(max_size) {}
+
+  void Put(const char c) {
+    if (_out.size() < _max_size) {
+      _out.push_back(c);
+    } else {
+      _truncated = true;
+    }
+  }
+
+  void Flush() {}
+
+  /** @return whether any output was dropped */
+  bool truncated() const { return _truncated; }
+
+ private:
+  std::string& _out;
+  std::size_t _max_size;
+  bool _truncated = false;
+};
+
+}  // namespace detail
+
+template <typename Writer>
+bool data_point::write_json(Writer& writer) const {
+  switch (_type) {
+    case detail::internal_type::object: {
+      const auto& obj = *detail::get<detail::deep_copy_ptr<object>>(_value);
+      if (!writer.StartObject() ||
+          !detail::write_json_key(writer, obj.get_name()) ||
+          !writer.StartObject()) {
+        return false;
+      }
+      for (const auto& member : obj) {
+        if (!detail::write_json_key(writer, member.first) ||
+            !member.second.write_json(writer)) {
+          return false;
+        }
+      }
+      return writer.EndObject() && writer.EndObject();
+    }
+    case detail::internal_type::array:
+      if (!writer.StartArray()) {
+        return false;
+      }
+      for (const auto& element : *as_array()) {
+        if (!element.write_json(writer)) {
+          return false;
+        }
+      }
+      return writer.EndArray();
+    case detail::internal_type::string:
+      return detail::write_json_string(writer, *as_string());
+    case detail::internal_type::boolean:
+      return writer.Bool(as_boolean());
+    case detail::internal_type::number_signed:
+      return writer.Int64(as_number_signed());
+    case detail::internal_type::number_unsigned:
+      return writer.Uint64(as_number_unsigned());
+    case detail::internal_type::number_float:
+      return detail::write_json_number(writer, as_number_float());
+    case detail::internal_type::number_double:
+      return detail::write_json_number(writer, as_number_double());
+    default:
+      return writer.Null();
+  }
+}
+
 /**
  * @brief Non-specialized template declaration of conversion
  *        logic for handling objects of custom types by the
@@ -0,0 +1,690 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+#pragma once
+
+#include "flatbuffers/flatbuffers.h"
+
+#include "touca/impl/schema.hpp"
+
+namespace touca {
+namespace fbs {
+
+struct KeyComparison;
+struct KeyComparisonBuilder;
+
+struct KeyComparisons;
+struct KeyComparisonsBuilder;
+
+struct ComparisonOverview;
+struct ComparisonOverviewBuilder;
+
+struct CaseComparison;
+struct CaseComparisonBuilder;
+
+struct FileComparison;
+struct FileComparisonBuilder;
+
+enum class ValueType : uint8_t {
+  Unknown = 0,
+  Bool = 1,
+  Number = 2,
+  String = 3,
+  Array = 4,
+  Object = 5,
+  MIN = Unknown,
+  MAX = Object
+};
+
+struct KeyComparison FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef KeyComparisonBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_SCORE = 6,
+    VT_MATCH = 8,
+    VT_SRC_TYPE = 10,
+    VT_DST_TYPE = 12,
+    VT_SRC_VALUE = 14,
+    VT_DST_VALUE = 16,
+    VT_DESC = 18
+  };
+  const flatbuffers::String* name() const {
+    return GetPointer<const flatbuffers::String*>(VT_NAME);
+  }
+  bool KeyCompareLessThan(const KeyComparison* o) const {
+    return *name() < *o->name();
+  }
+  int KeyCompareWithValue(const char* _name) const {
+    return strcmp(name()->c_str(), _name);
+  }
+  double score() const { return GetField<double>(VT_SCORE, 0.0); }
+  bool match() const { return GetField<uint8_t>(VT_MATCH, 0) != 0; }
+  touca::fbs::ValueType src_type() const {
+    return static_cast<touca::fbs::ValueType>(
+        GetField<uint8_t>(VT_SRC_TYPE, 0));
+  }
+  touca::fbs::ValueType dst_type() const {
+    return static_cast<touca::fbs::ValueType>(
+        GetField<uint8_t>(VT_DST_TYPE, 0));
+  }
+  const flatbuffers::String* src_value() const {
+    return GetPointer<const flatbuffers::String*>(VT_SRC_VALUE);
+  }
+  const flatbuffers::String* dst_value() const {
+    return GetPointer<const flatbuffers::String*>(VT_DST_VALUE);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>* desc()
+      const {
+    return GetPointer<
+        const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>*>(
+        VT_DESC);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffsetRequired(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyField<double>(verifier, VT_SCORE) &&
+           VerifyField<uint8_t>(verifier, VT_MATCH) &&
+           VerifyField<uint8_t>(verifier, VT_SRC_TYPE) &&
+           VerifyField<uint8_t>(verifier, VT_DST_TYPE) &&
+           VerifyOffset(verifier, VT_SRC_VALUE) &&
+           verifier.VerifyString(src_value()) &&
+           VerifyOffset(verifier, VT_DST_VALUE) &&
+           verifier.VerifyString(dst_value()) &&
+           VerifyOffset(verifier, VT_DESC) && verifier.VerifyVector(desc()) &&
+           verifier.VerifyVectorOfStrings(desc()) && verifier.EndTable();
+  }
+};
+
+struct KeyComparisonBuilder {
+  typedef KeyComparison Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(KeyComparison::VT_NAME, name);
+  }
+  void add_score(double score) {
+    fbb_.AddElement<double>(KeyComparison::VT_SCORE, score, 0.0);
+  }
+  void add_match(bool match) {
+    fbb_.AddElement<uint8_t>(KeyComparison::VT_MATCH,
+                             static_cast<uint8_t>(match), 0);
+  }
+  void add_src_type(touca::fbs::ValueType src_type) {
+    fbb_.AddElement<uint8_t>(KeyComparison::VT_SRC_TYPE,
+                             static_cast<uint8_t>(src_type), 0);
+  }
+  void add_dst_type(touca::fbs::ValueType dst_type) {
+    fbb_.AddElement<uint8_t>(KeyComparison::VT_DST_TYPE,
+                             static_cast<uint8_t>(dst_type), 0);
+  }
+  void add_src_value(flatbuffers::Offset<flatbuffers::String> src_value) {
+    fbb_.AddOffset(KeyComparison::VT_SRC_VALUE, src_value);
+  }
+  void add_dst_value(flatbuffers::Offset<flatbuffers::String> dst_value) {
+    fbb_.AddOffset(KeyComparison::VT_DST_VALUE, dst_value);
+  }
+  void add_desc(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>
+          desc) {
+    fbb_.AddOffset(KeyComparison::VT_DESC, desc);
+  }
+  explicit KeyComparisonBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<KeyComparison> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<KeyComparison>(end);
+    fbb_.Required(o, KeyComparison::VT_NAME);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<KeyComparison> CreateKeyComparison(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0, double score = 0.0,
+    bool match = false,
+    touca::fbs::ValueType src_type = touca::fbs::ValueType::Unknown,
+    touca::fbs::ValueType dst_type = touca::fbs::ValueType::Unknown,
+    flatbuffers::Offset<flatbuffers::String> src_value = 0,
+    flatbuffers::Offset<flatbuffers::String> dst_value = 0,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>
+        desc = 0) {
+  KeyComparisonBuilder builder_(_fbb);
+  builder_.add_score(score);
+  builder_.add_desc(desc);
+  builder_.add_dst_value(dst_value);
+  builder_.add_src_value(src_value);
+  builder_.add_name(name);
+  builder_.add_dst_type(dst_type);
+  builder_.add_src_type(src_type);
+  builder_.add_match(match);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<KeyComparison> CreateKeyComparisonDirect(
+    flatbuffers::FlatBufferBuilder& _fbb, const char* name = nullptr,
+    double score = 0.0, bool match = false,
+    touca::fbs::ValueType src_type = touca::fbs::ValueType::Unknown,
+    touca::fbs::ValueType dst_type = touca::fbs::ValueType::Unknown,
+    const char* src_value = nullptr, const char* dst_value = nullptr,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>>* desc =
+        nullptr) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  auto src_value__ = src_value ? _fbb.CreateString(src_value) : 0;
+  auto dst_value__ = dst_value ? _fbb.CreateString(dst_value) : 0;
+  auto desc__ =
+      desc ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*desc)
+           : 0;
+  return touca::fbs::CreateKeyComparison(_fbb, name__, score, match, src_type,
+                                         dst_type, src_value__, dst_value__,
+                                         desc__);
+}
+
+struct KeyComparisons FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef KeyComparisonsBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_COMMON = 4,
+    VT_MISSING = 6,
+    VT_FRESH = 8
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>*
+  common() const {
+    return GetPointer<const flatbuffers::Vector<
+        flatbuffers::Offset<touca::fbs::KeyComparison>>*>(VT_COMMON);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>*
+  missing() const {
+    return GetPointer<const flatbuffers::Vector<
+        flatbuffers::Offset<touca::fbs::KeyComparison>>*>(VT_MISSING);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>*
+  fresh() const {
+    return GetPointer<const flatbuffers::Vector<
+        flatbuffers::Offset<touca::fbs::KeyComparison>>*>(VT_FRESH);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_COMMON) &&
+           verifier.VerifyVector(common()) &&
+           verifier.VerifyVectorOfTables(common()) &&
+           VerifyOffset(verifier, VT_MISSING) &&
+           verifier.VerifyVector(missing()) &&
+           verifier.VerifyVectorOfTables(missing()) &&
+           VerifyOffset(verifier, VT_FRESH) && verifier.VerifyVector(fresh()) &&
+           verifier.VerifyVectorOfTables(fresh()) && verifier.EndTable();
+  }
+};
+
+struct KeyComparisonsBuilder {
+  typedef KeyComparisons Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_common(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>>
+          common) {
+    fbb_.AddOffset(KeyComparisons::VT_COMMON, common);
+  }
+  void add_missing(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>>
+          missing) {
+    fbb_.AddOffset(KeyComparisons::VT_MISSING, missing);
+  }
+  void add_fresh(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>>
+          fresh) {
+    fbb_.AddOffset(KeyComparisons::VT_FRESH, fresh);
+  }
+  explicit KeyComparisonsBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<KeyComparisons> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<KeyComparisons>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<KeyComparisons> CreateKeyComparisons(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>>
+        common = 0,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>>
+        missing = 0,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::KeyComparison>>>
+        fresh = 0) {
+  KeyComparisonsBuilder builder_(_fbb);
+  builder_.add_fresh(fresh);
+  builder_.add_missing(missing);
+  builder_.add_common(common);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<KeyComparisons> CreateKeyComparisonsDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    std::vector<flatbuffers::Offset<touca::fbs::KeyComparison>>* common =
+        nullptr,
+    std::vector<flatbuffers::Offset<touca::fbs::KeyComparison>>* missing =
+        nullptr,
+    std::vector<flatbuffers::Offset<touca::fbs::KeyComparison>>* fresh =
+        nullptr) {
+  auto common__ =
+      common
+          ? _fbb.CreateVectorOfSortedTables<touca::fbs::KeyComparison>(common)
+          : 0;
+  auto missing__ =
+      missing
+          ? _fbb.CreateVectorOfSortedTables<touca::fbs::KeyComparison>(missing)
+          : 0;
+  auto fresh__ =
+      fresh
+          ? _fbb.CreateVectorOfSortedTables<touca::fbs::KeyComparison>(fresh)
+          : 0;
+  return touca::fbs::CreateKeyComparisons(_fbb, common__, missing__, fresh__);
+}
+
+struct ComparisonOverview FLATBUFFERS_FINAL_CLASS
+    : private flatbuffers::Table {
+  typedef ComparisonOverviewBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_KEYS_SCORE = 4,
+    VT_KEYS_COUNT_COMMON = 6,
+    VT_KEYS_COUNT_FRESH = 8,
+    VT_KEYS_COUNT_MISSING = 10,
+    VT_METRICS_COUNT_COMMON = 12,
+    VT_METRICS_COUNT_FRESH = 14,
+    VT_METRICS_COUNT_MISSING = 16,
+    VT_METRICS_DURATION_COMMON_DST = 18,
+    VT_METRICS_DURATION_COMMON_SRC = 20
+  };
+  double keys_score() const { return GetField<double>(VT_KEYS_SCORE, 0.0); }
+  int32_t keys_count_common() const {
+    return GetField<int32_t>(VT_KEYS_COUNT_COMMON, 0);
+  }
+  int32_t keys_count_fresh() const {
+    return GetField<int32_t>(VT_KEYS_COUNT_FRESH, 0);
+  }
+  int32_t keys_count_missing() const {
+    return GetField<int32_t>(VT_KEYS_COUNT_MISSING, 0);
+  }
+  int32_t metrics_count_common() const {
+    return GetField<int32_t>(VT_METRICS_COUNT_COMMON, 0);
+  }
+  int32_t metrics_count_fresh() const {
+    return GetField<int32_t>(VT_METRICS_COUNT_FRESH, 0);
+  }
+  int32_t metrics_count_missing() const {
+    return GetField<int32_t>(VT_METRICS_COUNT_MISSING, 0);
+  }
+  int32_t metrics_duration_common_dst() const {
+    return GetField<int32_t>(VT_METRICS_DURATION_COMMON_DST, 0);
+  }
+  int32_t metrics_duration_common_src() const {
+    return GetField<int32_t>(VT_METRICS_DURATION_COMMON_SRC, 0);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<double>(verifier, VT_KEYS_SCORE) &&
+           VerifyField<int32_t>(verifier, VT_KEYS_COUNT_COMMON) &&
+           VerifyField<int32_t>(verifier, VT_KEYS_COUNT_FRESH) &&
+           VerifyField<int32_t>(verifier, VT_KEYS_COUNT_MISSING) &&
+           VerifyField<int32_t>(verifier, VT_METRICS_COUNT_COMMON) &&
+           VerifyField<int32_t>(verifier, VT_METRICS_COUNT_FRESH) &&
+           VerifyField<int32_t>(verifier, VT_METRICS_COUNT_MISSING) &&
+           VerifyField<int32_t>(verifier, VT_METRICS_DURATION_COMMON_DST) &&
+           VerifyField<int32_t>(verifier, VT_METRICS_DURATION_COMMON_SRC) &&
+           verifier.EndTable();
+  }
+};
+
+struct ComparisonOverviewBuilder {
+  typedef ComparisonOverview Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_keys_score(double keys_score) {
+    fbb_.AddElement<double>(ComparisonOverview::VT_KEYS_SCORE, keys_score,
+                            0.0);
+  }
+  void add_keys_count_common(int32_t keys_count_common) {
+    fbb_.AddElement<int32_t>(ComparisonOverview::VT_KEYS_COUNT_COMMON,
+                             keys_count_common, 0);
+  }
+  void add_keys_count_fresh(int32_t keys_count_fresh) {
+    fbb_.AddElement<int32_t>(ComparisonOverview::VT_KEYS_COUNT_FRESH,
+                             keys_count_fresh, 0);
+  }
+  void add_keys_count_missing(int32_t keys_count_missing) {
+    fbb_.AddElement<int32_t>(ComparisonOverview::VT_KEYS_COUNT_MISSING,
+                             keys_count_missing, 0);
+  }
+  void add_metrics_count_common(int32_t metrics_count_common) {
+    fbb_.AddElement<int32_t>(ComparisonOverview::VT_METRICS_COUNT_COMMON,
+                             metrics_count_common, 0);
+  }
+  void add_metrics_count_fresh(int32_t metrics_count_fresh) {
+    fbb_.AddElement<int32_t>(ComparisonOverview::VT_METRICS_COUNT_FRESH,
+                             metrics_count_fresh, 0);
+  }
+  void add_metrics_count_missing(int32_t metrics_count_missing) {
+    fbb_.AddElement<int32_t>(ComparisonOverview::VT_METRICS_COUNT_MISSING,
+                             metrics_count_missing, 0);
+  }
+  void add_metrics_duration_common_dst(int32_t metrics_duration_common_dst) {
+    fbb_.AddElement<int32_t>(
+        ComparisonOverview::VT_METRICS_DURATION_COMMON_DST,
+        metrics_duration_common_dst, 0);
+  }
+  void add_metrics_duration_common_src(int32_t metrics_duration_common_src) {
+    fbb_.AddElement<int32_t>(
+        ComparisonOverview::VT_METRICS_DURATION_COMMON_SRC,
+        metrics_duration_common_src, 0);
+  }
+  explicit ComparisonOverviewBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<ComparisonOverview> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ComparisonOverview>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ComparisonOverview> CreateComparisonOverview(
+    flatbuffers::FlatBufferBuilder& _fbb, double keys_score = 0.0,
+    int32_t keys_count_common = 0, int32_t keys_count_fresh = 0,
+    int32_t keys_count_missing = 0, int32_t metrics_count_common = 0,
+    int32_t metrics_count_fresh = 0, int32_t metrics_count_missing = 0,
+    int32_t metrics_duration_common_dst = 0,
+    int32_t metrics_duration_common_src = 0) {
+  ComparisonOverviewBuilder builder_(_fbb);
+  builder_.add_keys_score(keys_score);
+  builder_.add_metrics_duration_common_src(metrics_duration_common_src);
+  builder_.add_metrics_duration_common_dst(metrics_duration_common_dst);
+  builder_.add_metrics_count_missing(metrics_count_missing);
+  builder_.add_metrics_count_fresh(metrics_count_fresh);
+  builder_.add_metrics_count_common(metrics_count_common);
+  builder_.add_keys_count_missing(keys_count_missing);
+  builder_.add_keys_count_fresh(keys_count_fresh);
+  builder_.add_keys_count_common(keys_count_common);
+  return builder_.Finish();
+}
+
+struct CaseComparison FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef CaseComparisonBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_OVERVIEW = 6,
+    VT_SRC = 8,
+    VT_DST = 10,
+    VT_ASSERTIONS = 12,
+    VT_RESULTS = 14,
+    VT_METRICS = 16
+  };
+  const flatbuffers::String* name() const {
+    return GetPointer<const flatbuffers::String*>(VT_NAME);
+  }
+  bool KeyCompareLessThan(const CaseComparison* o) const {
+    return *name() < *o->name();
+  }
+  int KeyCompareWithValue(const char* _name) const {
+    return strcmp(name()->c_str(), _name);
+  }
+  const touca::fbs::ComparisonOverview* overview() const {
+    return GetPointer<const touca::fbs::ComparisonOverview*>(VT_OVERVIEW);
+  }
+  const touca::fbs::Metadata* src() const {
+    return GetPointer<const touca::fbs::Metadata*>(VT_SRC);
+  }
+  const touca::fbs::Metadata* dst() const {
+    return GetPointer<const touca::fbs::Metadata*>(VT_DST);
+  }
+  const touca::fbs::KeyComparisons* assertions() const {
+    return GetPointer<const touca::fbs::KeyComparisons*>(VT_ASSERTIONS);
+  }
+  const touca::fbs::KeyComparisons* results() const {
+    return GetPointer<const touca::fbs::KeyComparisons*>(VT_RESULTS);
+  }
+  const touca::fbs::KeyComparisons* metrics() const {
+    return GetPointer<const touca::fbs::KeyComparisons*>(VT_METRICS);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffsetRequired(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyOffset(verifier, VT_OVERVIEW) &&
+           verifier.VerifyTable(overview()) && VerifyOffset(verifier, VT_SRC) &&
+           verifier.VerifyTable(src()) && VerifyOffset(verifier, VT_DST) &&
+           verifier.VerifyTable(dst()) &&
+           VerifyOffset(verifier, VT_ASSERTIONS) &&
+           verifier.VerifyTable(assertions()) &&
+           VerifyOffset(verifier, VT_RESULTS) &&
+           verifier.VerifyTable(results()) &&
+           VerifyOffset(verifier, VT_METRICS) &&
+           verifier.VerifyTable(metrics()) && verifier.EndTable();
+  }
+};
+
+struct CaseComparisonBuilder {
+  typedef CaseComparison Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(CaseComparison::VT_NAME, name);
+  }
+  void add_overview(
+      flatbuffers::Offset<touca::fbs::ComparisonOverview> overview) {
+    fbb_.AddOffset(CaseComparison::VT_OVERVIEW, overview);
+  }
+  void add_src(flatbuffers::Offset<touca::fbs::Metadata> src) {
+    fbb_.AddOffset(CaseComparison::VT_SRC, src);
+  }
+  void add_dst(flatbuffers::Offset<touca::fbs::Metadata> dst) {
+    fbb_.AddOffset(CaseComparison::VT_DST, dst);
+  }
+  void add_assertions(
+      flatbuffers::Offset<touca::fbs::KeyComparisons> assertions) {
+    fbb_.AddOffset(CaseComparison::VT_ASSERTIONS, assertions);
+  }
+  void add_results(flatbuffers::Offset<touca::fbs::KeyComparisons> results) {
+    fbb_.AddOffset(CaseComparison::VT_RESULTS, results);
+  }
+  void add_metrics(flatbuffers::Offset<touca::fbs::KeyComparisons> metrics) {
+    fbb_.AddOffset(CaseComparison::VT_METRICS, metrics);
+  }
+  explicit CaseComparisonBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<CaseComparison> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<CaseComparison>(end);
+    fbb_.Required(o, CaseComparison::VT_NAME);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<CaseComparison> CreateCaseComparison(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    flatbuffers::Offset<touca::fbs::ComparisonOverview> overview = 0,
+    flatbuffers::Offset<touca::fbs::Metadata> src = 0,
+    flatbuffers::Offset<touca::fbs::Metadata> dst = 0,
+    flatbuffers::Offset<touca::fbs::KeyComparisons> assertions = 0,
+    flatbuffers::Offset<touca::fbs::KeyComparisons> results = 0,
+    flatbuffers::Offset<touca::fbs::KeyComparisons> metrics = 0) {
+  CaseComparisonBuilder builder_(_fbb);
+  builder_.add_metrics(metrics);
+  builder_.add_results(results);
+  builder_.add_assertions(assertions);
+  builder_.add_dst(dst);
+  builder_.add_src(src);
+  builder_.add_overview(overview);
+  builder_.add_name(name);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<CaseComparison> CreateCaseComparisonDirect(
+    flatbuffers::FlatBufferBuilder& _fbb, const char* name = nullptr,
+    flatbuffers::Offset<touca::fbs::ComparisonOverview> overview = 0,
+    flatbuffers::Offset<touca::fbs::Metadata> src = 0,
+    flatbuffers::Offset<touca::fbs::Metadata> dst = 0,
+    flatbuffers::Offset<touca::fbs::KeyComparisons> assertions = 0,
+    flatbuffers::Offset<touca::fbs::KeyComparisons> results = 0,
+    flatbuffers::Offset<touca::fbs::KeyComparisons> metrics = 0) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  return touca::fbs::CreateCaseComparison(_fbb, name__, overview, src, dst,
+                                          assertions, results, metrics);
+}
+
+struct FileComparison FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef FileComparisonBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_FRESH = 4,
+    VT_MISSING = 6,
+    VT_COMMON = 8
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>* fresh()
+      const {
+    return GetPointer<
+        const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>*>(
+        VT_FRESH);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>*
+  missing() const {
+    return GetPointer<
+        const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>*>(
+        VT_MISSING);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::CaseComparison>>*
+  common() const {
+    return GetPointer<const flatbuffers::Vector<
+        flatbuffers::Offset<touca::fbs::CaseComparison>>*>(VT_COMMON);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_FRESH) &&
+           verifier.VerifyVector(fresh()) &&
+           verifier.VerifyVectorOfTables(fresh()) &&
+           VerifyOffset(verifier, VT_MISSING) &&
+           verifier.VerifyVector(missing()) &&
+           verifier.VerifyVectorOfTables(missing()) &&
+           VerifyOffset(verifier, VT_COMMON) &&
+           verifier.VerifyVector(common()) &&
+           verifier.VerifyVectorOfTables(common()) && verifier.EndTable();
+  }
+};
+
+struct FileComparisonBuilder {
+  typedef FileComparison Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_fresh(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>>
+          fresh) {
+    fbb_.AddOffset(FileComparison::VT_FRESH, fresh);
+  }
+  void add_missing(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>>
+          missing) {
+    fbb_.AddOffset(FileComparison::VT_MISSING, missing);
+  }
+  void add_common(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::CaseComparison>>>
+          common) {
+    fbb_.AddOffset(FileComparison::VT_COMMON, common);
+  }
+  explicit FileComparisonBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<FileComparison> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<FileComparison>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<FileComparison> CreateFileComparison(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>>
+        fresh = 0,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::Metadata>>>
+        missing = 0,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::CaseComparison>>>
+        common = 0) {
+  FileComparisonBuilder builder_(_fbb);
+  builder_.add_common(common);
+  builder_.add_missing(missing);
+  builder_.add_fresh(fresh);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<FileComparison> CreateFileComparisonDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<flatbuffers::Offset<touca::fbs::Metadata>>* fresh =
+        nullptr,
+    const std::vector<flatbuffers::Offset<touca::fbs::Metadata>>* missing =
+        nullptr,
+    std::vector<flatbuffers::Offset<touca::fbs::CaseComparison>>* common =
+        nullptr) {
+  auto fresh__ =
+      fresh ? _fbb.CreateVector<flatbuffers::Offset<touca::fbs::Metadata>>(
+                  *fresh)
+            : 0;
+  auto missing__ =
+      missing ? _fbb.CreateVector<flatbuffers::Offset<touca::fbs::Metadata>>(
+                    *missing)
+              : 0;
+  auto common__ =
+      common
+          ? _fbb.CreateVectorOfSortedTables<touca::fbs::CaseComparison>(common)
+          : 0;
+  return touca::fbs::CreateFileComparison(_fbb, fresh__, missing__, common__);
+}
+
+inline const touca::fbs::FileComparison* GetFileComparison(const void* buf) {
+  return flatbuffers::GetRoot<touca::fbs::FileComparison>(buf);
+}
+
+inline const touca::fbs::FileComparison* GetSizePrefixedFileComparison(
+    const void* buf) {
+  return flatbuffers::GetSizePrefixedRoot<touca::fbs::FileComparison>(buf);
+}
+
+inline bool VerifyFileComparisonBuffer(flatbuffers::Verifier& verifier) {
+  return verifier.VerifyBuffer<touca::fbs::FileComparison>(nullptr);
+}
+
+inline bool VerifySizePrefixedFileComparisonBuffer(
+    flatbuffers::Verifier& verifier) {
+  return verifier.VerifySizePrefixedBuffer<touca::fbs::FileComparison>(nullptr);
+}
+
+inline void FinishFileComparisonBuffer(
+    flatbuffers::FlatBufferBuilder& fbb,
+    flatbuffers::Offset<touca::fbs::FileComparison> root) {
+  fbb.Finish(root);
+}
+
+inline void FinishSizePrefixedFileComparisonBuffer(
+    flatbuffers::FlatBufferBuilder& fbb,
+    flatbuffers::Offset<touca::fbs::FileComparison> root) {
+  fbb.FinishSizePrefixed(root);
+}
+
+}  // namespace fbs
+}  // namespace touca
@@ -43,6 +43,21 @@ struct ArrayBuilder;
 struct Blob;
 struct BlobBuilder;
 
+struct IntVector;
+struct IntVectorBuilder;
+
+struct UIntVector;
+struct UIntVectorBuilder;
+
+struct FloatVector;
+struct FloatVectorBuilder;
+
+struct DoubleVector;
+struct DoubleVectorBuilder;
+
+struct BoolVector;
+struct BoolVectorBuilder;
+
 struct Result;
 struct ResultBuilder;
 
@@ -70,9 +85,21 @@ struct MessageBuilder;
 struct MessageBuffer;
 struct MessageBufferBuilder;
 
+struct Dictionary;
+struct DictionaryBuilder;
+
 struct Messages;
 struct MessagesBuilder;
 
+struct Attachment;
+struct AttachmentBuilder;
+
+struct IndexEntry;
+struct IndexEntryBuilder;
+
+struct Footer;
+struct FooterBuilder;
+
 enum class Type : uint8_t {
   NONE = 0,
   Bool = 1,
@@ -84,8 +111,13 @@ enum class Type : uint8_t {
   Object = 7,
   Array = 8,
   Blob = 9,
+  IntVector = 10,
+  UIntVector = 11,
+  FloatVector = 12,
+  DoubleVector = 13,
+  BoolVector = 14,
   MIN = NONE,
-  MAX = Blob
+  MAX = BoolVector
 };
 
 bool VerifyType(flatbuffers::Verifier& verifier, const void* obj, Type type);
@@ -108,6 +140,14 @@ enum class ResultType : uint8_t {
   MAX = Assert
 };
 
+enum class Compression : uint8_t {
+  None = 0,
+  Zstd = 1,
+  Lz4 = 2,
+  MIN = None,
+  MAX = Lz4
+};
+
 struct ComparisonRuleDouble FLATBUFFERS_FINAL_CLASS
     : private flatbuffers::Table {
   typedef ComparisonRuleDoubleBuilder Builder;
@@ -479,7 +519,8 @@ struct ObjectMember FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef ObjectMemberBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_NAME = 4,
-    VT_VALUE = 6
+    VT_VALUE = 6,
+    VT_NAME_ID = 8
   };
   const flatbuffers::String* name() const {
     return GetPointer<const flatbuffers::String*>(VT_NAME);
@@ -487,10 +528,12 @@ struct ObjectMember FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const touca::fbs::TypeWrapper* value() const {
     return GetPointer<const touca::fbs::TypeWrapper*>(VT_VALUE);
   }
+  uint32_t name_id() const { return GetField<uint32_t>(VT_NAME_ID, 0); }
   bool Verify(flatbuffers::Verifier& verifier) const {
     return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_NAME) &&
            verifier.VerifyString(name()) && VerifyOffset(verifier, VT_VALUE) &&
-           verifier.VerifyTable(value()) && verifier.EndTable();
+           verifier.VerifyTable(value()) &&
+           VerifyField<uint32_t>(verifier, VT_NAME_ID) && verifier.EndTable();
   }
 };
 
@@ -504,6 +547,9 @@ struct ObjectMemberBuilder {
   void add_value(flatbuffers::Offset<touca::fbs::TypeWrapper> value) {
     fbb_.AddOffset(ObjectMember::VT_VALUE, value);
   }
+  void add_name_id(uint32_t name_id) {
+    fbb_.AddElement<uint32_t>(ObjectMember::VT_NAME_ID, name_id, 0);
+  }
   explicit ObjectMemberBuilder(flatbuffers::FlatBufferBuilder& _fbb)
       : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -518,8 +564,10 @@ struct ObjectMemberBuilder {
 inline flatbuffers::Offset<ObjectMember> CreateObjectMember(
     flatbuffers::FlatBufferBuilder& _fbb,
     flatbuffers::Offset<flatbuffers::String> name = 0,
-    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0) {
+    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0,
+    uint32_t name_id = 0) {
   ObjectMemberBuilder builder_(_fbb);
+  builder_.add_name_id(name_id);
   builder_.add_value(value);
   builder_.add_name(name);
   return builder_.Finish();
@@ -527,16 +575,18 @@ inline flatbuffers::Offset<ObjectMember> CreateObjectMember(
 
 inline flatbuffers::Offset<ObjectMember> CreateObjectMemberDirect(
     flatbuffers::FlatBufferBuilder& _fbb, const char* name = nullptr,
-    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0) {
+    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0,
+    uint32_t name_id = 0) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
-  return touca::fbs::CreateObjectMember(_fbb, name__, value);
+  return touca::fbs::CreateObjectMember(_fbb, name__, value, name_id);
 }
 
 struct Object FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef ObjectBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_KEY = 4,
-    VT_VALUES = 6
+    VT_VALUES = 6,
+    VT_KEY_ID = 8
   };
   const flatbuffers::String* key() const {
     return GetPointer<const flatbuffers::String*>(VT_KEY);
@@ -546,11 +596,13 @@ struct Object FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     return GetPointer<const flatbuffers::Vector<
         flatbuffers::Offset<touca::fbs::ObjectMember>>*>(VT_VALUES);
   }
+  uint32_t key_id() const { return GetField<uint32_t>(VT_KEY_ID, 0); }
   bool Verify(flatbuffers::Verifier& verifier) const {
     return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_KEY) &&
            verifier.VerifyString(key()) && VerifyOffset(verifier, VT_VALUES) &&
            verifier.VerifyVector(values()) &&
-           verifier.VerifyVectorOfTables(values()) && verifier.EndTable();
+           verifier.VerifyVectorOfTables(values()) &&
+           VerifyField<uint32_t>(verifier, VT_KEY_ID) && verifier.EndTable();
   }
 };
 
@@ -567,6 +619,9 @@ struct ObjectBuilder {
           values) {
     fbb_.AddOffset(Object::VT_VALUES, values);
   }
+  void add_key_id(uint32_t key_id) {
+    fbb_.AddElement<uint32_t>(Object::VT_KEY_ID, key_id, 0);
+  }
   explicit ObjectBuilder(flatbuffers::FlatBufferBuilder& _fbb) : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
@@ -582,8 +637,10 @@ inline flatbuffers::Offset<Object> CreateObject(
     flatbuffers::Offset<flatbuffers::String> key = 0,
     flatbuffers::Offset<
         flatbuffers::Vector<flatbuffers::Offset<touca::fbs::ObjectMember>>>
-        values = 0) {
+        values = 0,
+    uint32_t key_id = 0) {
   ObjectBuilder builder_(_fbb);
+  builder_.add_key_id(key_id);
   builder_.add_values(values);
   builder_.add_key(key);
   return builder_.Finish();
@@ -592,13 +649,14 @@ inline flatbuffers::Offset<Object> CreateObject(
 inline flatbuffers::Offset<Object> CreateObjectDirect(
     flatbuffers::FlatBufferBuilder& _fbb, const char* key = nullptr,
     const std::vector<flatbuffers::Offset<touca::fbs::ObjectMember>>* values =
-        nullptr) {
+        nullptr,
+    uint32_t key_id = 0) {
   auto key__ = key ? _fbb.CreateString(key) : 0;
   auto values__ =
       values ? _fbb.CreateVector<flatbuffers::Offset<touca::fbs::ObjectMember>>(
                    *values)
              : 0;
-  return touca::fbs::CreateObject(_fbb, key__, values__);
+  return touca::fbs::CreateObject(_fbb, key__, values__, key_id);
 }
 
 struct Array FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -729,12 +787,248 @@ inline flatbuffers::Offset<Blob> CreateBlobDirect(
   return touca::fbs::CreateBlob(_fbb, digest__, mimetype__, reference__);
 }
 
+struct IntVector FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef IntVectorBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUES = 4
+  };
+  const flatbuffers::Vector<int64_t>* values() const {
+    return GetPointer<const flatbuffers::Vector<int64_t>*>(VT_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) && verifier.EndTable();
+  }
+};
+
+struct IntVectorBuilder {
+  typedef IntVector Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_values(flatbuffers::Offset<flatbuffers::Vector<int64_t>> values) {
+    fbb_.AddOffset(IntVector::VT_VALUES, values);
+  }
+  explicit IntVectorBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<IntVector> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<IntVector>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<IntVector> CreateIntVector(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::Vector<int64_t>> values = 0) {
+  IntVectorBuilder builder_(_fbb);
+  builder_.add_values(values);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<IntVector> CreateIntVectorDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<int64_t>* values = nullptr) {
+  auto values__ = values ? _fbb.CreateVector<int64_t>(*values) : 0;
+  return touca::fbs::CreateIntVector(_fbb, values__);
+}
+
+struct UIntVector FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef UIntVectorBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUES = 4
+  };
+  const flatbuffers::Vector<uint64_t>* values() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t>*>(VT_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) && verifier.EndTable();
+  }
+};
+
+struct UIntVectorBuilder {
+  typedef UIntVector Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_values(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> values) {
+    fbb_.AddOffset(UIntVector::VT_VALUES, values);
+  }
+  explicit UIntVectorBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<UIntVector> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<UIntVector>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<UIntVector> CreateUIntVector(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> values = 0) {
+  UIntVectorBuilder builder_(_fbb);
+  builder_.add_values(values);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<UIntVector> CreateUIntVectorDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<uint64_t>* values = nullptr) {
+  auto values__ = values ? _fbb.CreateVector<uint64_t>(*values) : 0;
+  return touca::fbs::CreateUIntVector(_fbb, values__);
+}
+
+struct FloatVector FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef FloatVectorBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUES = 4
+  };
+  const flatbuffers::Vector<float>* values() const {
+    return GetPointer<const flatbuffers::Vector<float>*>(VT_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) && verifier.EndTable();
+  }
+};
+
+struct FloatVectorBuilder {
+  typedef FloatVector Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_values(flatbuffers::Offset<flatbuffers::Vector<float>> values) {
+    fbb_.AddOffset(FloatVector::VT_VALUES, values);
+  }
+  explicit FloatVectorBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<FloatVector> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<FloatVector>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<FloatVector> CreateFloatVector(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::Vector<float>> values = 0) {
+  FloatVectorBuilder builder_(_fbb);
+  builder_.add_values(values);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<FloatVector> CreateFloatVectorDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<float>* values = nullptr) {
+  auto values__ = values ? _fbb.CreateVector<float>(*values) : 0;
+  return touca::fbs::CreateFloatVector(_fbb, values__);
+}
+
+struct DoubleVector FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef DoubleVectorBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUES = 4
+  };
+  const flatbuffers::Vector<double>* values() const {
+    return GetPointer<const flatbuffers::Vector<double>*>(VT_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) && verifier.EndTable();
+  }
+};
+
+struct DoubleVectorBuilder {
+  typedef DoubleVector Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_values(flatbuffers::Offset<flatbuffers::Vector<double>> values) {
+    fbb_.AddOffset(DoubleVector::VT_VALUES, values);
+  }
+  explicit DoubleVectorBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<DoubleVector> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<DoubleVector>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<DoubleVector> CreateDoubleVector(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::Vector<double>> values = 0) {
+  DoubleVectorBuilder builder_(_fbb);
+  builder_.add_values(values);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<DoubleVector> CreateDoubleVectorDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<double>* values = nullptr) {
+  auto values__ = values ? _fbb.CreateVector<double>(*values) : 0;
+  return touca::fbs::CreateDoubleVector(_fbb, values__);
+}
+
+struct BoolVector FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef BoolVectorBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUES = 4
+  };
+  const flatbuffers::Vector<uint8_t>* values() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t>*>(VT_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) && verifier.EndTable();
+  }
+};
+
+struct BoolVectorBuilder {
+  typedef BoolVector Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_values(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> values) {
+    fbb_.AddOffset(BoolVector::VT_VALUES, values);
+  }
+  explicit BoolVectorBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<BoolVector> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<BoolVector>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<BoolVector> CreateBoolVector(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> values = 0) {
+  BoolVectorBuilder builder_(_fbb);
+  builder_.add_values(values);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<BoolVector> CreateBoolVectorDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<uint8_t>* values = nullptr) {
+  auto values__ = values ? _fbb.CreateVector<uint8_t>(*values) : 0;
+  return touca::fbs::CreateBoolVector(_fbb, values__);
+}
+
 struct Result FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef ResultBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_KEY = 4,
     VT_VALUE = 6,
-    VT_TYP = 8
+    VT_TYP = 8,
+    VT_KEY_ID = 10
   };
   const flatbuffers::String* key() const {
     return GetPointer<const flatbuffers::String*>(VT_KEY);
@@ -745,11 +1039,13 @@ struct Result FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   touca::fbs::ResultType typ() const {
     return static_cast<touca::fbs::ResultType>(GetField<uint8_t>(VT_TYP, 1));
   }
+  uint32_t key_id() const { return GetField<uint32_t>(VT_KEY_ID, 0); }
   bool Verify(flatbuffers::Verifier& verifier) const {
     return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_KEY) &&
            verifier.VerifyString(key()) && VerifyOffset(verifier, VT_VALUE) &&
            verifier.VerifyTable(value()) &&
-           VerifyField<uint8_t>(verifier, VT_TYP) && verifier.EndTable();
+           VerifyField<uint8_t>(verifier, VT_TYP) &&
+           VerifyField<uint32_t>(verifier, VT_KEY_ID) && verifier.EndTable();
   }
 };
 
@@ -766,6 +1062,9 @@ struct ResultBuilder {
   void add_typ(touca::fbs::ResultType typ) {
     fbb_.AddElement<uint8_t>(Result::VT_TYP, static_cast<uint8_t>(typ), 1);
   }
+  void add_key_id(uint32_t key_id) {
+    fbb_.AddElement<uint32_t>(Result::VT_KEY_ID, key_id, 0);
+  }
   explicit ResultBuilder(flatbuffers::FlatBufferBuilder& _fbb) : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
@@ -780,8 +1079,10 @@ inline flatbuffers::Offset<Result> CreateResult(
     flatbuffers::FlatBufferBuilder& _fbb,
     flatbuffers::Offset<flatbuffers::String> key = 0,
     flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0,
-    touca::fbs::ResultType typ = touca::fbs::ResultType::Check) {
+    touca::fbs::ResultType typ = touca::fbs::ResultType::Check,
+    uint32_t key_id = 0) {
   ResultBuilder builder_(_fbb);
+  builder_.add_key_id(key_id);
   builder_.add_value(value);
   builder_.add_key(key);
   builder_.add_typ(typ);
@@ -791,9 +1092,10 @@ inline flatbuffers::Offset<Result> CreateResult(
 inline flatbuffers::Offset<Result> CreateResultDirect(
     flatbuffers::FlatBufferBuilder& _fbb, const char* key = nullptr,
     flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0,
-    touca::fbs::ResultType typ = touca::fbs::ResultType::Check) {
+    touca::fbs::ResultType typ = touca::fbs::ResultType::Check,
+    uint32_t key_id = 0) {
   auto key__ = key ? _fbb.CreateString(key) : 0;
-  return touca::fbs::CreateResult(_fbb, key__, value, typ);
+  return touca::fbs::CreateResult(_fbb, key__, value, typ, key_id);
 }
 
 struct Assertion FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -810,7 +1112,8 @@ struct Metric FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef MetricBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_KEY = 4,
-    VT_VALUE = 6
+    VT_VALUE = 6,
+    VT_KEY_ID = 8
   };
   const flatbuffers::String* key() const {
     return GetPointer<const flatbuffers::String*>(VT_KEY);
@@ -818,10 +1121,12 @@ struct Metric FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const touca::fbs::TypeWrapper* value() const {
     return GetPointer<const touca::fbs::TypeWrapper*>(VT_VALUE);
   }
+  uint32_t key_id() const { return GetField<uint32_t>(VT_KEY_ID, 0); }
   bool Verify(flatbuffers::Verifier& verifier) const {
     return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_KEY) &&
            verifier.VerifyString(key()) && VerifyOffset(verifier, VT_VALUE) &&
-           verifier.VerifyTable(value()) && verifier.EndTable();
+           verifier.VerifyTable(value()) &&
+           VerifyField<uint32_t>(verifier, VT_KEY_ID) && verifier.EndTable();
   }
 };
 
@@ -835,6 +1140,9 @@ struct MetricBuilder {
   void add_value(flatbuffers::Offset<touca::fbs::TypeWrapper> value) {
     fbb_.AddOffset(Metric::VT_VALUE, value);
   }
+  void add_key_id(uint32_t key_id) {
+    fbb_.AddElement<uint32_t>(Metric::VT_KEY_ID, key_id, 0);
+  }
   explicit MetricBuilder(flatbuffers::FlatBufferBuilder& _fbb) : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
@@ -848,8 +1156,10 @@ struct MetricBuilder {
 inline flatbuffers::Offset<Metric> CreateMetric(
     flatbuffers::FlatBufferBuilder& _fbb,
     flatbuffers::Offset<flatbuffers::String> key = 0,
-    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0) {
+    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0,
+    uint32_t key_id = 0) {
   MetricBuilder builder_(_fbb);
+  builder_.add_key_id(key_id);
   builder_.add_value(value);
   builder_.add_key(key);
   return builder_.Finish();
@@ -857,9 +1167,10 @@ inline flatbuffers::Offset<Metric> CreateMetric(
 
 inline flatbuffers::Offset<Metric> CreateMetricDirect(
     flatbuffers::FlatBufferBuilder& _fbb, const char* key = nullptr,
-    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0) {
+    flatbuffers::Offset<touca::fbs::TypeWrapper> value = 0,
+    uint32_t key_id = 0) {
   auto key__ = key ? _fbb.CreateString(key) : 0;
-  return touca::fbs::CreateMetric(_fbb, key__, value);
+  return touca::fbs::CreateMetric(_fbb, key__, value, key_id);
 }
 
 struct Results FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -995,7 +1306,10 @@ struct Metadata FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_VERSION = 6,
     VT_TESTCASE = 10,
     VT_BUILTAT = 12,
-    VT_TEAMSLUG = 14
+    VT_TEAMSLUG = 14,
+    VT_TESTSUITE_ID = 16,
+    VT_VERSION_ID = 18,
+    VT_TEAMSLUG_ID = 20
   };
   const flatbuffers::String* testsuite() const {
     return GetPointer<const flatbuffers::String*>(VT_TESTSUITE);
@@ -1012,6 +1326,13 @@ struct Metadata FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::String* teamslug() const {
     return GetPointer<const flatbuffers::String*>(VT_TEAMSLUG);
   }
+  uint32_t testsuite_id() const {
+    return GetField<uint32_t>(VT_TESTSUITE_ID, 0);
+  }
+  uint32_t version_id() const { return GetField<uint32_t>(VT_VERSION_ID, 0); }
+  uint32_t teamslug_id() const {
+    return GetField<uint32_t>(VT_TEAMSLUG_ID, 0);
+  }
   bool Verify(flatbuffers::Verifier& verifier) const {
     return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_TESTSUITE) &&
            verifier.VerifyString(testsuite()) &&
@@ -1022,7 +1343,11 @@ struct Metadata FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_BUILTAT) &&
            verifier.VerifyString(builtAt()) &&
            VerifyOffset(verifier, VT_TEAMSLUG) &&
-           verifier.VerifyString(teamslug()) && verifier.EndTable();
+           verifier.VerifyString(teamslug()) &&
+           VerifyField<uint32_t>(verifier, VT_TESTSUITE_ID) &&
+           VerifyField<uint32_t>(verifier, VT_VERSION_ID) &&
+           VerifyField<uint32_t>(verifier, VT_TEAMSLUG_ID) &&
+           verifier.EndTable();
   }
 };
 
@@ -1045,6 +1370,15 @@ struct MetadataBuilder {
   void add_teamslug(flatbuffers::Offset<flatbuffers::String> teamslug) {
     fbb_.AddOffset(Metadata::VT_TEAMSLUG, teamslug);
   }
+  void add_testsuite_id(uint32_t testsuite_id) {
+    fbb_.AddElement<uint32_t>(Metadata::VT_TESTSUITE_ID, testsuite_id, 0);
+  }
+  void add_version_id(uint32_t version_id) {
+    fbb_.AddElement<uint32_t>(Metadata::VT_VERSION_ID, version_id, 0);
+  }
+  void add_teamslug_id(uint32_t teamslug_id) {
+    fbb_.AddElement<uint32_t>(Metadata::VT_TEAMSLUG_ID, teamslug_id, 0);
+  }
   explicit MetadataBuilder(flatbuffers::FlatBufferBuilder& _fbb) : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
@@ -1061,8 +1395,13 @@ inline flatbuffers::Offset<Metadata> CreateMetadata(
     flatbuffers::Offset<flatbuffers::String> version = 0,
     flatbuffers::Offset<flatbuffers::String> testcase = 0,
     flatbuffers::Offset<flatbuffers::String> builtAt = 0,
-    flatbuffers::Offset<flatbuffers::String> teamslug = 0) {
+    flatbuffers::Offset<flatbuffers::String> teamslug = 0,
+    uint32_t testsuite_id = 0, uint32_t version_id = 0,
+    uint32_t teamslug_id = 0) {
   MetadataBuilder builder_(_fbb);
+  builder_.add_teamslug_id(teamslug_id);
+  builder_.add_version_id(version_id);
+  builder_.add_testsuite_id(testsuite_id);
   builder_.add_teamslug(teamslug);
   builder_.add_builtAt(builtAt);
   builder_.add_testcase(testcase);
@@ -1074,14 +1413,17 @@ inline flatbuffers::Offset<Metadata> CreateMetadata(
 inline flatbuffers::Offset<Metadata> CreateMetadataDirect(
     flatbuffers::FlatBufferBuilder& _fbb, const char* testsuite = nullptr,
     const char* version = nullptr, const char* testcase = nullptr,
-    const char* builtAt = nullptr, const char* teamslug = nullptr) {
+    const char* builtAt = nullptr, const char* teamslug = nullptr,
+    uint32_t testsuite_id = 0, uint32_t version_id = 0,
+    uint32_t teamslug_id = 0) {
   auto testsuite__ = testsuite ? _fbb.CreateString(testsuite) : 0;
   auto version__ = version ? _fbb.CreateString(version) : 0;
   auto testcase__ = testcase ? _fbb.CreateString(testcase) : 0;
   auto builtAt__ = builtAt ? _fbb.CreateString(builtAt) : 0;
   auto teamslug__ = teamslug ? _fbb.CreateString(teamslug) : 0;
   return touca::fbs::CreateMetadata(_fbb, testsuite__, version__, testcase__,
-                                    builtAt__, teamslug__);
+                                    builtAt__, teamslug__, testsuite_id,
+                                    version_id, teamslug_id);
 }
 
 struct Message FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -1148,7 +1490,10 @@ inline flatbuffers::Offset<Message> CreateMessage(
 struct MessageBuffer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef MessageBufferBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_BUF = 4
+    VT_BUF = 4,
+    VT_FRAME = 6,
+    VT_COMPRESSION = 8,
+    VT_RAW_SIZE = 10
   };
   const flatbuffers::Vector<uint8_t>* buf() const {
     return GetPointer<const flatbuffers::Vector<uint8_t>*>(VT_BUF);
@@ -1156,9 +1501,20 @@ struct MessageBuffer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const touca::fbs::Message* buf_nested_root() const {
     return flatbuffers::GetRoot<touca::fbs::Message>(buf()->Data());
   }
+  const flatbuffers::Vector<uint8_t>* frame() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t>*>(VT_FRAME);
+  }
+  touca::fbs::Compression compression() const {
+    return static_cast<touca::fbs::Compression>(
+        GetField<uint8_t>(VT_COMPRESSION, 0));
+  }
+  uint64_t raw_size() const { return GetField<uint64_t>(VT_RAW_SIZE, 0); }
   bool Verify(flatbuffers::Verifier& verifier) const {
     return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_BUF) &&
-           verifier.VerifyVector(buf()) && verifier.EndTable();
+           verifier.VerifyVector(buf()) && VerifyOffset(verifier, VT_FRAME) &&
+           verifier.VerifyVector(frame()) &&
+           VerifyField<uint8_t>(verifier, VT_COMPRESSION) &&
+           VerifyField<uint64_t>(verifier, VT_RAW_SIZE) && verifier.EndTable();
   }
 };
 
@@ -1169,6 +1525,16 @@ struct MessageBufferBuilder {
   void add_buf(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> buf) {
     fbb_.AddOffset(MessageBuffer::VT_BUF, buf);
   }
+  void add_frame(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> frame) {
+    fbb_.AddOffset(MessageBuffer::VT_FRAME, frame);
+  }
+  void add_compression(touca::fbs::Compression compression) {
+    fbb_.AddElement<uint8_t>(MessageBuffer::VT_COMPRESSION,
+                             static_cast<uint8_t>(compression), 0);
+  }
+  void add_raw_size(uint64_t raw_size) {
+    fbb_.AddElement<uint64_t>(MessageBuffer::VT_RAW_SIZE, raw_size, 0);
+  }
   explicit MessageBufferBuilder(flatbuffers::FlatBufferBuilder& _fbb)
       : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1182,33 +1548,113 @@ struct MessageBufferBuilder {
 
 inline flatbuffers::Offset<MessageBuffer> CreateMessageBuffer(
     flatbuffers::FlatBufferBuilder& _fbb,
-    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> buf = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> buf = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> frame = 0,
+    touca::fbs::Compression compression = touca::fbs::Compression::None,
+    uint64_t raw_size = 0) {
   MessageBufferBuilder builder_(_fbb);
+  builder_.add_raw_size(raw_size);
+  builder_.add_frame(frame);
   builder_.add_buf(buf);
+  builder_.add_compression(compression);
   return builder_.Finish();
 }
 
 inline flatbuffers::Offset<MessageBuffer> CreateMessageBufferDirect(
     flatbuffers::FlatBufferBuilder& _fbb,
-    const std::vector<uint8_t>* buf = nullptr) {
+    const std::vector<uint8_t>* buf = nullptr,
+    const std::vector<uint8_t>* frame = nullptr,
+    touca::fbs::Compression compression = touca::fbs::Compression::None,
+    uint64_t raw_size = 0) {
   auto buf__ = buf ? _fbb.CreateVector<uint8_t>(*buf) : 0;
-  return touca::fbs::CreateMessageBuffer(_fbb, buf__);
+  auto frame__ = frame ? _fbb.CreateVector<uint8_t>(*frame) : 0;
+  return touca::fbs::CreateMessageBuffer(_fbb, buf__, frame__, compression,
+                                         raw_size);
+}
+
+struct Dictionary FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef DictionaryBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_VALUES = 4
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>* values()
+      const {
+    return GetPointer<
+        const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>*>(
+        VT_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) &&
+           verifier.VerifyVectorOfStrings(values()) && verifier.EndTable();
+  }
+};
+
+struct DictionaryBuilder {
+  typedef Dictionary Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_values(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>
+          values) {
+    fbb_.AddOffset(Dictionary::VT_VALUES, values);
+  }
+  explicit DictionaryBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<Dictionary> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Dictionary>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Dictionary> CreateDictionary(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>
+        values = 0) {
+  DictionaryBuilder builder_(_fbb);
+  builder_.add_values(values);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Dictionary> CreateDictionaryDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>>* values =
+        nullptr) {
+  auto values__ =
+      values ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(
+                   *values)
+             : 0;
+  return touca::fbs::CreateDictionary(_fbb, values__);
 }
 
 struct Messages FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef MessagesBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_MESSAGES = 4
+    VT_MESSAGES = 4,
+    VT_DICTIONARY = 6
   };
   const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::MessageBuffer>>*
   messages() const {
     return GetPointer<const flatbuffers::Vector<
         flatbuffers::Offset<touca::fbs::MessageBuffer>>*>(VT_MESSAGES);
   }
+  const flatbuffers::Vector<uint8_t>* dictionary() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t>*>(VT_DICTIONARY);
+  }
+  const touca::fbs::Dictionary* dictionary_nested_root() const {
+    return flatbuffers::GetRoot<touca::fbs::Dictionary>(dictionary()->Data());
+  }
   bool Verify(flatbuffers::Verifier& verifier) const {
     return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_MESSAGES) &&
            verifier.VerifyVector(messages()) &&
-           verifier.VerifyVectorOfTables(messages()) && verifier.EndTable();
+           verifier.VerifyVectorOfTables(messages()) &&
+           VerifyOffset(verifier, VT_DICTIONARY) &&
+           verifier.VerifyVector(dictionary()) && verifier.EndTable();
   }
 };
 
@@ -1222,6 +1668,10 @@ struct MessagesBuilder {
           messages) {
     fbb_.AddOffset(Messages::VT_MESSAGES, messages);
   }
+  void add_dictionary(
+      flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dictionary) {
+    fbb_.AddOffset(Messages::VT_DICTIONARY, dictionary);
+  }
   explicit MessagesBuilder(flatbuffers::FlatBufferBuilder& _fbb) : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
@@ -1236,8 +1686,10 @@ inline flatbuffers::Offset<Messages> CreateMessages(
     flatbuffers::FlatBufferBuilder& _fbb,
     flatbuffers::Offset<
         flatbuffers::Vector<flatbuffers::Offset<touca::fbs::MessageBuffer>>>
-        messages = 0) {
+        messages = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> dictionary = 0) {
   MessagesBuilder builder_(_fbb);
+  builder_.add_dictionary(dictionary);
   builder_.add_messages(messages);
   return builder_.Finish();
 }
@@ -1245,13 +1697,298 @@ inline flatbuffers::Offset<Messages> CreateMessages(
 inline flatbuffers::Offset<Messages> CreateMessagesDirect(
     flatbuffers::FlatBufferBuilder& _fbb,
     const std::vector<flatbuffers::Offset<touca::fbs::MessageBuffer>>*
-        messages = nullptr) {
+        messages = nullptr,
+    const std::vector<uint8_t>* dictionary = nullptr) {
   auto messages__ =
       messages
           ? _fbb.CreateVector<flatbuffers::Offset<touca::fbs::MessageBuffer>>(
                 *messages)
           : 0;
-  return touca::fbs::CreateMessages(_fbb, messages__);
+  auto dictionary__ = dictionary ? _fbb.CreateVector<uint8_t>(*dictionary) : 0;
+  return touca::fbs::CreateMessages(_fbb, messages__, dictionary__);
+}
+
+struct Attachment FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef AttachmentBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_TESTCASE = 4,
+    VT_NAME = 6,
+    VT_CONTENT = 8
+  };
+  const flatbuffers::String* testcase() const {
+    return GetPointer<const flatbuffers::String*>(VT_TESTCASE);
+  }
+  const flatbuffers::String* name() const {
+    return GetPointer<const flatbuffers::String*>(VT_NAME);
+  }
+  const flatbuffers::Vector<uint8_t>* content() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t>*>(VT_CONTENT);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_TESTCASE) &&
+           verifier.VerifyString(testcase()) &&
+           VerifyOffset(verifier, VT_NAME) && verifier.VerifyString(name()) &&
+           VerifyOffset(verifier, VT_CONTENT) &&
+           verifier.VerifyVector(content()) && verifier.EndTable();
+  }
+};
+
+struct AttachmentBuilder {
+  typedef Attachment Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_testcase(flatbuffers::Offset<flatbuffers::String> testcase) {
+    fbb_.AddOffset(Attachment::VT_TESTCASE, testcase);
+  }
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(Attachment::VT_NAME, name);
+  }
+  void add_content(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> content) {
+    fbb_.AddOffset(Attachment::VT_CONTENT, content);
+  }
+  explicit AttachmentBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<Attachment> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Attachment>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Attachment> CreateAttachment(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::String> testcase = 0,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> content = 0) {
+  AttachmentBuilder builder_(_fbb);
+  builder_.add_content(content);
+  builder_.add_name(name);
+  builder_.add_testcase(testcase);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Attachment> CreateAttachmentDirect(
+    flatbuffers::FlatBufferBuilder& _fbb, const char* testcase = nullptr,
+    const char* name = nullptr, const std::vector<uint8_t>* content = nullptr) {
+  auto testcase__ = testcase ? _fbb.CreateString(testcase) : 0;
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  auto content__ = content ? _fbb.CreateVector<uint8_t>(*content) : 0;
+  return touca::fbs::CreateAttachment(_fbb, testcase__, name__, content__);
+}
+
+struct IndexEntry FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef IndexEntryBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_TESTCASE = 4,
+    VT_OFFSET = 6,
+    VT_SIZE = 8,
+    VT_DIGEST = 10,
+    VT_COMPRESSION = 12,
+    VT_RAW_SIZE = 14,
+    VT_NAME = 16
+  };
+  const flatbuffers::String* testcase() const {
+    return GetPointer<const flatbuffers::String*>(VT_TESTCASE);
+  }
+  uint64_t offset() const { return GetField<uint64_t>(VT_OFFSET, 0); }
+  uint64_t size() const { return GetField<uint64_t>(VT_SIZE, 0); }
+  uint64_t digest() const { return GetField<uint64_t>(VT_DIGEST, 0); }
+  touca::fbs::Compression compression() const {
+    return static_cast<touca::fbs::Compression>(
+        GetField<uint8_t>(VT_COMPRESSION, 0));
+  }
+  uint64_t raw_size() const { return GetField<uint64_t>(VT_RAW_SIZE, 0); }
+  const flatbuffers::String* name() const {
+    return GetPointer<const flatbuffers::String*>(VT_NAME);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_TESTCASE) &&
+           verifier.VerifyString(testcase()) &&
+           VerifyField<uint64_t>(verifier, VT_OFFSET) &&
+           VerifyField<uint64_t>(verifier, VT_SIZE) &&
+           VerifyField<uint64_t>(verifier, VT_DIGEST) &&
+           VerifyField<uint8_t>(verifier, VT_COMPRESSION) &&
+           VerifyField<uint64_t>(verifier, VT_RAW_SIZE) &&
+           VerifyOffset(verifier, VT_NAME) && verifier.VerifyString(name()) &&
+           verifier.EndTable();
+  }
+};
+
+struct IndexEntryBuilder {
+  typedef IndexEntry Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_testcase(flatbuffers::Offset<flatbuffers::String> testcase) {
+    fbb_.AddOffset(IndexEntry::VT_TESTCASE, testcase);
+  }
+  void add_offset(uint64_t offset) {
+    fbb_.AddElement<uint64_t>(IndexEntry::VT_OFFSET, offset, 0);
+  }
+  void add_size(uint64_t size) {
+    fbb_.AddElement<uint64_t>(IndexEntry::VT_SIZE, size, 0);
+  }
+  void add_digest(uint64_t digest) {
+    fbb_.AddElement<uint64_t>(IndexEntry::VT_DIGEST, digest, 0);
+  }
+  void add_compression(touca::fbs::Compression compression) {
+    fbb_.AddElement<uint8_t>(IndexEntry::VT_COMPRESSION,
+                             static_cast<uint8_t>(compression), 0);
+  }
+  void add_raw_size(uint64_t raw_size) {
+    fbb_.AddElement<uint64_t>(IndexEntry::VT_RAW_SIZE, raw_size, 0);
+  }
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(IndexEntry::VT_NAME, name);
+  }
+  explicit IndexEntryBuilder(flatbuffers::FlatBufferBuilder& _fbb)
+      : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<IndexEntry> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<IndexEntry>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<IndexEntry> CreateIndexEntry(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<flatbuffers::String> testcase = 0, uint64_t offset = 0,
+    uint64_t size = 0, uint64_t digest = 0,
+    touca::fbs::Compression compression = touca::fbs::Compression::None,
+    uint64_t raw_size = 0, flatbuffers::Offset<flatbuffers::String> name = 0) {
+  IndexEntryBuilder builder_(_fbb);
+  builder_.add_raw_size(raw_size);
+  builder_.add_digest(digest);
+  builder_.add_size(size);
+  builder_.add_offset(offset);
+  builder_.add_name(name);
+  builder_.add_testcase(testcase);
+  builder_.add_compression(compression);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<IndexEntry> CreateIndexEntryDirect(
+    flatbuffers::FlatBufferBuilder& _fbb, const char* testcase = nullptr,
+    uint64_t offset = 0, uint64_t size = 0, uint64_t digest = 0,
+    touca::fbs::Compression compression = touca::fbs::Compression::None,
+    uint64_t raw_size = 0, const char* name = nullptr) {
+  auto testcase__ = testcase ? _fbb.CreateString(testcase) : 0;
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  return touca::fbs::CreateIndexEntry(_fbb, testcase__, offset, size, digest,
+                                      compression, raw_size, name__);
+}
+
+struct Footer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef FooterBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ENTRIES = 4,
+    VT_DICTIONARY = 6,
+    VT_CHECKSUM = 8,
+    VT_ATTACHMENTS = 10
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::IndexEntry>>*
+  entries() const {
+    return GetPointer<const flatbuffers::Vector<
+        flatbuffers::Offset<touca::fbs::IndexEntry>>*>(VT_ENTRIES);
+  }
+  const touca::fbs::IndexEntry* dictionary() const {
+    return GetPointer<const touca::fbs::IndexEntry*>(VT_DICTIONARY);
+  }
+  flatbuffers::Optional<uint64_t> checksum() const {
+    return GetOptional<uint64_t, uint64_t>(VT_CHECKSUM);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<touca::fbs::IndexEntry>>*
+  attachments() const {
+    return GetPointer<const flatbuffers::Vector<
+        flatbuffers::Offset<touca::fbs::IndexEntry>>*>(VT_ATTACHMENTS);
+  }
+  bool Verify(flatbuffers::Verifier& verifier) const {
+    return VerifyTableStart(verifier) && VerifyOffset(verifier, VT_ENTRIES) &&
+           verifier.VerifyVector(entries()) &&
+           verifier.VerifyVectorOfTables(entries()) &&
+           VerifyOffset(verifier, VT_DICTIONARY) &&
+           verifier.VerifyTable(dictionary()) &&
+           VerifyField<uint64_t>(verifier, VT_CHECKSUM) &&
+           VerifyOffset(verifier, VT_ATTACHMENTS) &&
+           verifier.VerifyVector(attachments()) &&
+           verifier.VerifyVectorOfTables(attachments()) && verifier.EndTable();
+  }
+};
+
+struct FooterBuilder {
+  typedef Footer Table;
+  flatbuffers::FlatBufferBuilder& fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_entries(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::IndexEntry>>>
+          entries) {
+    fbb_.AddOffset(Footer::VT_ENTRIES, entries);
+  }
+  void add_dictionary(flatbuffers::Offset<touca::fbs::IndexEntry> dictionary) {
+    fbb_.AddOffset(Footer::VT_DICTIONARY, dictionary);
+  }
+  void add_checksum(uint64_t checksum) {
+    fbb_.AddElement<uint64_t>(Footer::VT_CHECKSUM, checksum);
+  }
+  void add_attachments(
+      flatbuffers::Offset<
+          flatbuffers::Vector<flatbuffers::Offset<touca::fbs::IndexEntry>>>
+          attachments) {
+    fbb_.AddOffset(Footer::VT_ATTACHMENTS, attachments);
+  }
+  explicit FooterBuilder(flatbuffers::FlatBufferBuilder& _fbb) : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<Footer> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Footer>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Footer> CreateFooter(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::IndexEntry>>>
+        entries = 0,
+    flatbuffers::Offset<touca::fbs::IndexEntry> dictionary = 0,
+    flatbuffers::Optional<uint64_t> checksum = flatbuffers::nullopt,
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<touca::fbs::IndexEntry>>>
+        attachments = 0) {
+  FooterBuilder builder_(_fbb);
+  if (checksum) {
+    builder_.add_checksum(*checksum);
+  }
+  builder_.add_attachments(attachments);
+  builder_.add_dictionary(dictionary);
+  builder_.add_entries(entries);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Footer> CreateFooterDirect(
+    flatbuffers::FlatBufferBuilder& _fbb,
+    const std::vector<flatbuffers::Offset<touca::fbs::IndexEntry>>* entries =
+        nullptr,
+    flatbuffers::Offset<touca::fbs::IndexEntry> dictionary = 0,
+    flatbuffers::Optional<uint64_t> checksum = flatbuffers::nullopt,
+    const std::vector<flatbuffers::Offset<touca::fbs::IndexEntry>>*
+        attachments = nullptr) {
+  auto entries__ =
+      entries ? _fbb.CreateVector<flatbuffers::Offset<touca::fbs::IndexEntry>>(
+                    *entries)
+              : 0;
+  auto attachments__ =
+      attachments
+          ? _fbb.CreateVector<flatbuffers::Offset<touca::fbs::IndexEntry>>(
+                *attachments)
+          : 0;
+  return touca::fbs::CreateFooter(_fbb, entries__, dictionary, checksum,
+                                  attachments__);
 }
 
 inline bool VerifyType(flatbuffers::Verifier& verifier, const void* obj,
@@ -1296,6 +2033,26 @@ inline bool VerifyType(flatbuffers::Verifier& verifier, const void* obj,
       auto ptr = reinterpret_cast<const touca::fbs::Blob*>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case Type::IntVector: {
+      auto ptr = reinterpret_cast<const touca::fbs::IntVector*>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Type::UIntVector: {
+      auto ptr = reinterpret_cast<const touca::fbs::UIntVector*>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Type::FloatVector: {
+      auto ptr = reinterpret_cast<const touca::fbs::FloatVector*>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Type::DoubleVector: {
+      auto ptr = reinterpret_cast<const touca::fbs::DoubleVector*>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Type::BoolVector: {
+      auto ptr = reinterpret_cast<const touca::fbs::BoolVector*>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default:
       return true;
   }
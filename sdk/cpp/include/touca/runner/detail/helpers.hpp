@@ -6,6 +6,7 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -13,6 +14,8 @@
 #include <vector>
 
 #include "fmt/color.h"
+#include "touca/core/background_writer.hpp"
+#include "touca/core/result_file.hpp"
 #include "touca/lib_api.hpp"
 #include "touca/runner/runner.hpp"
 
@@ -44,6 +47,7 @@ struct TOUCA_CLIENT_API OutputCapturer {
 
 struct Statistics {
   void inc(Status value);
+  void dec(Status value);
   unsigned long count(Status value) const;
 
  private:
@@ -121,8 +125,13 @@ struct Printer {
 };
 
 struct Runner {
-  Runner(const RunnerOptions& opts) : options(opts) {}
-  void run_workflows();
+  Runner(const RunnerOptions& opts)
+      : options(opts),
+        writer(64u << 20, parse_sync_policy(opts.sync_policy)) {}
+  /**
+   * @return whether results of all testcases that were run were saved
+   */
+  bool run_workflows();
 
  private:
   void run_workflow(const Workflow& workflow);
@@ -134,6 +143,13 @@ struct Runner {
   Printer printer;
   Statistics stats;
   const RunnerOptions& options;
+  std::shared_ptr<ResultFileWriter> archive;
+  std::set<std::string> archived;
+  // testcases counted as submitted whose results are not yet known to be
+  // saved, since they are written on a background thread
+  std::vector<std::string> unsaved;
+  bool failed = false;
+  BackgroundWriter writer;
 };
 
 void TOUCA_CLIENT_API reset_test_runner();
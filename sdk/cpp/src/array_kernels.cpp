@@ -0,0 +1,268 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/array_kernels.hpp"
+
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define TOUCA_X86_ARRAY_KERNELS
+#define TOUCA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace touca {
+namespace detail {
+
+namespace {
+
+/**
+ * Scores two different numbers the same way as `compare_number` does when
+ * they are compared on their own: numbers that are within 20 percent of
+ * each other earn partial credit.
+ */
+template <typename T>
+double score_numbers(const T src_number, const T dst_number) {
+  const auto threshold = 0.2;
+  const auto src_value = static_cast<double>(src_number);
+  const auto dst_value = static_cast<double>(dst_number);
+  const auto diff = src_value - dst_value;
+  const auto percent = 0.0 == dst_value ? 0.0 : std::fabs(diff / dst_value);
+  return 0.0 < percent && percent < threshold ? 1.0 - percent : 0.0;
+}
+
+template <typename T>
+void add_mismatch(const T* src, const T* dst, const std::size_t index,
+                  const std::size_t max_mismatches,
+                  NumericArrayComparison& out) {
+  out.score += score_numbers(src[index], dst[index]);
+  if (out.mismatches.size() < max_mismatches) {
+    out.mismatches.push_back(index);
+  }
+}
+
+template <typename T>
+void compare_elements(const T* src, const T* dst, const std::size_t begin,
+                      const std::size_t end, const std::size_t max_mismatches,
+                      NumericArrayComparison& out) {
+  for (auto i = begin; i < end; ++i) {
+    if (src[i] == dst[i]) {
+      ++out.matches;
+      continue;
+    }
+    add_mismatch(src, dst, i, max_mismatches, out);
+  }
+}
+
+/**
+ * Accounts for a block of elements that were compared at once, given a
+ * mask with one bit set for each element that is identical in both arrays.
+ * Blocks without differences, by far the most common kind, are accounted
+ * for without looking at their elements.
+ */
+template <typename T>
+void compare_block(const T* src, const T* dst, const std::size_t begin,
+                   const std::size_t lanes, const unsigned mask,
+                   const std::size_t max_mismatches,
+                   NumericArrayComparison& out) {
+  if (mask == (1u << lanes) - 1u) {
+    out.matches += lanes;
+    return;
+  }
+  for (std::size_t lane = 0; lane < lanes; ++lane) {
+    if (mask & (1u << lane)) {
+      ++out.matches;
+      continue;
+    }
+    add_mismatch(src, dst, begin + lane, max_mismatches, out);
+  }
+}
+
+#ifdef TOUCA_X86_ARRAY_KERNELS
+
+template <typename T>
+void compare_sse2_integers(const T* src, const T* dst, const std::size_t size,
+                           const std::size_t max_mismatches,
+                           NumericArrayComparison& out) {
+  std::size_t i = 0;
+  for (; i + 2 <= size; i += 2) {
+    const auto lhs =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const auto rhs =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    // sse2 has no 64-bit equality: both 32-bit halves must be equal
+    const auto halves = _mm_cmpeq_epi32(lhs, rhs);
+    const auto equal = _mm_and_si128(
+        halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    compare_block(src, dst, i, 2, _mm_movemask_pd(_mm_castsi128_pd(equal)),
+                  max_mismatches, out);
+  }
+  compare_elements(src, dst, i, size, max_mismatches, out);
+}
+
+void compare_sse2(const std::int64_t* src, const std::int64_t* dst,
+                  const std::size_t size, const std::size_t max_mismatches,
+                  NumericArrayComparison& out) {
+  compare_sse2_integers(src, dst, size, max_mismatches, out);
+}
+
+void compare_sse2(const std::uint64_t* src, const std::uint64_t* dst,
+                  const std::size_t size, const std::size_t max_mismatches,
+                  NumericArrayComparison& out) {
+  compare_sse2_integers(src, dst, size, max_mismatches, out);
+}
+
+void compare_sse2(const float* src, const float* dst, const std::size_t size,
+                  const std::size_t max_mismatches,
+                  NumericArrayComparison& out) {
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto equal =
+        _mm_cmpeq_ps(_mm_loadu_ps(src + i), _mm_loadu_ps(dst + i));
+    compare_block(src, dst, i, 4, _mm_movemask_ps(equal), max_mismatches,
+                  out);
+  }
+  compare_elements(src, dst, i, size, max_mismatches, out);
+}
+
+void compare_sse2(const double* src, const double* dst, const std::size_t size,
+                  const std::size_t max_mismatches,
+                  NumericArrayComparison& out) {
+  std::size_t i = 0;
+  for (; i + 2 <= size; i += 2) {
+    const auto equal =
+        _mm_cmpeq_pd(_mm_loadu_pd(src + i), _mm_loadu_pd(dst + i));
+    compare_block(src, dst, i, 2, _mm_movemask_pd(equal), max_mismatches,
+                  out);
+  }
+  compare_elements(src, dst, i, size, max_mismatches, out);
+}
+
+template <typename T>
+TOUCA_TARGET_AVX2 void compare_avx2_integers(const T* src, const T* dst,
+                                             const std::size_t size,
+                                             const std::size_t max_mismatches,
+                                             NumericArrayComparison& out) {
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto lhs =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const auto rhs =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    const auto equal = _mm256_cmpeq_epi64(lhs, rhs);
+    compare_block(src, dst, i, 4,
+                  _mm256_movemask_pd(_mm256_castsi256_pd(equal)),
+                  max_mismatches, out);
+  }
+  compare_elements(src, dst, i, size, max_mismatches, out);
+}
+
+TOUCA_TARGET_AVX2 void compare_avx2(const std::int64_t* src,
+                                    const std::int64_t* dst,
+                                    const std::size_t size,
+                                    const std::size_t max_mismatches,
+                                    NumericArrayComparison& out) {
+  compare_avx2_integers(src, dst, size, max_mismatches, out);
+}
+
+TOUCA_TARGET_AVX2 void compare_avx2(const std::uint64_t* src,
+                                    const std::uint64_t* dst,
+                                    const std::size_t size,
+                                    const std::size_t max_mismatches,
+                                    NumericArrayComparison& out) {
+  compare_avx2_integers(src, dst, size, max_mismatches, out);
+}
+
+TOUCA_TARGET_AVX2 void compare_avx2(const float* src, const float* dst,
+                                    const std::size_t size,
+                                    const std::size_t max_mismatches,
+                                    NumericArrayComparison& out) {
+  std::size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto equal =
+        _mm256_cmp_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(dst + i),
+                      _CMP_EQ_OQ);
+    compare_block(src, dst, i, 8, _mm256_movemask_ps(equal), max_mismatches,
+                  out);
+  }
+  compare_elements(src, dst, i, size, max_mismatches, out);
+}
+
+TOUCA_TARGET_AVX2 void compare_avx2(const double* src, const double* dst,
+                                    const std::size_t size,
+                                    const std::size_t max_mismatches,
+                                    NumericArrayComparison& out) {
+  std::size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto equal =
+        _mm256_cmp_pd(_mm256_loadu_pd(src + i), _mm256_loadu_pd(dst + i),
+                      _CMP_EQ_OQ);
+    compare_block(src, dst, i, 4, _mm256_movemask_pd(equal), max_mismatches,
+                  out);
+  }
+  compare_elements(src, dst, i, size, max_mismatches, out);
+}
+
+#endif
+
+template <typename T>
+NumericArrayComparison compare_with_kernel(const T* src, const T* dst,
+                                           const std::size_t size,
+                                           const std::size_t max_mismatches,
+                                           const ArrayKernel kernel) {
+  NumericArrayComparison out;
+  const auto supported = best_array_kernel();
+  const auto chosen = supported < kernel ? supported : kernel;
+#ifdef TOUCA_X86_ARRAY_KERNELS
+  if (chosen == ArrayKernel::AVX2) {
+    compare_avx2(src, dst, size, max_mismatches, out);
+    return out;
+  }
+  if (chosen == ArrayKernel::SSE2) {
+    compare_sse2(src, dst, size, max_mismatches, out);
+    return out;
+  }
+#endif
+  compare_elements(src, dst, 0, size, max_mismatches, out);
+  return out;
+}
+
+}  // namespace
+
+ArrayKernel best_array_kernel() {
+#ifdef TOUCA_X86_ARRAY_KERNELS
+  static const auto kernel = __builtin_cpu_supports("avx2")
+                                 ? ArrayKernel::AVX2
+                                 : ArrayKernel::SSE2;
+  return kernel;
+#else
+  return ArrayKernel::Scalar;
+#endif
+}
+
+NumericArrayComparison compare_numeric_arrays(
+    const std::int64_t* src, const std::int64_t* dst, const std::size_t size,
+    const std::size_t max_mismatches, const ArrayKernel kernel) {
+  return compare_with_kernel(src, dst, size, max_mismatches, kernel);
+}
+
+NumericArrayComparison compare_numeric_arrays(
+    const std::uint64_t* src, const std::uint64_t* dst,
+    const std::size_t size, const std::size_t max_mismatches,
+    const ArrayKernel kernel) {
+  return compare_with_kernel(src, dst, size, max_mismatches, kernel);
+}
+
+NumericArrayComparison compare_numeric_arrays(
+    const float* src, const float* dst, const std::size_t size,
+    const std::size_t max_mismatches, const ArrayKernel kernel) {
+  return compare_with_kernel(src, dst, size, max_mismatches, kernel);
+}
+
+NumericArrayComparison compare_numeric_arrays(
+    const double* src, const double* dst, const std::size_t size,
+    const std::size_t max_mismatches, const ArrayKernel kernel) {
+  return compare_with_kernel(src, dst, size, max_mismatches, kernel);
+}
+
+}  // namespace detail
+}  // namespace touca
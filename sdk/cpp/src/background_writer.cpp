@@ -0,0 +1,120 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/background_writer.hpp"
+
+#include <memory>
+
+namespace touca {
+namespace detail {
+
+BackgroundWriter::BackgroundWriter(const std::size_t capacity,
+                                   const SyncPolicy policy)
+    : _capacity(capacity),
+      _policy(policy),
+      _thread(&BackgroundWriter::run, this) {}
+
+BackgroundWriter::~BackgroundWriter() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopped = true;
+  }
+  _task_added.notify_one();
+  _thread.join();
+}
+
+void BackgroundWriter::write(const std::string& path,
+                             std::vector<std::uint8_t> content) {
+  const auto size = content.size();
+  const auto& buffer =
+      std::make_shared<std::vector<std::uint8_t>>(std::move(content));
+
+  // files flushed one by one are flushed before they are renamed into place
+  if (_policy == SyncPolicy::PerFile) {
+    post([path, buffer]() { save_binary_file(path, *buffer, true); }, size);
+    return;
+  }
+  post([path, buffer]() { save_binary_file(path, *buffer); }, size, path);
+}
+
+void BackgroundWriter::post(std::function<void()> task, const std::size_t size,
+                            const std::string& path) {
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _task_done.wait(lock, [this, size] {
+      return _tasks.empty() || _queued_size + size <= _capacity;
+    });
+    _tasks.push_back(Task{std::move(task), size, path});
+    _queued_size += size;
+  }
+  _task_added.notify_one();
+}
+
+void BackgroundWriter::flush() {
+  if (_policy != SyncPolicy::Never) {
+    post([this]() { sync_files(); });
+  }
+  std::unique_lock<std::mutex> lock(_mutex);
+  _task_done.wait(lock, [this] { return _tasks.empty() && !_busy; });
+  if (!_error.empty()) {
+    const auto error = std::move(_error);
+    _error.clear();
+    throw touca::detail::runtime_error(error);
+  }
+}
+
+void BackgroundWriter::run() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _task_added.wait(lock, [this] { return _stopped || !_tasks.empty(); });
+    if (_tasks.empty()) {
+      return;
+    }
+    auto task = std::move(_tasks.front());
+    _tasks.pop_front();
+    _busy = true;
+    const auto caught_up = _tasks.empty();
+    lock.unlock();
+
+    // keep running the remaining tasks after a failure so that one bad
+    // file does not cost the results of every testcase queued after it.
+    std::string error;
+    try {
+      task.run();
+      if (!task.path.empty() && _policy == SyncPolicy::PerFile) {
+        sync_file(task.path);
+      } else if (!task.path.empty() && _policy != SyncPolicy::Never) {
+        _unsynced.insert(task.path);
+      }
+      if (caught_up && _policy == SyncPolicy::PerBatch) {
+        sync_files();
+      }
+    } catch (const std::exception& ex) {
+      error = ex.what();
+    } catch (...) {
+      error = "unknown error";
+    }
+
+    lock.lock();
+    _busy = false;
+    _queued_size -= task.size;
+    if (_error.empty()) {
+      _error = error;
+    }
+    _task_done.notify_all();
+  }
+}
+
+/**
+ * Flushes files written since they were last flushed. Only called on the
+ * background thread, which owns the list of those files.
+ */
+void BackgroundWriter::sync_files() {
+  const auto files = std::move(_unsynced);
+  _unsynced.clear();
+  for (const auto& path : files) {
+    sync_file(path);
+  }
+}
+
+}  // namespace detail
+}  // namespace touca
@@ -6,10 +6,10 @@
 #include <sstream>
 
 #include "rapidjson/document.h"
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
 #include "touca/client/detail/options.hpp"
+#include "touca/core/compression.hpp"
 #include "touca/core/filesystem.hpp"
+#include "touca/core/result_file.hpp"
 #include "touca/core/transport.hpp"
 #include "touca/impl/schema.hpp"
 
@@ -161,12 +161,39 @@ void ClientImpl::save(const touca::filesystem::path& path,
   }
 
   if (format == DataFormat::JSON) {
-    save_json(path, find_testcases(tcs));
+    const auto& pointers = list_testcases(tcs);
+    touca::detail::save_file(path.string(), [&pointers](std::FILE* file) {
+      write_json(file, pointers);
+    });
   } else {
-    save_flatbuffers(path, find_testcases(tcs));
+    touca::detail::save_binary_file(path.string(),
+                                    serialize_flatbuffers(find_testcases(tcs)));
   }
 }
 
+std::vector<std::uint8_t> ClientImpl::serialize(
+    const std::vector<std::string>& testcases, const DataFormat format) const {
+  if (format == DataFormat::JSON) {
+    const auto& content = testcases_to_json(list_testcases(testcases));
+    return {content.begin(), content.end()};
+  }
+  return serialize_flatbuffers(find_testcases(testcases));
+}
+
+std::vector<std::uint8_t> ClientImpl::serialize_message(
+    const std::string& testcase, const SerializationOptions& options) const {
+  return find_testcases({testcase}).front().flatbuffers(options);
+}
+
+SerializationOptions ClientImpl::serialization_options() const {
+  SerializationOptions options;
+  options.packed_arrays = _options.compact_binary;
+  options.string_table = _options.compact_binary;
+  options.deduplicate = _options.compact_binary;
+  options.compression = parse_compression(_options.compression);
+  return options;
+}
+
 Post::Status ClientImpl::post(const Post::Options& options) const {
   // check that client is configured to submit test results
   if (!_configured || _options.offline) {
@@ -276,28 +303,21 @@ std::vector<Testcase> ClientImpl::find_testcases(
   return testcases;
 }
 
-void ClientImpl::save_json(const touca::filesystem::path& path,
-                           const std::vector<Testcase>& testcases) const {
-  rapidjson::Document doc(rapidjson::kArrayType);
-  rapidjson::Document::AllocatorType& allocator = doc.GetAllocator();
-
-  for (const auto& testcase : testcases) {
-    doc.PushBack(testcase.json(allocator), allocator);
+std::vector<const Testcase*> ClientImpl::list_testcases(
+    const std::vector<std::string>& names) const {
+  std::vector<const Testcase*> testcases;
+  testcases.reserve(names.size());
+  for (const auto& name : names) {
+    testcases.push_back(_testcases.at(name).get());
   }
-
-  rapidjson::StringBuffer strbuf;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(strbuf);
-  writer.SetMaxDecimalPlaces(3);
-  doc.Accept(writer);
-
-  touca::detail::save_text_file(path.string(), strbuf.GetString());
+  return testcases;
 }
 
-void ClientImpl::save_flatbuffers(
-    const touca::filesystem::path& path,
+std::vector<std::uint8_t> ClientImpl::serialize_flatbuffers(
     const std::vector<Testcase>& testcases) const {
-  touca::detail::save_binary_file(path.string(),
-                                  Testcase::serialize(testcases));
+  auto content = Testcase::serialize(testcases, serialization_options());
+  append_footer(content);
+  return content;
 }
 
 void ClientImpl::notify_loggers(const logger::Level severity,
@@ -2,13 +2,43 @@
 
 #include "touca/core/comparison.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "flatbuffers/flatbuffers.h"
 #include "rapidjson/document.h"
+#include "rapidjson/filewritestream.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "touca/core/array_kernels.hpp"
+#include "touca/core/comparison_cache.hpp"
+#include "touca/core/deserialize.hpp"
+#include "touca/core/digest.hpp"
 #include "touca/core/filesystem.hpp"
+#include "touca/core/result_file.hpp"
+#include "touca/core/text_diff.hpp"
+#include "touca/core/thread_pool.hpp"
+#include "touca/impl/comparison_schema.hpp"
+#include "touca/impl/schema.hpp"
 
 namespace touca {
 
+ComparisonFormat parse_comparison_format(const std::string& name) {
+  if (name == "json") {
+    return ComparisonFormat::Json;
+  }
+  if (name == "binary") {
+    return ComparisonFormat::Binary;
+  }
+  throw touca::detail::runtime_error(
+      touca::detail::format("comparison format {} is not known", name));
+}
+
 std::string Cellar::stringify(const touca::detail::internal_type type) const {
   switch (type) {
     case touca::detail::internal_type::boolean:
@@ -29,11 +59,87 @@ std::string Cellar::stringify(const touca::detail::internal_type type) const {
   }
 }
 
-rapidjson::Value Cellar::json(
-    rapidjson::Document::AllocatorType& allocator) const {
-  auto rj_common = build_json_common(common, allocator);
-  auto rj_missing = build_json_solo(missing, Category::Missing, allocator);
-  auto rj_fresh = build_json_solo(fresh, Category::Fresh, allocator);
+/**
+ * Removes the last character of a given string if the string was cut short
+ * in the middle of the utf-8 encoding of that character.
+ */
+void trim_partial_character(std::string& out) {
+  auto pos = out.size();
+  while (0 < pos && out.size() < pos + 3 &&
+         (static_cast<unsigned char>(out[pos - 1]) & 0xC0) == 0x80) {
+    --pos;
+  }
+  if (0 == pos) {
+    return;
+  }
+  const auto lead = static_cast<unsigned char>(out[pos - 1]);
+  const std::size_t length = lead < 0xC0   ? 1
+                             : lead < 0xE0 ? 2
+                             : lead < 0xF0 ? 3
+                                           : 4;
+  if (out.size() < pos - 1 + length) {
+    out.resize(pos - 1);
+  }
+}
+
+ComparedValue::ComparedValue(const data_point& value)
+    : _value(&value), _type(value.type()) {}
+
+ComparedValue::ComparedValue(const touca::detail::internal_type type,
+                             std::string preview, const bool truncated)
+    : _preview(std::move(preview)), _truncated(truncated), _type(type) {
+  if (_truncated) {
+    trim_partial_character(_preview);
+  }
+}
+
+bool ComparedValue::empty() const noexcept {
+  return !_value && _type == touca::detail::internal_type::unknown;
+}
+
+void ComparedValue::render(std::string& out, const std::size_t max_size) const {
+  const auto limit = 0 == max_size ? std::string::npos : max_size;
+  auto truncated = _truncated;
+  if (_value) {
+    truncated = !_value->to_string(out, limit);
+  } else {
+    out.assign(_preview, 0, limit);
+    truncated = truncated || limit < _preview.size();
+  }
+  if (truncated) {
+    trim_partial_character(out);
+    out.append("...");
+  }
+}
+
+std::string ComparedValue::str(const std::size_t max_size) const {
+  std::string out;
+  render(out, max_size);
+  return out;
+}
+
+bool ComparedValue::operator==(const std::string& other) const {
+  return str() == other;
+}
+
+void ComparedValue::freeze(const std::size_t max_size) {
+  if (!_value) {
+    return;
+  }
+  const auto limit = 0 == max_size ? std::string::npos : max_size;
+  _truncated = !_value->to_string(_preview, limit);
+  if (_truncated) {
+    trim_partial_character(_preview);
+  }
+  _value = nullptr;
+}
+
+rapidjson::Value Cellar::json(rapidjson::Document::AllocatorType& allocator,
+                              const std::size_t max_size) const {
+  auto rj_common = build_json_common(common, max_size, allocator);
+  auto rj_missing =
+      build_json_solo(missing, Category::Missing, max_size, allocator);
+  auto rj_fresh = build_json_solo(fresh, Category::Fresh, max_size, allocator);
   rapidjson::Value result(rapidjson::kObjectType);
   result.AddMember("commonKeys", rj_common, allocator);
   result.AddMember("missingKeys", rj_missing, allocator);
@@ -43,17 +149,20 @@ rapidjson::Value Cellar::json(
 
 rapidjson::Value Cellar::build_json_solo(const Cellar::KeyMap& keyMap,
                                          const Cellar::Category category,
+                                         const std::size_t max_size,
                                          RJAllocator& allocator) const {
   rapidjson::Value elements(rapidjson::kArrayType);
+  std::string value;
   for (const auto& kv : keyMap) {
     rapidjson::Value item(rapidjson::kObjectType);
     item.AddMember("name", kv.first, allocator);
+    kv.second.render(value, max_size);
     if (category == Category::Fresh) {
       item.AddMember("srcType", stringify(kv.second.type()), allocator);
-      item.AddMember("srcValue", kv.second.to_string(), allocator);
+      item.AddMember("srcValue", value, allocator);
     } else {
       item.AddMember("dstType", stringify(kv.second.type()), allocator);
-      item.AddMember("dstValue", kv.second.to_string(), allocator);
+      item.AddMember("dstValue", value, allocator);
     }
     elements.PushBack(item, allocator);
   }
@@ -61,9 +170,10 @@ rapidjson::Value Cellar::build_json_solo(const Cellar::KeyMap& keyMap,
 }
 
 rapidjson::Value Cellar::build_json_common(
-    const ComparisonMap& elements,
+    const ComparisonMap& elements, const std::size_t max_size,
     rapidjson::Document::AllocatorType& allocator) const {
   rapidjson::Value items(rapidjson::kArrayType);
+  std::string value;
   for (const auto& kv : elements) {
     const auto& key = kv.first;
     const auto& second = kv.second;
@@ -74,15 +184,24 @@ rapidjson::Value Cellar::build_json_common(
     rapidjson::Value rjName{key, allocator};
     rapidjson::Value rjScore{second.score};
     rapidjson::Value rjSrcType{stringify(second.srcType), allocator};
-    rapidjson::Value rjSrcValue{second.srcValue, allocator};
+    second.srcValue.render(value, max_size);
+    rapidjson::Value rjSrcValue{value, allocator};
     if (touca::detail::internal_type::unknown != second.dstType) {
       rjDstType.Set(stringify(second.dstType), allocator);
     }
     if (MatchType::Perfect != second.match) {
-      rjDstValue.Set(second.dstValue, allocator);
+      second.dstValue.render(value, max_size);
+      rjDstValue.Set(value, allocator);
     }
-    if (!second.desc.empty()) {
-      for (const auto& entry : second.desc) {
+    // differences that were not described when compared are described now
+    std::set<std::string> described;
+    const auto* desc = &second.desc;
+    if (!second.described) {
+      described = second.describe();
+      desc = &described;
+    }
+    if (!desc->empty()) {
+      for (const auto& entry : *desc) {
         rapidjson::Value rjEntry(rapidjson::kStringType);
         rjEntry.SetString(entry, allocator);
         rjDesc.PushBack(rjEntry, allocator);
@@ -100,7 +219,7 @@ rapidjson::Value Cellar::build_json_common(
     if (MatchType::Perfect != second.match) {
       item.AddMember("dstValue", rjDstValue, allocator);
     }
-    if (!second.desc.empty()) {
+    if (!desc->empty()) {
       item.AddMember("desc", rjDesc, allocator);
     }
     items.PushBack(item, allocator);
@@ -141,19 +260,447 @@ std::map<std::string, data_point> flatten(const data_point& input) {
   return entries;
 }
 
-std::vector<data_point> flatten_array(
-    const std::map<std::string, data_point>& elements) {
-  std::vector<data_point> data_points;
-  data_points.reserve(elements.size());
-  for (const auto& element : elements) {
-    data_points.emplace_back(element.second);
+/**
+ * Compares two values, describing their differences only if asked to.
+ */
+TypeComparison compare(const data_point& src, const data_point& dst,
+                       const bool describe, const ComparisonOptions& options);
+
+/**
+ * Options with which values are compared unless options are given.
+ */
+const ComparisonOptions& default_options() {
+  static const ComparisonOptions options;
+  return options;
+}
+
+/**
+ * Whether values should be described as they are compared. Values compared
+ * in summary mode are described on demand, with the default options, which
+ * is only possible if they were compared with the same options as far as
+ * their descriptions are concerned.
+ */
+bool describes(const ComparisonOptions& options) {
+  const auto& defaults = default_options();
+  return !options.summary_only ||
+         options.array_alignment != defaults.array_alignment ||
+         options.max_hunks != defaults.max_hunks ||
+         options.max_line_edits != defaults.max_line_edits;
+}
+
+/**
+ * @return whether `flatten` would descend into a given value, as opposed to
+ *         taking it as a leaf
+ */
+bool is_branch(const data_point& value) {
+  switch (value.type()) {
+    case touca::detail::internal_type::array:
+      return !value.as_array()->empty();
+    case touca::detail::internal_type::object:
+      return !value.as_object()->empty();
+    default:
+      return false;
+  }
+}
+
+/**
+ * Calls a given function with indices of the elements of an array in the
+ * order that `flatten` lists them. Keys of elements are sorted as strings,
+ * so that index 10 comes before index 2 but after index 0.
+ */
+template <typename Visit>
+void visit_index(const std::size_t index, const std::size_t size,
+                 Visit& visit) {
+  for (auto digit = 0u; digit < 10u && index * 10u + digit < size; ++digit) {
+    visit_index(index * 10u + digit, size, visit);
+  }
+  visit(index);
+}
+
+template <typename Visit>
+void visit_indices(const std::size_t size, Visit& visit) {
+  if (0u != size) {
+    visit(0u);
+  }
+  for (auto digit = 1u; digit < 10u && digit < size; ++digit) {
+    visit_index(digit, size, visit);
+  }
+}
+
+/**
+ * Orders members of an object the way `flatten` orders their keys: keys of
+ * members that `flatten` descends into are followed by a dot.
+ */
+bool is_member_key_less(const touca::detail::object_t::value_type* lhs,
+                        const touca::detail::object_t::value_type* rhs) {
+  const auto& left = lhs->first;
+  const auto& right = rhs->first;
+  const auto left_size = left.size() + (is_branch(lhs->second) ? 1u : 0u);
+  const auto right_size = right.size() + (is_branch(rhs->second) ? 1u : 0u);
+  for (std::size_t i = 0u; i < left_size && i < right_size; ++i) {
+    const auto l = i < left.size() ? left[i] : '.';
+    const auto r = i < right.size() ? right[i] : '.';
+    if (l != r) {
+      return static_cast<unsigned char>(l) < static_cast<unsigned char>(r);
+    }
+  }
+  return left_size < right_size;
+}
+
+/**
+ * Collects the values that `flatten` would list for a given value, in the
+ * same order, without building their keys or copying them.
+ */
+class leaf_collector {
+ public:
+  explicit leaf_collector(std::vector<const data_point*>& leaves)
+      : _leaves(leaves) {}
+
+  void operator()(const std::size_t index) { add(_array->at(index)); }
+
+  void collect(const data_point& value) {
+    if (value.type() == touca::detail::internal_type::array) {
+      const auto parent = _array;
+      _array = value.as_array();
+      visit_indices(_array->size(), *this);
+      _array = parent;
+      return;
+    }
+    const auto& members = *value.as_object();
+    std::vector<const touca::detail::object_t::value_type*> order;
+    order.reserve(members.size());
+    for (const auto& member : members) {
+      order.emplace_back(&member);
+    }
+    if (!std::is_sorted(order.begin(), order.end(), is_member_key_less)) {
+      std::stable_sort(order.begin(), order.end(), is_member_key_less);
+    }
+    for (const auto& member : order) {
+      add(member->second);
+    }
+  }
+
+ private:
+  void add(const data_point& value) {
+    if (is_branch(value)) {
+      collect(value);
+    } else {
+      _leaves.emplace_back(&value);
+    }
+  }
+
+  std::vector<const data_point*>& _leaves;
+  const touca::detail::array_t* _array = nullptr;
+};
+
+std::vector<const data_point*> collect_leaves(const data_point& value) {
+  std::vector<const data_point*> leaves;
+  leaf_collector collector(leaves);
+  collector.collect(value);
+  return leaves;
+}
+
+/**
+ * Position of a value within the object being compared, kept as a list of
+ * member names and array indices so that its key is only built when the
+ * value is reported.
+ */
+class value_path {
+ public:
+  void push(const std::string& name) { _segments.emplace_back(&name, 0u); }
+
+  void push(const std::size_t index) {
+    _segments.emplace_back(nullptr, index);
+  }
+
+  void pop() { _segments.pop_back(); }
+
+  /**
+   * @return key of the value in the form generated by `flatten`
+   */
+  std::string str() const {
+    std::string out;
+    for (auto i = 0u; i < _segments.size(); ++i) {
+      const auto& segment = _segments[i];
+      if (!segment.first) {
+        out.append(touca::detail::format("[{}]", segment.second));
+      } else if (i + 1u == _segments.size()) {
+        out.append(*segment.first);
+      } else {
+        out.append(*segment.first).push_back('.');
+      }
+    }
+    return out;
+  }
+
+ private:
+  std::vector<std::pair<const std::string*, std::size_t>> _segments;
+};
+
+template <typename T>
+void update_digest(detail::xxh64& state, const T& value) {
+  state.update(&value, sizeof(value));
+}
+
+void update_digest(detail::xxh64& state, const std::string& value) {
+  update_digest(state, value.size());
+  state.update(value.data(), value.size());
+}
+
+/**
+ * Feeds a given value into a given digest, such that values that `compare`
+ * reports as a perfect match almost always have the same digest. Similar
+ * to `compare`, we do not consider name of the objects.
+ */
+void update_digest(detail::xxh64& state, const data_point& value) {
+  update_digest(state, value.type());
+  switch (value.type()) {
+    case touca::detail::internal_type::object:
+      update_digest(state, value.as_object()->size());
+      for (const auto& member : *value.as_object()) {
+        update_digest(state, member.first);
+        update_digest(state, member.second);
+      }
+      break;
+    case touca::detail::internal_type::array:
+      update_digest(state, value.as_array()->size());
+      for (const auto& element : *value.as_array()) {
+        update_digest(state, element);
+      }
+      break;
+    case touca::detail::internal_type::string:
+      update_digest(state, *value.as_string());
+      break;
+    case touca::detail::internal_type::boolean:
+      update_digest(state, value.as_boolean());
+      break;
+    case touca::detail::internal_type::number_signed:
+      update_digest(state, value.as_number_signed());
+      break;
+    case touca::detail::internal_type::number_unsigned:
+      update_digest(state, value.as_number_unsigned());
+      break;
+    case touca::detail::internal_type::number_float:
+      update_digest(state, value.as_number_float());
+      break;
+    case touca::detail::internal_type::number_double:
+      update_digest(state, value.as_number_double());
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @return whether elements of two arrays are to be matched by identity
+ *         rather than by position, which we only do for arrays whose
+ *         elements are all objects
+ */
+bool is_aligned(const detail::array_t& src, const detail::array_t& dst,
+                const ComparisonOptions& options) {
+  const auto& is_object = [](const data_point& value) {
+    return value.type() == touca::detail::internal_type::object;
+  };
+  return options.array_alignment == ArrayAlignment::Identity &&
+         !src.empty() && !dst.empty() &&
+         std::all_of(src.begin(), src.end(), is_object) &&
+         std::all_of(dst.begin(), dst.end(), is_object);
+}
+
+/**
+ * @return digest of the identity of an object: the value of its identity
+ *         member if it has one, or else its content
+ */
+std::uint64_t identify(const data_point& value, const std::string& member) {
+  detail::xxh64 state;
+  const auto& members = *value.as_object();
+  const auto it = member.empty() ? members.end() : members.find(member);
+  update_digest(state, it != members.end());
+  update_digest(state, it != members.end() ? it->second : value);
+  return state.digest();
+}
+
+/**
+ * Matches elements of two arrays of objects by their identity in a single
+ * pass over each array. Elements that share the same identity are matched
+ * in the order of their position.
+ *
+ * @return position of the counterpart of each element of `src` in `dst`,
+ *         or `std::string::npos` if it has none
+ */
+std::vector<std::size_t> align_elements(const detail::array_t& src,
+                                        const detail::array_t& dst,
+                                        const std::string& member) {
+  std::unordered_map<std::uint64_t, std::vector<std::size_t>> positions;
+  positions.reserve(dst.size());
+  for (auto j = dst.size(); j > 0u; --j) {
+    positions[identify(dst[j - 1u], member)].push_back(j - 1u);
+  }
+  std::vector<std::size_t> out(src.size(), std::string::npos);
+  for (std::size_t i = 0u; i < src.size(); ++i) {
+    const auto it = positions.find(identify(src[i], member));
+    if (it != positions.end() && !it->second.empty()) {
+      out[i] = it->second.back();
+      it->second.pop_back();
+    }
   }
-  return data_points;
+  return out;
 }
 
+/**
+ * Walks two objects in lockstep, matching their values by the keys that
+ * `flatten` would give them, and scores their leaves. Elements of arrays
+ * that are aligned by identity are matched by `align_elements` and keyed
+ * by their position in `src`, or in `dst` if they are new.
+ */
+class tree_comparator {
+ public:
+  tree_comparator(TypeComparison& cmp, const bool describe,
+                  const ComparisonOptions& options)
+      : _cmp(cmp), _describe(describe), _options(options) {}
+
+  void compare_children(const data_point& src, const data_point& dst) {
+    if (src.type() == touca::detail::internal_type::array) {
+      const auto& lhs = *src.as_array();
+      const auto& rhs = *dst.as_array();
+      if (is_aligned(lhs, rhs, _options)) {
+        compare_aligned(lhs, rhs);
+        return;
+      }
+      for (std::size_t i = 0u; i < lhs.size() || i < rhs.size(); ++i) {
+        _path.push(i);
+        if (rhs.size() <= i) {
+          report(lhs[i], "missing");
+        } else if (lhs.size() <= i) {
+          report(rhs[i], "new");
+        } else {
+          compare_values(lhs[i], rhs[i]);
+        }
+        _path.pop();
+      }
+      return;
+    }
+    const auto& lhs = *src.as_object();
+    const auto& rhs = *dst.as_object();
+    auto i = lhs.begin();
+    auto j = rhs.begin();
+    while (i != lhs.end() || j != rhs.end()) {
+      if (j == rhs.end() || (i != lhs.end() && i->first < j->first)) {
+        _path.push(i->first);
+        report(i->second, "missing");
+        ++i;
+      } else if (i == lhs.end() || j->first < i->first) {
+        _path.push(j->first);
+        report(j->second, "new");
+        ++j;
+      } else {
+        _path.push(i->first);
+        compare_values(i->second, j->second);
+        ++i;
+        ++j;
+      }
+      _path.pop();
+    }
+  }
+
+  void compare_aligned(const detail::array_t& lhs,
+                       const detail::array_t& rhs) {
+    const auto& counterparts =
+        align_elements(lhs, rhs, _options.identity_member);
+    std::vector<bool> matched(rhs.size(), false);
+    for (std::size_t i = 0u; i < lhs.size(); ++i) {
+      _path.push(i);
+      if (counterparts[i] == std::string::npos) {
+        report(lhs[i], "missing");
+      } else {
+        matched[counterparts[i]] = true;
+        compare_values(lhs[i], rhs[counterparts[i]]);
+      }
+      _path.pop();
+    }
+    for (std::size_t j = 0u; j < rhs.size(); ++j) {
+      if (!matched[j]) {
+        _path.push(j);
+        report(rhs[j], "new");
+        _path.pop();
+      }
+    }
+  }
+
+  void finalize() {
+    // report comparison as perfect match if all children match
+    if (_scoreEarned == _scoreTotal) {
+      _cmp.match = MatchType::Perfect;
+      _cmp.score = 1.0;
+      return;
+    }
+    // set score as match rate of children
+    _cmp.score = _scoreEarned / _scoreTotal;
+  }
+
+ private:
+  void compare_values(const data_point& src, const data_point& dst) {
+    const auto src_branch = is_branch(src);
+    const auto dst_branch = is_branch(dst);
+    if (src_branch && dst_branch && src.type() == dst.type()) {
+      compare_children(src, dst);
+      return;
+    }
+    if (src_branch || dst_branch) {
+      report(src, "missing");
+      report(dst, "new");
+      return;
+    }
+    ++_scoreTotal;
+    const auto& tmp = compare(src, dst, _describe, _options);
+    _scoreEarned += tmp.score;
+    if (MatchType::Perfect == tmp.match || !_describe) {
+      return;
+    }
+    const auto& key = _path.str();
+    for (const auto& desc : tmp.desc) {
+      _cmp.desc.insert(key + ": " + desc);
+    }
+  }
+
+  /**
+   * Reports leaves of a value that has no counterpart in the other object.
+   */
+  void report(const data_point& value, const char* verdict) {
+    if (!is_branch(value)) {
+      ++_scoreTotal;
+      if (_describe) {
+        _cmp.desc.insert(_path.str() + ": " + verdict);
+      }
+      return;
+    }
+    if (value.type() == touca::detail::internal_type::array) {
+      const auto& elements = *value.as_array();
+      for (std::size_t i = 0u; i < elements.size(); ++i) {
+        _path.push(i);
+        report(elements[i], verdict);
+        _path.pop();
+      }
+      return;
+    }
+    for (const auto& member : *value.as_object()) {
+      _path.push(member.first);
+      report(member.second, verdict);
+      _path.pop();
+    }
+  }
+
+  TypeComparison& _cmp;
+  bool _describe;
+  const ComparisonOptions& _options;
+  value_path _path;
+  double _scoreEarned = 0.0;
+  unsigned _scoreTotal = 0u;
+};
+
 template <typename T>
 void compare_number(const T& src_number, const T& dst_number,
-                    TypeComparison& cmp) {
+                    const bool describe, TypeComparison& cmp) {
   if (src_number == dst_number) {
     cmp.match = MatchType::Perfect;
     cmp.score = 1.0;
@@ -164,20 +711,224 @@ void compare_number(const T& src_number, const T& dst_number,
   const auto dst_value = static_cast<double>(dst_number);
   const auto diff = src_value - dst_value;
   const auto percent = 0.0 == dst_value ? 0.0 : std::fabs(diff / dst_value);
-  const auto& difference = 0.0 == percent || threshold < percent
-                               ? std::to_string(std::fabs(diff))
-                               : std::to_string(percent * 100.0) + " percent";
   if (0.0 < percent && percent < threshold) {
     cmp.score = 1.0 - percent;
   }
+  if (!describe) {
+    return;
+  }
+  const auto& difference = 0.0 == percent || threshold < percent
+                               ? std::to_string(std::fabs(diff))
+                               : std::to_string(percent * 100.0) + " percent";
   const std::string direction = 0 < diff ? "larger" : "smaller";
   cmp.desc.insert("value is " + direction + " by " + difference);
 }
 
+/**
+ * Whether element-wise differences of two arrays are helpful to report.
+ * Arrays with too many different elements are considered entirely
+ * different.
+ */
+bool is_reportable(const std::size_t differenceCount,
+                   const std::size_t size) {
+  const auto diffRatioThreshold = 0.2;
+  const auto diffSizeThreshold = 10U;
+  const auto diffRatio = differenceCount / static_cast<double>(size);
+  return diffRatio < diffRatioThreshold || differenceCount < diffSizeThreshold;
+}
+
+/**
+ * Number of different elements of two numeric arrays whose indices are
+ * collected while the arrays are compared. Indices of the other different
+ * elements are collected in a second pass, if they are to be described.
+ */
+constexpr std::size_t located_differences = 64;
+
+/**
+ * Compares two numeric arrays of the same size with contiguous elements,
+ * following the same rules as `compare_arrays`. Elements are compared by
+ * a vectorized kernel and only compared one by one to describe their
+ * differences.
+ */
+template <typename T>
+void compare_packed_arrays(const T* src, const T* dst, const std::size_t size,
+                           const bool describe, TypeComparison& cmp) {
+  if (0u == size) {
+    cmp.match = MatchType::Perfect;
+    cmp.score = 1.0;
+    return;
+  }
+  auto result = detail::compare_numeric_arrays(
+      src, dst, size, describe ? located_differences : 0u);
+  const auto differenceCount = size - result.matches;
+  if (!is_reportable(differenceCount, size)) {
+    return;
+  }
+  if (describe && 0u != differenceCount) {
+    if (result.mismatches.size() < differenceCount) {
+      result = detail::compare_numeric_arrays(src, dst, size, differenceCount);
+    }
+    // elements are reported by their position in the order that `flatten`
+    // lists them, which only differs from their index in large arrays.
+    std::vector<std::size_t> positions(size);
+    std::size_t position = 0u;
+    auto visit = [&positions, &position](const std::size_t index) {
+      positions[index] = position++;
+    };
+    visit_indices(size, visit);
+    for (const auto index : result.mismatches) {
+      TypeComparison element;
+      compare_number(src[index], dst[index], true, element);
+      for (const auto& msg : element.desc) {
+        cmp.desc.insert(
+            touca::detail::format("[{}]:{}", positions[index], msg));
+      }
+    }
+  }
+  cmp.score = (result.matches + result.score) / size;
+  if (1.0 == cmp.score) {
+    cmp.match = MatchType::Perfect;
+  }
+}
+
+template <typename T, typename Get>
+bool compare_number_arrays(const detail::array_t& src,
+                           const detail::array_t& dst, Get get,
+                           const bool describe, TypeComparison& cmp) {
+  const auto type = src.front().type();
+  std::vector<T> src_numbers;
+  std::vector<T> dst_numbers;
+  src_numbers.reserve(src.size());
+  dst_numbers.reserve(dst.size());
+  for (std::size_t i = 0; i < src.size(); ++i) {
+    if (src[i].type() != type || dst[i].type() != type) {
+      return false;
+    }
+    src_numbers.push_back((src[i].*get)());
+    dst_numbers.push_back((dst[i].*get)());
+  }
+  compare_packed_arrays(src_numbers.data(), dst_numbers.data(),
+                        src_numbers.size(), describe, cmp);
+  return true;
+}
+
+/**
+ * Compares two arrays of the same size whose elements are all numbers of
+ * the same type by packing their elements. Arrays of any other shape are
+ * left to `compare_arrays`.
+ *
+ * @return whether the arrays were compared
+ */
+bool compare_number_arrays(const data_point& src, const data_point& dst,
+                           const bool describe, TypeComparison& cmp) {
+  const auto& src_elements = *src.as_array();
+  const auto& dst_elements = *dst.as_array();
+  if (src_elements.empty() || src_elements.size() != dst_elements.size()) {
+    return false;
+  }
+  switch (src_elements.front().type()) {
+    case touca::detail::internal_type::number_signed:
+      return compare_number_arrays<detail::number_signed_t>(
+          src_elements, dst_elements, &data_point::as_number_signed, describe,
+          cmp);
+    case touca::detail::internal_type::number_unsigned:
+      return compare_number_arrays<detail::number_unsigned_t>(
+          src_elements, dst_elements, &data_point::as_number_unsigned,
+          describe, cmp);
+    case touca::detail::internal_type::number_float:
+      return compare_number_arrays<detail::number_float_t>(
+          src_elements, dst_elements, &data_point::as_number_float, describe,
+          cmp);
+    case touca::detail::internal_type::number_double:
+      return compare_number_arrays<detail::number_double_t>(
+          src_elements, dst_elements, &data_point::as_number_double, describe,
+          cmp);
+    default:
+      return false;
+  }
+}
+
+/**
+ * @return given range of lines in the form `line 3` or `lines 3-5`, with
+ *         lines counted from one
+ */
+std::string describe_lines(const std::size_t first, const std::size_t count) {
+  if (1u == count) {
+    return touca::detail::format("line {}", first + 1u);
+  }
+  return touca::detail::format("lines {}-{}", first + 1u, first + count);
+}
+
+/**
+ * Compares two strings that are different. Strings of more than one line
+ * are compared line by line, within the budget that the options allow,
+ * and scored by the share of lines they have in common. Other strings are
+ * considered entirely different.
+ */
+void compare_strings(const std::string& src, const std::string& dst,
+                     const bool describe, const ComparisonOptions& options,
+                     TypeComparison& cmp) {
+  if (src.find('\n') == std::string::npos &&
+      dst.find('\n') == std::string::npos) {
+    return;
+  }
+  const auto& result = detail::compare_lines(
+      src, dst, describe ? options.max_hunks : 0u, options.max_line_edits);
+  cmp.score = result.similarity();
+  if (!describe) {
+    return;
+  }
+  for (const auto& hunk : result.hunks) {
+    if (0u == hunk.dst_count) {
+      cmp.desc.insert(
+          describe_lines(hunk.src_line, hunk.src_count) + " added");
+    } else if (0u == hunk.src_count) {
+      cmp.desc.insert(
+          describe_lines(hunk.dst_line, hunk.dst_count) + " removed");
+    } else {
+      cmp.desc.insert(touca::detail::format(
+          "{} replaced by {}", describe_lines(hunk.dst_line, hunk.dst_count),
+          describe_lines(hunk.src_line, hunk.src_count)));
+    }
+  }
+  if (result.hunks.size() < result.hunk_count) {
+    cmp.desc.insert(touca::detail::format(
+        "{} more ranges of lines are different",
+        result.hunk_count - result.hunks.size()));
+  }
+  if (!result.complete) {
+    cmp.desc.insert("too many lines are different to compare line by line");
+  }
+}
+
+void compare_objects(const data_point& src, const data_point& dst,
+                     const bool describe, const ComparisonOptions& options,
+                     TypeComparison& cmp) {
+  tree_comparator comparator(cmp, describe, options);
+  comparator.compare_children(src, dst);
+  comparator.finalize();
+}
+
 void compare_arrays(const data_point& src, const data_point& dst,
+                    const bool describe, const ComparisonOptions& options,
                     TypeComparison& cmp) {
-  const auto& src_members = flatten_array(flatten(src));
-  const auto& dst_members = flatten_array(flatten(dst));
+  // elements of aligned arrays may have moved or changed in number, so we
+  // compare the arrays the same way as objects.
+  if (is_aligned(*src.as_array(), *dst.as_array(), options)) {
+    compare_objects(src, dst, describe, options, cmp);
+    if (MatchType::Perfect != cmp.match) {
+      cmp.dstValue = ComparedValue(dst);
+    }
+    return;
+  }
+  if (compare_number_arrays(src, dst, describe, cmp)) {
+    if (MatchType::Perfect != cmp.match) {
+      cmp.dstValue = ComparedValue(dst);
+    }
+    return;
+  }
+  const auto& src_members = collect_leaves(src);
+  const auto& dst_members = collect_leaves(dst);
   const std::pair<size_t, size_t> minmax =
       std::minmax(src_members.size(), dst_members.size());
 
@@ -199,7 +950,7 @@ void compare_arrays(const data_point& src, const data_point& dst,
   const auto diffRange = minmax.second - minmax.first;
   const auto sizeRatio = diffRange / static_cast<double>(minmax.second);
   // describe the change of array size
-  if (0 != diffRange) {
+  if (0 != diffRange && describe) {
     const auto& change =
         src_members.size() < dst_members.size() ? "shrunk" : "grown";
     cmp.desc.insert(touca::detail::format("array size {} by {} elements",
@@ -210,31 +961,31 @@ void compare_arrays(const data_point& src, const data_point& dst,
   if (sizeThreshold < sizeRatio || src_members.empty()) {
     // keep match as None and score as 0.0
     // and return the comparison result
-    cmp.dstValue = dst.to_string();
+    cmp.dstValue = ComparedValue(dst);
     return;
   }
 
   // perform element-wise comparison
   auto scoreEarned = 0.0;
+  std::size_t differenceCount = 0;
   std::unordered_map<unsigned, std::set<std::string>> differences;
 
   for (auto i = 0U; i < minmax.first; i++) {
-    const auto tmp = compare(src_members.at(i), dst_members.at(i));
+    const auto tmp =
+        compare(*src_members.at(i), *dst_members.at(i), describe, options);
     scoreEarned += tmp.score;
     if (MatchType::None == tmp.match) {
-      differences.emplace(i, tmp.desc);
+      ++differenceCount;
+      if (describe) {
+        differences.emplace(i, tmp.desc);
+      }
     }
   }
 
   // we will only report element-wise differences if the number of
   // different elements does not exceed our threshold that determines
   // if this information is helpful to user.
-  const auto diffRatioThreshold = 0.2;
-  const auto diffSizeThreshold = 10U;
-  const auto diffRatio =
-      differences.size() / static_cast<double>(src_members.size());
-  if (diffRatio < diffRatioThreshold ||
-      differences.size() < diffSizeThreshold) {
+  if (is_reportable(differenceCount, src_members.size())) {
     for (const auto& diff : differences) {
       for (const auto& msg : diff.second) {
         cmp.desc.insert(touca::detail::format("[{}]:{}", diff.first, msg));
@@ -248,72 +999,29 @@ void compare_arrays(const data_point& src, const data_point& dst,
     return;
   }
 
-  cmp.dstValue = dst.to_string();
-}
-
-void compare_objects(const data_point& src, const data_point& dst,
-                     TypeComparison& cmp) {
-  const auto& src_members = flatten(src);
-  const auto& dst_members = flatten(dst);
-
-  auto scoreEarned = 0.0;
-  auto scoreTotal = 0U;
-  for (const auto& src_member : src_members) {
-    ++scoreTotal;
-    // compare common members
-    if (dst_members.count(src_member.first)) {
-      const auto& dstKey = dst_members.at(src_member.first);
-      const auto& tmp = compare(src_member.second, dstKey);
-      scoreEarned += tmp.score;
-      if (MatchType::Perfect == tmp.match) {
-        continue;
-      }
-      for (const auto& desc : tmp.desc) {
-        const auto& msg = src_member.first + ": " + desc;
-        cmp.desc.insert(msg);
-      }
-      continue;
-    }
-    // report src members that are missing from dst
-    const auto& msg = src_member.first + ": missing";
-    cmp.desc.insert(msg);
-  }
-
-  // report dst members that are missing from src
-  for (const auto& dstMember : dst_members) {
-    if (!src_members.count(dstMember.first)) {
-      const auto& msg = dstMember.first + ": new";
-      cmp.desc.insert(msg);
-      ++scoreTotal;
-    }
-  }
-
-  // report comparison as perfect match if all children match
-  if (scoreEarned == scoreTotal) {
-    cmp.match = MatchType::Perfect;
-    cmp.score = 1.0;
-    return;
-  }
-  // set score as match rate of children
-  cmp.score = scoreEarned / scoreTotal;
+  cmp.dstValue = ComparedValue(dst);
 }
 
-TypeComparison compare(const data_point& src, const data_point& dst) {
+TypeComparison compare(const data_point& src, const data_point& dst,
+                       const bool describe, const ComparisonOptions& options) {
   TypeComparison cmp;
-  cmp.srcType = src._type;
-  cmp.srcValue = src.to_string();
+  cmp.srcType = src.type();
+  cmp.srcValue = ComparedValue(src);
+  cmp.described = describe;
 
   // the two result keys are considered completely different
   // if they are different in types.
 
-  if (src._type != dst._type) {
-    cmp.dstType = dst._type;
-    cmp.dstValue = dst.to_string();
-    cmp.desc.insert("result types are different");
+  if (src.type() != dst.type()) {
+    cmp.dstType = dst.type();
+    cmp.dstValue = ComparedValue(dst);
+    if (describe) {
+      cmp.desc.insert("result types are different");
+    }
     return cmp;
   }
 
-  switch (src._type) {
+  switch (src.type()) {
     case touca::detail::internal_type::boolean:
       // two Bool objects are equal if they have identical values.
       if (src.as_boolean() == dst.as_boolean()) {
@@ -321,38 +1029,38 @@ TypeComparison compare(const data_point& src, const data_point& dst) {
         cmp.score = 1.0;
         return cmp;
       }
-      cmp.dstValue = dst.to_string();
+      cmp.dstValue = ComparedValue(dst);
       break;
 
     case touca::detail::internal_type::number_double:
-      compare_number<detail::number_double_t>(src.as_number_double(),
-                                              dst.as_number_double(), cmp);
+      compare_number<detail::number_double_t>(
+          src.as_number_double(), dst.as_number_double(), describe, cmp);
       if (cmp.match != MatchType::Perfect) {
-        cmp.dstValue = dst.to_string();
+        cmp.dstValue = ComparedValue(dst);
       }
       break;
 
     case touca::detail::internal_type::number_float:
-      compare_number<detail::number_float_t>(src.as_number_float(),
-                                             dst.as_number_float(), cmp);
+      compare_number<detail::number_float_t>(
+          src.as_number_float(), dst.as_number_float(), describe, cmp);
       if (cmp.match != MatchType::Perfect) {
-        cmp.dstValue = dst.to_string();
+        cmp.dstValue = ComparedValue(dst);
       }
       break;
 
     case touca::detail::internal_type::number_signed:
-      compare_number<detail::number_signed_t>(src.as_number_signed(),
-                                              dst.as_number_signed(), cmp);
+      compare_number<detail::number_signed_t>(
+          src.as_number_signed(), dst.as_number_signed(), describe, cmp);
       if (cmp.match != MatchType::Perfect) {
-        cmp.dstValue = dst.to_string();
+        cmp.dstValue = ComparedValue(dst);
       }
       break;
 
     case touca::detail::internal_type::number_unsigned:
-      compare_number<detail::number_unsigned_t>(src.as_number_unsigned(),
-                                                dst.as_number_unsigned(), cmp);
+      compare_number<detail::number_unsigned_t>(
+          src.as_number_unsigned(), dst.as_number_unsigned(), describe, cmp);
       if (cmp.match != MatchType::Perfect) {
-        cmp.dstValue = dst.to_string();
+        cmp.dstValue = ComparedValue(dst);
       }
       break;
 
@@ -361,18 +1069,20 @@ TypeComparison compare(const data_point& src, const data_point& dst) {
         cmp.match = MatchType::Perfect;
         cmp.score = 1.0;
       } else {
-        cmp.dstValue = dst.to_string();
+        compare_strings(*src.as_string(), *dst.as_string(), describe,
+                        options, cmp);
+        cmp.dstValue = ComparedValue(dst);
       }
       break;
 
     case touca::detail::internal_type::array:
-      compare_arrays(src, dst, cmp);
+      compare_arrays(src, dst, describe, options, cmp);
       break;
 
     case touca::detail::internal_type::object:
-      compare_objects(src, dst, cmp);
+      compare_objects(src, dst, describe, options, cmp);
       if (cmp.match != MatchType::Perfect) {
-        cmp.dstValue = dst.to_string();
+        cmp.dstValue = ComparedValue(dst);
       }
       break;
 
@@ -383,31 +1093,923 @@ TypeComparison compare(const data_point& src, const data_point& dst) {
   return cmp;
 }
 
-TestcaseComparison::TestcaseComparison(const Testcase& src, const Testcase& dst)
-    : _src(src), _dst(dst) {
-  _srcMeta = _src.metadata();
-  _dstMeta = _dst.metadata();
-  // perform comparisons on assumptions
-  init_cellar(_src._resultsMap, _dst._resultsMap, ResultCategory::Assert,
-              _assumptions);
-  init_cellar(_src._resultsMap, _dst._resultsMap, ResultCategory::Check,
-              _results);
-  init_cellar(_src.metrics(), _dst.metrics(), _metrics);
+/**
+ * Compares two values on behalf of callers that may discard them right
+ * after, describing their differences and rendering them right away so
+ * that the outcome no longer refers to them.
+ */
+TypeComparison compare_detached(const data_point& src, const data_point& dst,
+                                const ComparisonOptions& options) {
+  auto cmp = compare(src, dst, true, options);
+  cmp.srcValue.freeze(options.preview_size);
+  cmp.dstValue.freeze(options.preview_size);
+  return cmp;
 }
 
-TestcaseComparison compare(const Testcase& src, const Testcase& dst) {
-  return TestcaseComparison(src, dst);
+TypeComparison compare(const data_point& src, const data_point& dst) {
+  return compare_detached(src, dst, default_options());
 }
 
-rapidjson::Value TestcaseComparison::Overview::json(
-    rapidjson::Document::AllocatorType& allocator) const {
-  rapidjson::Value out(rapidjson::kObjectType);
-  out.AddMember("keysCountCommon", keysCountCommon, allocator);
-  out.AddMember("keysCountFresh", keysCountFresh, allocator);
-  out.AddMember("keysCountMissing", keysCountMissing, allocator);
-  out.AddMember("keysScore", keysScore, allocator);
-  out.AddMember("metricsCountCommon", metricsCountCommon, allocator);
-  out.AddMember("metricsCountFresh", metricsCountFresh, allocator);
+TypeComparison compare(const data_point& src, const data_point& dst,
+                       const ComparisonOptions& options) {
+  return compare_detached(src, dst, options);
+}
+
+std::set<std::string> TypeComparison::describe() const {
+  if (described || MatchType::Perfect == match || !srcValue.value() ||
+      !dstValue.value()) {
+    return desc;
+  }
+  return compare(*srcValue.value(), *dstValue.value(), true, default_options())
+      .desc;
+}
+
+/**
+ * Number of values that are compared on one thread. Testcases with more
+ * common keys than this have their values compared in chunks of this size
+ * if the options allow more than one thread.
+ */
+constexpr std::size_t compare_chunk_size = 1024;
+
+/**
+ * Provides the pool on which to compare values of a testcase in parallel,
+ * if its entries are many enough to be split into chunks. That is the pool
+ * that runs the comparison of the testcase if there is one, so that a suite
+ * with a few large testcases keeps all threads busy. Testcases that are
+ * compared on their own get a pool of their own, which the caller keeps
+ * for the duration of the comparison.
+ *
+ * @param count number of entries that the testcases may have in common
+ * @param owned set to hold the pool if it had to be created
+ * @return `nullptr` if values are to be compared on the calling thread
+ */
+detail::ThreadPool* comparison_pool(
+    const std::size_t count, const ComparisonOptions& options,
+    std::unique_ptr<detail::ThreadPool>& owned) {
+  if (count <= compare_chunk_size || options.jobs == 1) {
+    return nullptr;
+  }
+  if (auto pool = detail::ThreadPool::current()) {
+    return pool;
+  }
+  owned.reset(new detail::ThreadPool(options.jobs));
+  return owned.get();
+}
+
+/**
+ * Calls a given function with each index below `count`. Large ranges are
+ * split into chunks that run in parallel on a given pool, if any. Each
+ * call must only write to state that belongs to its own index.
+ */
+void for_each_chunked(const std::size_t count, detail::ThreadPool* pool,
+                      const std::function<void(std::size_t)>& func) {
+  if (!pool || pool->size() <= 1 || count <= compare_chunk_size) {
+    for (std::size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::vector<std::function<void()>> tasks;
+  for (std::size_t begin = 0; begin < count; begin += compare_chunk_size) {
+    const auto end = std::min(begin + compare_chunk_size, count);
+    tasks.emplace_back([&func, begin, end]() {
+      for (auto i = begin; i < end; ++i) {
+        func(i);
+      }
+    });
+  }
+  pool->run(std::move(tasks));
+}
+
+TestcaseComparison::TestcaseComparison(const Testcase& src, const Testcase& dst,
+                                       const ComparisonOptions& options)
+    : TestcaseComparison(src, dst, options, true) {}
+
+TestcaseComparison::TestcaseComparison(const Testcase& src, const Testcase& dst,
+                                       const ComparisonOptions& options,
+                                       const bool detached)
+    : _srcMeta(src.metadata()), _dstMeta(dst.metadata()) {
+  std::unique_ptr<detail::ThreadPool> owned;
+  const auto pool = comparison_pool(
+      std::min(src._resultsMap.size(), dst._resultsMap.size()), options,
+      owned);
+  // perform comparisons on assumptions
+  init_cellar(src._resultsMap, dst._resultsMap, ResultCategory::Assert,
+              options, detached, pool, _assumptions);
+  init_cellar(src._resultsMap, dst._resultsMap, ResultCategory::Check,
+              options, detached, pool, _results);
+  const auto& srcMetrics = src.metrics();
+  const auto& dstMetrics = dst.metrics();
+  init_cellar(srcMetrics, dstMetrics, _metrics);
+  for (const auto& kvp : _metrics.common) {
+    _srcDuration +=
+        static_cast<std::int32_t>(srcMetrics.at(kvp.first).value.as_metric());
+    _dstDuration +=
+        static_cast<std::int32_t>(dstMetrics.at(kvp.first).value.as_metric());
+  }
+}
+
+template <typename Table>
+bool is_identical_vector(const void* src, const void* dst) {
+  const auto& lhs = static_cast<const Table*>(src)->values();
+  const auto& rhs = static_cast<const Table*>(dst)->values();
+  return lhs->size() == rhs->size() &&
+         std::equal(lhs->begin(), lhs->end(), rhs->begin());
+}
+
+/**
+ * Checks whether two values are identical without decoding them. Returns
+ * `false` for values that `compare` may still report as a perfect match,
+ * such as objects whose members are stored in a different order, in which
+ * case the caller is expected to fall back to the slow path.
+ */
+bool is_identical(const fbs::TypeWrapper* src, const fbs::TypeWrapper* dst,
+                  const fbs::Dictionary* srcDictionary,
+                  const fbs::Dictionary* dstDictionary) {
+  if (src->value_type() != dst->value_type()) {
+    return false;
+  }
+  const auto& is_same_string = [](const flatbuffers::String* lhs,
+                                  const flatbuffers::String* rhs) {
+    return lhs->size() == rhs->size() &&
+           0 == std::memcmp(lhs->data(), rhs->data(), lhs->size());
+  };
+  switch (src->value_type()) {
+    case fbs::Type::Bool:
+      return static_cast<const fbs::Bool*>(src->value())->value() ==
+             static_cast<const fbs::Bool*>(dst->value())->value();
+    case fbs::Type::Int:
+      return static_cast<const fbs::Int*>(src->value())->value() ==
+             static_cast<const fbs::Int*>(dst->value())->value();
+    case fbs::Type::UInt:
+      return static_cast<const fbs::UInt*>(src->value())->value() ==
+             static_cast<const fbs::UInt*>(dst->value())->value();
+    case fbs::Type::Float:
+      return static_cast<const fbs::Float*>(src->value())->value() ==
+             static_cast<const fbs::Float*>(dst->value())->value();
+    case fbs::Type::Double:
+      return static_cast<const fbs::Double*>(src->value())->value() ==
+             static_cast<const fbs::Double*>(dst->value())->value();
+    case fbs::Type::String:
+      return is_same_string(
+          static_cast<const fbs::String*>(src->value())->value(),
+          static_cast<const fbs::String*>(dst->value())->value());
+    case fbs::Type::Array: {
+      const auto& lhs = static_cast<const fbs::Array*>(src->value())->values();
+      const auto& rhs = static_cast<const fbs::Array*>(dst->value())->values();
+      if (lhs->size() != rhs->size()) {
+        return false;
+      }
+      for (flatbuffers::uoffset_t i = 0; i < lhs->size(); ++i) {
+        if (!is_identical(lhs->Get(i), rhs->Get(i), srcDictionary,
+                          dstDictionary)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case fbs::Type::Object: {
+      // similar to `compare`, we do not consider name of the objects
+      const auto& lhs = static_cast<const fbs::Object*>(src->value())->values();
+      const auto& rhs = static_cast<const fbs::Object*>(dst->value())->values();
+      if (lhs->size() != rhs->size()) {
+        return false;
+      }
+      for (flatbuffers::uoffset_t i = 0; i < lhs->size(); ++i) {
+        const auto& left = lhs->Get(i);
+        const auto& right = rhs->Get(i);
+        if (!is_same_string(lookup_string(left->name(), left->name_id(),
+                                          srcDictionary),
+                            lookup_string(right->name(), right->name_id(),
+                                          dstDictionary)) ||
+            !is_identical(left->value(), right->value(), srcDictionary,
+                          dstDictionary)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case fbs::Type::BoolVector:
+      return is_identical_vector<fbs::BoolVector>(src->value(), dst->value());
+    case fbs::Type::IntVector:
+      return is_identical_vector<fbs::IntVector>(src->value(), dst->value());
+    case fbs::Type::UIntVector:
+      return is_identical_vector<fbs::UIntVector>(src->value(), dst->value());
+    case fbs::Type::FloatVector:
+      return is_identical_vector<fbs::FloatVector>(src->value(), dst->value());
+    case fbs::Type::DoubleVector:
+      return is_identical_vector<fbs::DoubleVector>(src->value(),
+                                                    dst->value());
+    default:
+      return false;
+  }
+}
+
+touca::detail::internal_type to_internal_type(const fbs::Type type) {
+  switch (type) {
+    case fbs::Type::Bool:
+      return touca::detail::internal_type::boolean;
+    case fbs::Type::Int:
+      return touca::detail::internal_type::number_signed;
+    case fbs::Type::UInt:
+      return touca::detail::internal_type::number_unsigned;
+    case fbs::Type::Float:
+      return touca::detail::internal_type::number_float;
+    case fbs::Type::Double:
+      return touca::detail::internal_type::number_double;
+    case fbs::Type::String:
+      return touca::detail::internal_type::string;
+    case fbs::Type::Object:
+      return touca::detail::internal_type::object;
+    case fbs::Type::Array:
+    case fbs::Type::BoolVector:
+    case fbs::Type::IntVector:
+    case fbs::Type::UIntVector:
+    case fbs::Type::FloatVector:
+    case fbs::Type::DoubleVector:
+      return touca::detail::internal_type::array;
+    default:
+      return touca::detail::internal_type::unknown;
+  }
+}
+
+template <typename Table, typename Writer, typename Write>
+void write_json_vector(const void* value, Writer& writer, Write write) {
+  writer.StartArray();
+  for (const auto element : *static_cast<const Table*>(value)->values()) {
+    write(writer, element);
+  }
+  writer.EndArray();
+}
+
+/**
+ * Writes json representation of a given value into a given writer, in the
+ * same form that `data_point::to_string` would generate for its decoded
+ * equivalent.
+ */
+template <typename Writer>
+void write_json(const fbs::TypeWrapper* ptr, Writer& writer,
+                const fbs::Dictionary* dictionary) {
+  const auto& value = ptr->value();
+  switch (ptr->value_type()) {
+    case fbs::Type::Bool:
+      writer.Bool(static_cast<const fbs::Bool*>(value)->value());
+      break;
+    case fbs::Type::Int:
+      writer.Int64(static_cast<const fbs::Int*>(value)->value());
+      break;
+    case fbs::Type::UInt:
+      writer.Uint64(static_cast<const fbs::UInt*>(value)->value());
+      break;
+    case fbs::Type::Float:
+      detail::write_json_number(writer,
+                                static_cast<const fbs::Float*>(value)->value());
+      break;
+    case fbs::Type::Double:
+      detail::write_json_number(
+          writer, static_cast<const fbs::Double*>(value)->value());
+      break;
+    case fbs::Type::String:
+      writer.String(static_cast<const fbs::String*>(value)->value()->c_str());
+      break;
+    case fbs::Type::Array:
+      writer.StartArray();
+      for (const auto&& element :
+           *static_cast<const fbs::Array*>(value)->values()) {
+        write_json(element, writer, dictionary);
+      }
+      writer.EndArray();
+      break;
+    case fbs::Type::Object: {
+      // decoded objects keep their members sorted by name
+      const auto& obj = static_cast<const fbs::Object*>(value);
+      std::vector<std::pair<const char*, const fbs::TypeWrapper*>> members;
+      for (const auto&& member : *obj->values()) {
+        members.emplace_back(
+            lookup_string(member->name(), member->name_id(), dictionary)
+                ->c_str(),
+            member->value());
+      }
+      std::stable_sort(
+          members.begin(), members.end(),
+          [](const std::pair<const char*, const fbs::TypeWrapper*>& lhs,
+             const std::pair<const char*, const fbs::TypeWrapper*>& rhs) {
+            return std::strcmp(lhs.first, rhs.first) < 0;
+          });
+      const auto& key = lookup_string(obj->key(), obj->key_id(), dictionary);
+      writer.StartObject();
+      writer.Key(key ? key->c_str() : "");
+      writer.StartObject();
+      const char* previous = nullptr;
+      for (const auto& member : members) {
+        if (previous && 0 == std::strcmp(previous, member.first)) {
+          continue;
+        }
+        previous = member.first;
+        writer.Key(previous);
+        write_json(member.second, writer, dictionary);
+      }
+      writer.EndObject();
+      writer.EndObject();
+      break;
+    }
+    case fbs::Type::BoolVector:
+      write_json_vector<fbs::BoolVector>(
+          value, writer, [](Writer& out, uint8_t v) { out.Bool(v != 0); });
+      break;
+    case fbs::Type::IntVector:
+      write_json_vector<fbs::IntVector>(
+          value, writer, [](Writer& out, int64_t v) { out.Int64(v); });
+      break;
+    case fbs::Type::UIntVector:
+      write_json_vector<fbs::UIntVector>(
+          value, writer, [](Writer& out, uint64_t v) { out.Uint64(v); });
+      break;
+    case fbs::Type::FloatVector:
+      write_json_vector<fbs::FloatVector>(
+          value, writer,
+          [](Writer& out, float v) { detail::write_json_number(out, v); });
+      break;
+    case fbs::Type::DoubleVector:
+      write_json_vector<fbs::DoubleVector>(
+          value, writer,
+          [](Writer& out, double v) { detail::write_json_number(out, v); });
+      break;
+    default:
+      throw touca::detail::runtime_error("encountered unexpected type");
+  }
+}
+
+/**
+ * Renders a given value up to a given number of bytes, or in full if the
+ * given size is zero.
+ */
+ComparedValue render_value(const fbs::TypeWrapper* ptr,
+                           const fbs::Dictionary* dictionary,
+                           const std::size_t max_size) {
+  const auto limit = 0 == max_size ? std::string::npos : max_size;
+  const auto type = to_internal_type(ptr->value_type());
+  std::string out;
+  if (ptr->value_type() == fbs::Type::String) {
+    const auto& value = static_cast<const fbs::String*>(ptr->value())->value();
+    out.assign(value->data(), std::min<std::size_t>(value->size(), limit));
+    return ComparedValue(type, std::move(out), limit < value->size());
+  }
+  detail::string_output_stream stream(out, limit);
+  rapidjson::Writer<detail::string_output_stream> writer(stream);
+  writer.SetMaxDecimalPlaces(3);
+  write_json(ptr, writer, dictionary);
+  return ComparedValue(type, std::move(out), stream.truncated());
+}
+
+/**
+ * Keeps a given value up to the preview size of given options, or only its
+ * type when comparing in summary mode.
+ */
+ComparedValue keep_value(const fbs::TypeWrapper* ptr,
+                         const fbs::Dictionary* dictionary,
+                         const ComparisonOptions& options) {
+  if (options.summary_only) {
+    return ComparedValue(to_internal_type(ptr->value_type()), std::string());
+  }
+  return render_value(ptr, dictionary, options.preview_size);
+}
+
+template <typename Table>
+bool compare_packed_vectors(const void* src, const void* dst,
+                            const bool describe, TypeComparison& cmp) {
+  const auto& lhs = static_cast<const Table*>(src)->values();
+  const auto& rhs = static_cast<const Table*>(dst)->values();
+  if (lhs->size() != rhs->size()) {
+    return false;
+  }
+  compare_packed_arrays(lhs->data(), rhs->data(), lhs->size(), describe, cmp);
+  return true;
+}
+
+/**
+ * Compares two numeric vectors of the same type and size in place, without
+ * decoding their elements. Elements of flatbuffers vectors are stored in
+ * little-endian byte order, so that we can only do so on little-endian
+ * platforms.
+ *
+ * @return whether the vectors were compared
+ */
+bool compare_packed_vectors(const fbs::TypeWrapper* src,
+                            const fbs::TypeWrapper* dst, const bool describe,
+                            TypeComparison& cmp) {
+  if (!FLATBUFFERS_LITTLEENDIAN || src->value_type() != dst->value_type()) {
+    return false;
+  }
+  switch (src->value_type()) {
+    case fbs::Type::IntVector:
+      return compare_packed_vectors<fbs::IntVector>(src->value(), dst->value(),
+                                                    describe, cmp);
+    case fbs::Type::UIntVector:
+      return compare_packed_vectors<fbs::UIntVector>(
+          src->value(), dst->value(), describe, cmp);
+    case fbs::Type::FloatVector:
+      return compare_packed_vectors<fbs::FloatVector>(
+          src->value(), dst->value(), describe, cmp);
+    case fbs::Type::DoubleVector:
+      return compare_packed_vectors<fbs::DoubleVector>(
+          src->value(), dst->value(), describe, cmp);
+    default:
+      return false;
+  }
+}
+
+TypeComparison compare(const fbs::TypeWrapper* src, const fbs::TypeWrapper* dst,
+                       const fbs::Dictionary* srcDictionary,
+                       const fbs::Dictionary* dstDictionary,
+                       const ComparisonOptions& options) {
+  TypeComparison packed;
+  if (compare_packed_vectors(src, dst, !options.summary_only, packed)) {
+    packed.srcType = to_internal_type(src->value_type());
+    packed.srcValue = keep_value(src, srcDictionary, options);
+    if (MatchType::Perfect != packed.match) {
+      packed.dstValue = keep_value(dst, dstDictionary, options);
+    }
+    packed.described = !options.summary_only;
+    return packed;
+  }
+  if (!is_identical(src, dst, srcDictionary, dstDictionary)) {
+    // decoded values are discarded once compared
+    const auto& srcValue = deserialize_value(src, srcDictionary);
+    const auto& dstValue = deserialize_value(dst, dstDictionary);
+    auto cmp = compare(srcValue, dstValue, !options.summary_only, options);
+    if (options.summary_only) {
+      cmp.srcValue = ComparedValue(srcValue.type(), std::string());
+      cmp.dstValue = ComparedValue(dstValue.type(), std::string());
+    } else {
+      cmp.srcValue.freeze(options.preview_size);
+      cmp.dstValue.freeze(options.preview_size);
+    }
+    return cmp;
+  }
+  TypeComparison cmp;
+  cmp.srcType = to_internal_type(src->value_type());
+  cmp.srcValue = keep_value(src, srcDictionary, options);
+  cmp.match = MatchType::Perfect;
+  cmp.score = 1.0;
+  return cmp;
+}
+
+/**
+ * Entry of a flatbuffers results or metrics map, along with its key that
+ * may be stored in the string table of the result file.
+ */
+template <typename T>
+using KeyedEntry = std::pair<const flatbuffers::String*, const T*>;
+
+/**
+ * Provides entries of a flatbuffers results or metrics map sorted by their
+ * key, with duplicate keys removed. Entries written by this SDK are already
+ * sorted, in which case we avoid sorting them again.
+ */
+template <typename T>
+std::vector<KeyedEntry<T>> sort_entries(
+    const flatbuffers::Vector<flatbuffers::Offset<T>>* entries,
+    const fbs::Dictionary* dictionary) {
+  std::vector<KeyedEntry<T>> out;
+  out.reserve(entries->size());
+  for (const auto&& entry : *entries) {
+    out.emplace_back(lookup_string(entry->key(), entry->key_id(), dictionary),
+                     entry);
+  }
+  const auto& less = [](const KeyedEntry<T>& lhs, const KeyedEntry<T>& rhs) {
+    return *lhs.first < *rhs.first;
+  };
+  if (!std::is_sorted(out.begin(), out.end(), less)) {
+    std::stable_sort(out.begin(), out.end(), less);
+  }
+  const auto& equal = [&less](const KeyedEntry<T>& lhs,
+                              const KeyedEntry<T>& rhs) {
+    return !less(lhs, rhs) && !less(rhs, lhs);
+  };
+  out.erase(std::unique(out.begin(), out.end(), equal), out.end());
+  return out;
+}
+
+/**
+ * Performs a merge join of sorted entries of two flatbuffers results or
+ * metrics maps, following the same rules as `init_cellar`: entries are
+ * included based on their category in `dst` if they are common, and based
+ * on their category in `src` if they are fresh.
+ */
+template <typename T, typename Filter>
+void merge_entries(const std::vector<KeyedEntry<T>>& src,
+                   const std::vector<KeyedEntry<T>>& dst,
+                   const fbs::Dictionary* srcDictionary,
+                   const fbs::Dictionary* dstDictionary, Filter include,
+                   const ComparisonOptions& options, detail::ThreadPool* pool,
+                   Cellar& result) {
+  std::vector<std::pair<const KeyedEntry<T>*, const KeyedEntry<T>*>> common;
+  auto i = src.begin();
+  auto j = dst.begin();
+  while (i != src.end() || j != dst.end()) {
+    if (j == dst.end() || (i != src.end() && *i->first < *j->first)) {
+      if (include(i->second)) {
+        result.fresh.emplace(
+            i->first->str(),
+            keep_value(i->second->value(), srcDictionary, options));
+      }
+      ++i;
+    } else if (i == src.end() || *j->first < *i->first) {
+      if (include(j->second)) {
+        result.missing.emplace(
+            j->first->str(),
+            keep_value(j->second->value(), dstDictionary, options));
+      }
+      ++j;
+    } else {
+      if (include(j->second)) {
+        common.emplace_back(&*i, &*j);
+      }
+      ++i;
+      ++j;
+    }
+  }
+  std::vector<TypeComparison> comparisons(common.size());
+  for_each_chunked(common.size(), pool,
+                   [&common, &comparisons, srcDictionary, dstDictionary,
+                    &options](const std::size_t k) {
+                     comparisons[k] = compare(common[k].first->second->value(),
+                                              common[k].second->second->value(),
+                                              srcDictionary, dstDictionary,
+                                              options);
+                   });
+  result.common.reserve(common.size());
+  for (std::size_t k = 0; k < common.size(); ++k) {
+    result.common.emplace(common[k].second->first->str(),
+                          std::move(comparisons[k]));
+  }
+}
+
+std::int32_t metric_duration(const fbs::Metric* metric) {
+  if (metric->value()->value_type() != fbs::Type::Int) {
+    throw touca::detail::runtime_error("failed to parse metrics map entry");
+  }
+  return static_cast<std::int32_t>(
+      static_cast<const fbs::Int*>(metric->value()->value())->value());
+}
+
+void update_digest(detail::xxh64& state, const flatbuffers::String* value) {
+  const std::uint32_t size = value ? value->size() : 0u;
+  update_digest(state, size);
+  if (value) {
+    state.update(value->data(), size);
+  }
+}
+
+template <typename Table>
+void update_digest_vector(detail::xxh64& state, const void* value) {
+  const auto& values = static_cast<const Table*>(value)->values();
+  update_digest(state, values->size());
+  state.update(values->data(), values->size() * sizeof(*values->data()));
+}
+
+/**
+ * Feeds a given value into a given digest. Strings that may be stored in
+ * the string table of the result file are fed as they are, so that the
+ * same value has the same digest in any result file.
+ */
+void update_digest(detail::xxh64& state, const fbs::TypeWrapper* ptr,
+                   const fbs::Dictionary* dictionary) {
+  const auto& value = ptr->value();
+  update_digest(state, ptr->value_type());
+  switch (ptr->value_type()) {
+    case fbs::Type::Bool:
+      update_digest(state, static_cast<const fbs::Bool*>(value)->value());
+      break;
+    case fbs::Type::Int:
+      update_digest(state, static_cast<const fbs::Int*>(value)->value());
+      break;
+    case fbs::Type::UInt:
+      update_digest(state, static_cast<const fbs::UInt*>(value)->value());
+      break;
+    case fbs::Type::Float:
+      update_digest(state, static_cast<const fbs::Float*>(value)->value());
+      break;
+    case fbs::Type::Double:
+      update_digest(state, static_cast<const fbs::Double*>(value)->value());
+      break;
+    case fbs::Type::String:
+      update_digest(state, static_cast<const fbs::String*>(value)->value());
+      break;
+    case fbs::Type::Array: {
+      const auto& values = static_cast<const fbs::Array*>(value)->values();
+      update_digest(state, values->size());
+      for (const auto&& element : *values) {
+        update_digest(state, element, dictionary);
+      }
+      break;
+    }
+    case fbs::Type::Object: {
+      const auto& obj = static_cast<const fbs::Object*>(value);
+      update_digest(state,
+                    lookup_string(obj->key(), obj->key_id(), dictionary));
+      update_digest(state, obj->values()->size());
+      for (const auto&& member : *obj->values()) {
+        update_digest(state, lookup_string(member->name(), member->name_id(),
+                                           dictionary));
+        update_digest(state, member->value(), dictionary);
+      }
+      break;
+    }
+    case fbs::Type::BoolVector:
+      update_digest_vector<fbs::BoolVector>(state, value);
+      break;
+    case fbs::Type::IntVector:
+      update_digest_vector<fbs::IntVector>(state, value);
+      break;
+    case fbs::Type::UIntVector:
+      update_digest_vector<fbs::UIntVector>(state, value);
+      break;
+    case fbs::Type::FloatVector:
+      update_digest_vector<fbs::FloatVector>(state, value);
+      break;
+    case fbs::Type::DoubleVector:
+      update_digest_vector<fbs::DoubleVector>(state, value);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * Computes digest of the assertions and results of a testcase, in the
+ * order in which they are compared, regardless of its metadata and metrics.
+ */
+std::uint64_t digest_results(
+    const std::vector<KeyedEntry<fbs::Result>>& entries,
+    const fbs::Dictionary* dictionary) {
+  detail::xxh64 state;
+  update_digest(state, entries.size());
+  for (const auto& entry : entries) {
+    update_digest(state, entry.first);
+    update_digest(state, entry.second->typ());
+    update_digest(state, entry.second->value(), dictionary);
+  }
+  return state.digest();
+}
+
+std::string detail::comparison_cache_key(const std::uint64_t srcDigest,
+                                         const std::uint64_t dstDigest,
+                                         const ComparisonOptions& options,
+                                         const std::uint32_t version) {
+  detail::xxh64 state;
+  update_digest(state, version);
+  update_digest(state, static_cast<std::uint64_t>(options.preview_size));
+  update_digest(state, options.summary_only);
+  update_digest(state, options.array_alignment);
+  update_digest(state, options.identity_member);
+  update_digest(state, static_cast<std::uint64_t>(options.max_hunks));
+  update_digest(state, static_cast<std::uint64_t>(options.max_line_edits));
+  return touca::detail::format("{:016x}{:016x}{:016x}", srcDigest, dstDigest,
+                               state.digest());
+}
+
+template <typename T>
+void write_number(std::vector<std::uint8_t>& out, const T value) {
+  const auto& bytes = reinterpret_cast<const std::uint8_t*>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(value));
+}
+
+void write_string(std::vector<std::uint8_t>& out, const std::string& value) {
+  write_number(out, static_cast<std::uint64_t>(value.size()));
+  out.insert(out.end(), value.begin(), value.end());
+}
+
+void write_value(std::vector<std::uint8_t>& out, const ComparedValue& value) {
+  write_number(out, value.type());
+  write_number(out, value.truncated());
+  write_string(out, value.preview());
+}
+
+/**
+ * Writes given comparison results in a form that `read_cellar` can
+ * restore. Values must already be rendered, as they are when testcases
+ * are compared on their flatbuffers representation. Numbers are written
+ * in the byte order of this platform, since cached results are not meant
+ * to be moved to other machines.
+ */
+void write_cellar(std::vector<std::uint8_t>& out, const Cellar& cellar) {
+  write_number(out, static_cast<std::uint64_t>(cellar.common.size()));
+  for (const auto& kvp : cellar.common) {
+    const auto& cmp = kvp.second;
+    write_string(out, kvp.first);
+    write_value(out, cmp.srcValue);
+    write_value(out, cmp.dstValue);
+    write_number(out, cmp.srcType);
+    write_number(out, cmp.dstType);
+    write_number(out, cmp.score);
+    write_number(out, cmp.match);
+    write_number(out, cmp.described);
+    write_number(out, static_cast<std::uint64_t>(cmp.desc.size()));
+    for (const auto& desc : cmp.desc) {
+      write_string(out, desc);
+    }
+  }
+  for (const auto* keys : {&cellar.missing, &cellar.fresh}) {
+    write_number(out, static_cast<std::uint64_t>(keys->size()));
+    for (const auto& kvp : *keys) {
+      write_string(out, kvp.first);
+      write_value(out, kvp.second);
+    }
+  }
+}
+
+/**
+ * Reads content written by `write_cellar`, without ever reading past its
+ * end.
+ */
+class cellar_reader {
+ public:
+  explicit cellar_reader(const std::vector<std::uint8_t>& content)
+      : _pos(content.data()), _end(content.data() + content.size()) {}
+
+  bool done() const { return _pos == _end; }
+
+  template <typename T>
+  bool read(T& value) {
+    if (static_cast<std::size_t>(_end - _pos) < sizeof(value)) {
+      return false;
+    }
+    std::memcpy(&value, _pos, sizeof(value));
+    _pos += sizeof(value);
+    return true;
+  }
+
+  bool read(std::string& value) {
+    std::uint64_t size = 0;
+    if (!read(size) || static_cast<std::uint64_t>(_end - _pos) < size) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(_pos),
+                 static_cast<std::size_t>(size));
+    _pos += size;
+    return true;
+  }
+
+  bool read(ComparedValue& value) {
+    auto type = touca::detail::internal_type::unknown;
+    bool truncated = false;
+    std::string preview;
+    if (!read(type) || !read(truncated) || !read(preview)) {
+      return false;
+    }
+    value = ComparedValue(type, std::move(preview), truncated);
+    return true;
+  }
+
+  bool read(Cellar& cellar) {
+    std::uint64_t count = 0;
+    if (!read(count)) {
+      return false;
+    }
+    for (std::uint64_t i = 0; i < count; ++i) {
+      std::string key;
+      TypeComparison cmp;
+      std::uint64_t descCount = 0;
+      if (!read(key) || !read(cmp.srcValue) || !read(cmp.dstValue) ||
+          !read(cmp.srcType) || !read(cmp.dstType) || !read(cmp.score) ||
+          !read(cmp.match) || !read(cmp.described) || !read(descCount)) {
+        return false;
+      }
+      for (std::uint64_t j = 0; j < descCount; ++j) {
+        std::string desc;
+        if (!read(desc)) {
+          return false;
+        }
+        cmp.desc.insert(std::move(desc));
+      }
+      cellar.common.emplace(std::move(key), std::move(cmp));
+    }
+    for (auto* keys : {&cellar.missing, &cellar.fresh}) {
+      if (!read(count)) {
+        return false;
+      }
+      for (std::uint64_t i = 0; i < count; ++i) {
+        std::string key;
+        ComparedValue value;
+        if (!read(key) || !read(value)) {
+          return false;
+        }
+        keys->emplace(std::move(key), std::move(value));
+      }
+    }
+    return true;
+  }
+
+ private:
+  const std::uint8_t* _pos;
+  const std::uint8_t* _end;
+};
+
+/**
+ * Restores comparison results of assertions and results that were kept in
+ * the comparison cache, leaving both cellars empty if the cached content
+ * is not as expected.
+ */
+bool read_cellars(const std::vector<std::uint8_t>& content,
+                  Cellar& assumptions, Cellar& results) {
+  cellar_reader reader(content);
+  if (reader.read(assumptions) && reader.read(results) && reader.done()) {
+    return true;
+  }
+  assumptions = Cellar();
+  results = Cellar();
+  return false;
+}
+
+TestcaseComparison::TestcaseComparison(const fbs::Message& src,
+                                       const fbs::Message& dst,
+                                       const fbs::Dictionary* srcDictionary,
+                                       const fbs::Dictionary* dstDictionary,
+                                       const ComparisonOptions& options,
+                                       detail::ComparisonCache* cache)
+    : _srcMeta(deserialize_metadata(src.metadata(), srcDictionary)),
+      _dstMeta(deserialize_metadata(dst.metadata(), dstDictionary)) {
+  const auto& srcResults =
+      sort_entries(src.results()->entries(), srcDictionary);
+  const auto& dstResults =
+      sort_entries(dst.results()->entries(), dstDictionary);
+  std::unique_ptr<detail::ThreadPool> owned;
+  const auto pool = comparison_pool(
+      std::min(srcResults.size(), dstResults.size()), options, owned);
+  auto cached = false;
+  std::string key;
+  if (cache) {
+    key = detail::comparison_cache_key(
+        digest_results(srcResults, srcDictionary),
+        digest_results(dstResults, dstDictionary), options);
+    std::vector<std::uint8_t> content;
+    cached = cache->load(key, content) &&
+             read_cellars(content, _assumptions, _results);
+  }
+  if (!cached) {
+    merge_entries(
+        srcResults, dstResults, srcDictionary, dstDictionary,
+        [](const fbs::Result* entry) {
+          return entry->typ() == fbs::ResultType::Assert;
+        },
+        options, pool, _assumptions);
+    merge_entries(
+        srcResults, dstResults, srcDictionary, dstDictionary,
+        [](const fbs::Result* entry) {
+          return entry->typ() != fbs::ResultType::Assert;
+        },
+        options, pool, _results);
+  }
+  if (cache && !cached) {
+    std::vector<std::uint8_t> content;
+    write_cellar(content, _assumptions);
+    write_cellar(content, _results);
+    cache->store(key, content);
+  }
+
+  const auto& srcMetrics =
+      sort_entries(src.metrics()->entries(), srcDictionary);
+  const auto& dstMetrics =
+      sort_entries(dst.metrics()->entries(), dstDictionary);
+  merge_entries(
+      srcMetrics, dstMetrics, srcDictionary, dstDictionary,
+      [](const fbs::Metric*) { return true; }, options, nullptr, _metrics);
+  for (const auto& metric : srcMetrics) {
+    if (_metrics.common.count(metric.first->str())) {
+      _srcDuration += metric_duration(metric.second);
+    }
+  }
+  for (const auto& metric : dstMetrics) {
+    if (_metrics.common.count(metric.first->str())) {
+      _dstDuration += metric_duration(metric.second);
+    }
+  }
+}
+
+TestcaseComparison::TestcaseComparison(
+    const std::shared_ptr<const Testcase>& src,
+    const std::shared_ptr<const Testcase>& dst,
+    const ComparisonOptions& options)
+    : TestcaseComparison(*src, *dst, options, false) {
+  _src = src;
+  _dst = dst;
+}
+
+TestcaseComparison compare(const Testcase& src, const Testcase& dst) {
+  return TestcaseComparison(src, dst);
+}
+
+rapidjson::Value TestcaseComparison::Overview::json(
+    rapidjson::Document::AllocatorType& allocator) const {
+  rapidjson::Value out(rapidjson::kObjectType);
+  out.AddMember("keysCountCommon", keysCountCommon, allocator);
+  out.AddMember("keysCountFresh", keysCountFresh, allocator);
+  out.AddMember("keysCountMissing", keysCountMissing, allocator);
+  out.AddMember("keysScore", keysScore, allocator);
+  out.AddMember("metricsCountCommon", metricsCountCommon, allocator);
+  out.AddMember("metricsCountFresh", metricsCountFresh, allocator);
   out.AddMember("metricsCountMissing", metricsCountMissing, allocator);
   out.AddMember("metricsDurationCommonDst", metricsDurationCommonDst,
                 allocator);
@@ -417,13 +2019,15 @@ rapidjson::Value TestcaseComparison::Overview::json(
 }
 
 rapidjson::Value TestcaseComparison::json(
-    rapidjson::Document::AllocatorType& allocator) const {
+    rapidjson::Document::AllocatorType& allocator,
+    const std::size_t max_size) const {
   rapidjson::Value out(rapidjson::kObjectType);
   out.AddMember("src", _srcMeta.json(allocator), allocator);
   out.AddMember("dst", _dstMeta.json(allocator), allocator);
-  out.AddMember("assertions", _assumptions.json(allocator), allocator);
-  out.AddMember("results", _results.json(allocator), allocator);
-  out.AddMember("metrics", _metrics.json(allocator), allocator);
+  out.AddMember("assertions", _assumptions.json(allocator, max_size),
+                allocator);
+  out.AddMember("results", _results.json(allocator, max_size), allocator);
+  out.AddMember("metrics", _metrics.json(allocator, max_size), allocator);
   return out;
 }
 
@@ -462,19 +2066,8 @@ TestcaseComparison::Overview TestcaseComparison::overview() const {
   output.metricsCountFresh = count(_metrics.fresh.size());
   output.metricsCountMissing = count(_metrics.missing.size());
 
-  const auto getTotalCommonDuration = [this](const Testcase& tc) {
-    namespace chr = std::chrono;
-    std::int32_t duration = 0U;
-    for (const auto& kvp : _metrics.common) {
-      const auto& diff = tc._tocs.at(kvp.first) - tc._tics.at(kvp.first);
-      duration += static_cast<std::int32_t>(
-          chr::duration_cast<chr::milliseconds>(diff).count());
-    }
-    return duration;
-  };
-
-  output.metricsDurationCommonSrc = getTotalCommonDuration(_src);
-  output.metricsDurationCommonDst = getTotalCommonDuration(_dst);
+  output.metricsDurationCommonSrc = _srcDuration;
+  output.metricsDurationCommonDst = _dstDuration;
 
   return output;
 }
@@ -482,17 +2075,27 @@ TestcaseComparison::Overview TestcaseComparison::overview() const {
 void TestcaseComparison::init_cellar(const ResultsMap& src,
                                      const ResultsMap& dst,
                                      const ResultCategory& type,
+                                     const ComparisonOptions& options,
+                                     const bool detached,
+                                     detail::ThreadPool* pool,
                                      Cellar& result) {
+  std::vector<std::pair<const ResultEntry*, const ResultsMap::value_type*>>
+      common;
   for (const auto& kv : dst) {
     if (kv.second.typ != type) {
       continue;
     }
     const auto& key = kv.first;
-    if (src.count(key)) {
-      result.common.emplace(key, compare(src.at(key).val, kv.second.val));
+    const auto other = src.find(key);
+    if (other != src.end()) {
+      common.emplace_back(&other->second, &kv);
       continue;
     }
-    result.missing.emplace(key, kv.second.val);
+    ComparedValue value(kv.second.val);
+    if (detached) {
+      value.freeze(options.preview_size);
+    }
+    result.missing.emplace(key, std::move(value));
   }
   for (const auto& kv : src) {
     if (kv.second.typ != type) {
@@ -500,39 +2103,99 @@ void TestcaseComparison::init_cellar(const ResultsMap& src,
     }
     const auto& key = kv.first;
     if (!dst.count(key)) {
-      result.fresh.emplace(key, kv.second.val);
+      ComparedValue value(kv.second.val);
+      if (detached) {
+        value.freeze(options.preview_size);
+      }
+      result.fresh.emplace(key, std::move(value));
     }
   }
+  // values may be compared on other threads but only this thread writes to
+  // the cellar, once all of them are compared.
+  const auto describe = describes(options);
+  std::vector<TypeComparison> comparisons(common.size());
+  for_each_chunked(
+      common.size(), pool,
+      [&common, &comparisons, describe, detached,
+       &options](const std::size_t k) {
+        const auto& src = common[k].first->val;
+        const auto& dst = common[k].second->second.val;
+        comparisons[k] = detached ? compare_detached(src, dst, options)
+                                  : compare(src, dst, describe, options);
+      });
+  result.common.reserve(common.size());
+  for (std::size_t k = 0; k < common.size(); ++k) {
+    result.common.emplace(common[k].second->first, std::move(comparisons[k]));
+  }
 }
 
 void TestcaseComparison::init_cellar(const MetricsMap& src,
                                      const MetricsMap& dst, Cellar& result) {
+  // metrics are computed on demand and do not outlive the comparison, so
+  // they are described and rendered right away even in summary mode.
   for (const auto& kv : dst) {
     const auto& key = kv.first;
     if (src.count(key)) {
       result.common.emplace(key, compare(src.at(key).value, kv.second.value));
       continue;
     }
-    result.missing.emplace(key, kv.second.value);
+    ComparedValue value(kv.second.value);
+    value.freeze();
+    result.missing.emplace(key, std::move(value));
   }
   for (const auto& kv : src) {
     const auto& key = kv.first;
     if (!dst.count(key)) {
-      result.fresh.emplace(key, kv.second.value);
+      ComparedValue value(kv.second.value);
+      value.freeze();
+      result.fresh.emplace(key, std::move(value));
     }
   }
 }
 
-ElementsMapComparison compare(const ElementsMap& src, const ElementsMap& dst) {
+/**
+ * Compares testcases with given names, in sorted order, on as many threads
+ * as the options allow. Comparison results are collected in the order of
+ * their names regardless of the order in which they complete.
+ */
+void compare_common(
+    const std::vector<std::string>& names, const ComparisonOptions& options,
+    const std::function<TestcaseComparison(const std::string&)>& compare_pair,
+    std::map<std::string, TestcaseComparison>& common) {
+  std::vector<std::unique_ptr<TestcaseComparison>> results(names.size());
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(names.size());
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    tasks.emplace_back([&names, &compare_pair, &results, i]() {
+      results[i].reset(new TestcaseComparison(compare_pair(names[i])));
+    });
+  }
+  detail::ThreadPool(options.jobs).run(std::move(tasks));
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    common.emplace_hint(common.end(), names[i], std::move(*results[i]));
+  }
+}
+
+ElementsMapComparison compare(const ElementsMap& src, const ElementsMap& dst,
+                              const ComparisonOptions& options) {
   ElementsMapComparison cmp;
+  cmp.previewSize = options.preview_size;
+  cmp.summaryOnly = options.summary_only;
+  std::vector<std::string> common;
   for (const auto& tc : src) {
     const auto& key = tc.first;
     if (dst.count(key)) {
-      cmp.common.emplace(key, TestcaseComparison(*tc.second, *dst.at(key)));
+      common.push_back(key);
       continue;
     }
     cmp.fresh.emplace(tc);
   }
+  compare_common(
+      common, options,
+      [&src, &dst, &options](const std::string& key) {
+        return TestcaseComparison(src.at(key), dst.at(key), options);
+      },
+      cmp.common);
   for (const auto& tc : dst) {
     const auto& key = tc.first;
     if (!src.count(key)) {
@@ -542,6 +2205,569 @@ ElementsMapComparison compare(const ElementsMap& src, const ElementsMap& dst) {
   return cmp;
 }
 
+/**
+ * Provides the testcases in the content of a given result file, indexed by
+ * their name. Similar to `deserialize_file`, if two messages share the same
+ * testcase name, we only keep the first one. Compressed testcases are
+ * decompressed into `storage`.
+ */
+std::map<std::string, const fbs::Message*> index_messages(
+    const std::string& content, std::deque<std::vector<uint8_t>>& storage,
+    const bool verify) {
+  std::map<std::string, const fbs::Message*> out;
+  for_each_message(content, verify,
+                   [&out, &storage](const fbs::Message* message,
+                                    std::vector<std::uint8_t>& buffer) {
+                     if (!buffer.empty()) {
+                       storage.emplace_back(std::move(buffer));
+                     }
+                     out.emplace(message->metadata()->testcase()->str(),
+                                 message);
+                   });
+  return out;
+}
+
+ElementsMapComparison compare_files(const touca::filesystem::path& src,
+                                    const touca::filesystem::path& dst,
+                                    const VerifyMode mode) {
+  ComparisonOptions options;
+  options.verify = mode;
+  return compare_files(src, dst, options);
+}
+
+/**
+ * Serialized testcases of a result file. Testcases of files with a footer
+ * index are read from disk one at a time when they are asked for, each
+ * checked against its own digest. Other files are loaded in their entirety
+ * and, unless they are in json format, indexed by name of their testcases.
+ */
+class result_file_source {
+ public:
+  result_file_source(const touca::filesystem::path& path,
+                     const VerifyMode mode)
+      : _reader(path, mode) {
+    if (indexed()) {
+      return;
+    }
+    _content = load_result_file(path, mode, _verify);
+    if (!is_json()) {
+      _messages = index_messages(_content, _storage, _verify);
+      _dictionary = find_dictionary(_content);
+    }
+  }
+
+  // messages point into the content of this object
+  result_file_source(const result_file_source&) = delete;
+  result_file_source& operator=(const result_file_source&) = delete;
+
+  bool is_json() const { return !indexed() && is_json_result(_content); }
+
+  /** @return names of the testcases in the file, in sorted order */
+  std::vector<std::string> names() const {
+    std::vector<std::string> out;
+    if (indexed()) {
+      for (const auto& kvp : _reader.index()) {
+        out.push_back(kvp.first);
+      }
+    }
+    for (const auto& kvp : _messages) {
+      out.push_back(kvp.first);
+    }
+    return out;
+  }
+
+  const fbs::Dictionary* dictionary() const {
+    return indexed() ? _reader.dictionary() : _dictionary;
+  }
+
+  /**
+   * @param buffer set to hold the testcase if it has to be read from disk
+   * @return pointer into either `buffer` or the content of this object
+   */
+  const fbs::Message* message(const std::string& name,
+                              std::vector<std::uint8_t>& buffer) const {
+    if (!indexed()) {
+      return _messages.at(name);
+    }
+    buffer = _reader.read_message(name);
+    return flatbuffers::GetRoot<fbs::Message>(buffer.data());
+  }
+
+  /** decodes only the metadata of a given testcase */
+  Testcase::Metadata metadata(const std::string& name) const {
+    std::vector<std::uint8_t> buffer;
+    return deserialize_metadata(message(name, buffer)->metadata(),
+                                dictionary());
+  }
+
+  std::shared_ptr<Testcase> testcase(const std::string& name) const {
+    std::vector<std::uint8_t> buffer;
+    return std::make_shared<Testcase>(
+        deserialize_testcase(*message(name, buffer), dictionary()));
+  }
+
+  /** decodes all testcases of the file, releasing its loaded content */
+  ElementsMap testcases() {
+    if (!indexed()) {
+      return deserialize_content(std::move(_content), _verify);
+    }
+    ElementsMap out;
+    for (const auto& kvp : _reader.index()) {
+      out.emplace(kvp.first, testcase(kvp.first));
+    }
+    return out;
+  }
+
+ private:
+  bool indexed() const { return !_reader.index().empty(); }
+
+  ResultFileReader _reader;
+  bool _verify = false;
+  std::string _content;
+  std::deque<std::vector<uint8_t>> _storage;
+  std::map<std::string, const fbs::Message*> _messages;
+  const fbs::Dictionary* _dictionary = nullptr;
+};
+
+/**
+ * Testcases of two result files, listed in the order of their names by
+ * whether they are fresh, missing or common. Testcases of binary result
+ * files are decoded one at a time when they are asked for, and read from
+ * disk one at a time if their file has a footer index, so that callers who
+ * let go of them use memory that does not grow with the number of
+ * testcases. Their comparison results are kept in the comparison cache if
+ * the options name a cache directory.
+ */
+class result_file_pair {
+ public:
+  result_file_pair(const touca::filesystem::path& src,
+                   const touca::filesystem::path& dst,
+                   const ComparisonOptions& options)
+      : _options(options),
+        _src(src, options.verify),
+        _dst(dst, options.verify) {
+    // json result files have no flatbuffers representation to compare.
+    // their numbers take the types of their counterparts in the other file.
+    if (_src.is_json() || _dst.is_json()) {
+      load_testcases();
+      return;
+    }
+    list_names(_src.names(), _dst.names());
+    if (!options.cache_directory.empty()) {
+      _cache = detail::make_unique<detail::ComparisonCache>(
+          options.cache_directory, options.cache_size);
+    }
+  }
+
+  result_file_pair(const result_file_pair&) = delete;
+  result_file_pair& operator=(const result_file_pair&) = delete;
+
+  const std::vector<std::string>& fresh() const { return _fresh; }
+  const std::vector<std::string>& missing() const { return _missing; }
+  const std::vector<std::string>& common() const { return _common; }
+
+  Testcase::Metadata src_metadata(const std::string& name) const {
+    return _decoded ? _srcTestcases.at(name)->metadata() : _src.metadata(name);
+  }
+
+  Testcase::Metadata dst_metadata(const std::string& name) const {
+    return _decoded ? _dstTestcases.at(name)->metadata() : _dst.metadata(name);
+  }
+
+  std::shared_ptr<Testcase> src_testcase(const std::string& name) const {
+    return _decoded ? _srcTestcases.at(name) : _src.testcase(name);
+  }
+
+  std::shared_ptr<Testcase> dst_testcase(const std::string& name) const {
+    return _decoded ? _dstTestcases.at(name) : _dst.testcase(name);
+  }
+
+  TestcaseComparison compare(const std::string& name) const {
+    if (_decoded) {
+      return TestcaseComparison(_srcTestcases.at(name),
+                                _dstTestcases.at(name), _options);
+    }
+    // the comparison keeps nothing of the messages it is given
+    std::vector<std::uint8_t> srcBuffer;
+    std::vector<std::uint8_t> dstBuffer;
+    return TestcaseComparison(
+        *_src.message(name, srcBuffer), *_dst.message(name, dstBuffer),
+        _src.dictionary(), _dst.dictionary(), _options, _cache.get());
+  }
+
+ private:
+  void load_testcases() {
+    _decoded = true;
+    const auto srcJson = _src.is_json();
+    const auto dstJson = _dst.is_json();
+    _srcTestcases = _src.testcases();
+    _dstTestcases = _dst.testcases();
+    const auto& sorted = [](const ElementsMap& testcases) {
+      std::vector<std::string> out;
+      for (const auto& kvp : testcases) {
+        out.push_back(kvp.first);
+      }
+      std::sort(out.begin(), out.end());
+      return out;
+    };
+    list_names(sorted(_srcTestcases), sorted(_dstTestcases));
+    for (const auto& name : _common) {
+      const auto& src = _srcTestcases.at(name);
+      const auto& dst = _dstTestcases.at(name);
+      if (srcJson && !dstJson) {
+        src->conform_numbers(*dst);
+      } else if (dstJson && !srcJson) {
+        dst->conform_numbers(*src);
+      }
+    }
+  }
+
+  /** walks two sorted lists of names side by side */
+  void list_names(const std::vector<std::string>& src,
+                  const std::vector<std::string>& dst) {
+    auto i = src.begin();
+    auto j = dst.begin();
+    while (i != src.end() || j != dst.end()) {
+      if (j == dst.end() || (i != src.end() && *i < *j)) {
+        _fresh.push_back(*i);
+        ++i;
+      } else if (i == src.end() || *j < *i) {
+        _missing.push_back(*j);
+        ++j;
+      } else {
+        _common.push_back(*i);
+        ++i;
+        ++j;
+      }
+    }
+  }
+
+  ComparisonOptions _options;
+  result_file_source _src;
+  result_file_source _dst;
+  bool _decoded = false;
+  ElementsMap _srcTestcases;
+  ElementsMap _dstTestcases;
+  std::unique_ptr<detail::ComparisonCache> _cache;
+  std::vector<std::string> _fresh;
+  std::vector<std::string> _missing;
+  std::vector<std::string> _common;
+};
+
+ElementsMapComparison compare_files(const touca::filesystem::path& src,
+                                    const touca::filesystem::path& dst,
+                                    const ComparisonOptions& options) {
+  const result_file_pair files(src, dst, options);
+  ElementsMapComparison cmp;
+  cmp.previewSize = options.preview_size;
+  cmp.summaryOnly = options.summary_only;
+  for (const auto& name : files.fresh()) {
+    cmp.fresh.emplace(name, files.src_testcase(name));
+  }
+  for (const auto& name : files.missing()) {
+    cmp.missing.emplace(name, files.dst_testcase(name));
+  }
+  compare_common(
+      files.common(), options,
+      [&files](const std::string& name) { return files.compare(name); },
+      cmp.common);
+  return cmp;
+}
+
+/**
+ * Builds comparison results of two result files in binary format, as
+ * flatbuffers data of type `fbs::FileComparison`. Comparison results of
+ * common testcases may be discarded as soon as they are added.
+ */
+class comparison_builder {
+ public:
+  comparison_builder(const std::size_t preview_size, const bool summary_only)
+      : _previewSize(preview_size), _summaryOnly(summary_only) {}
+
+  void add_fresh(const Testcase::Metadata& meta) {
+    _fresh.push_back(build_metadata(meta));
+  }
+
+  void add_missing(const Testcase::Metadata& meta) {
+    _missing.push_back(build_metadata(meta));
+  }
+
+  /**
+   * Adds the comparison result of a common testcase along with its
+   * overview, or its overview alone if `summary_only` is set.
+   */
+  void add_common(const std::string& name, const TestcaseComparison& cmp) {
+    const auto& overview = build_overview(cmp.overview());
+    flatbuffers::Offset<fbs::Metadata> src;
+    flatbuffers::Offset<fbs::Metadata> dst;
+    flatbuffers::Offset<fbs::KeyComparisons> assertions;
+    flatbuffers::Offset<fbs::KeyComparisons> results;
+    flatbuffers::Offset<fbs::KeyComparisons> metrics;
+    if (!_summaryOnly) {
+      src = build_metadata(cmp._srcMeta);
+      dst = build_metadata(cmp._dstMeta);
+      assertions = build_cellar(cmp._assumptions);
+      results = build_cellar(cmp._results);
+      metrics = build_cellar(cmp._metrics);
+    }
+    const auto& fbsName = _builder.CreateString(name);
+    _common.push_back(fbs::CreateCaseComparison(_builder, fbsName, overview,
+                                                src, dst, assertions, results,
+                                                metrics));
+  }
+
+  std::vector<std::uint8_t> finish() {
+    const auto& fresh = _builder.CreateVector(_fresh);
+    const auto& missing = _builder.CreateVector(_missing);
+    const auto& common = _builder.CreateVectorOfSortedTables(&_common);
+    _builder.Finish(
+        fbs::CreateFileComparison(_builder, fresh, missing, common));
+    const auto& ptr = _builder.GetBufferPointer();
+    return {ptr, ptr + _builder.GetSize()};
+  }
+
+ private:
+  static fbs::ValueType value_type(const touca::detail::internal_type type) {
+    switch (type) {
+      case touca::detail::internal_type::boolean:
+        return fbs::ValueType::Bool;
+      case touca::detail::internal_type::number_signed:
+      case touca::detail::internal_type::number_unsigned:
+      case touca::detail::internal_type::number_float:
+      case touca::detail::internal_type::number_double:
+        return fbs::ValueType::Number;
+      case touca::detail::internal_type::string:
+        return fbs::ValueType::String;
+      case touca::detail::internal_type::array:
+        return fbs::ValueType::Array;
+      case touca::detail::internal_type::object:
+        return fbs::ValueType::Object;
+      default:
+        return fbs::ValueType::Unknown;
+    }
+  }
+
+  flatbuffers::Offset<fbs::Metadata> build_metadata(
+      const Testcase::Metadata& meta) {
+    return fbs::CreateMetadataDirect(
+        _builder, meta.testsuite.c_str(), meta.version.c_str(),
+        meta.testcase.c_str(), meta.builtAt.c_str(), meta.teamslug.c_str());
+  }
+
+  flatbuffers::Offset<fbs::ComparisonOverview> build_overview(
+      const TestcaseComparison::Overview& overview) {
+    return fbs::CreateComparisonOverview(
+        _builder, overview.keysScore, overview.keysCountCommon,
+        overview.keysCountFresh, overview.keysCountMissing,
+        overview.metricsCountCommon, overview.metricsCountFresh,
+        overview.metricsCountMissing, overview.metricsDurationCommonDst,
+        overview.metricsDurationCommonSrc);
+  }
+
+  flatbuffers::Offset<fbs::KeyComparisons> build_cellar(const Cellar& cellar) {
+    std::vector<flatbuffers::Offset<fbs::KeyComparison>> common;
+    std::vector<flatbuffers::Offset<fbs::KeyComparison>> missing;
+    std::vector<flatbuffers::Offset<fbs::KeyComparison>> fresh;
+    for (const auto& kvp : cellar.common) {
+      common.push_back(build_common(kvp.first, kvp.second));
+    }
+    for (const auto& kvp : cellar.missing) {
+      missing.push_back(build_solo(kvp.first, kvp.second, false));
+    }
+    for (const auto& kvp : cellar.fresh) {
+      fresh.push_back(build_solo(kvp.first, kvp.second, true));
+    }
+    const auto& fbsCommon = _builder.CreateVectorOfSortedTables(&common);
+    const auto& fbsMissing = _builder.CreateVectorOfSortedTables(&missing);
+    const auto& fbsFresh = _builder.CreateVectorOfSortedTables(&fresh);
+    return fbs::CreateKeyComparisons(_builder, fbsCommon, fbsMissing,
+                                     fbsFresh);
+  }
+
+  flatbuffers::Offset<fbs::KeyComparison> build_common(
+      const std::string& name, const TypeComparison& cmp) {
+    const auto& fbsName = _builder.CreateString(name);
+    cmp.srcValue.render(_value, _previewSize);
+    const auto& srcValue = _builder.CreateString(_value);
+    flatbuffers::Offset<flatbuffers::String> dstValue;
+    if (MatchType::Perfect != cmp.match) {
+      cmp.dstValue.render(_value, _previewSize);
+      dstValue = _builder.CreateString(_value);
+    }
+    // differences that were not described when compared are described now
+    std::set<std::string> described;
+    const auto* desc = &cmp.desc;
+    if (!cmp.described) {
+      described = cmp.describe();
+      desc = &described;
+    }
+    flatbuffers::Offset<
+        flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>>
+        fbsDesc;
+    if (!desc->empty()) {
+      std::vector<flatbuffers::Offset<flatbuffers::String>> entries;
+      for (const auto& entry : *desc) {
+        entries.push_back(_builder.CreateString(entry));
+      }
+      fbsDesc = _builder.CreateVector(entries);
+    }
+    return fbs::CreateKeyComparison(
+        _builder, fbsName, cmp.score, MatchType::Perfect == cmp.match,
+        value_type(cmp.srcType), value_type(cmp.dstType), srcValue, dstValue,
+        fbsDesc);
+  }
+
+  /** describes a key of either the fresh or the missing testcase alone */
+  flatbuffers::Offset<fbs::KeyComparison> build_solo(
+      const std::string& name, const ComparedValue& value, const bool fresh) {
+    const auto& fbsName = _builder.CreateString(name);
+    value.render(_value, _previewSize);
+    const auto& fbsValue = _builder.CreateString(_value);
+    fbs::KeyComparisonBuilder builder(_builder);
+    builder.add_name(fbsName);
+    if (fresh) {
+      builder.add_src_type(value_type(value.type()));
+      builder.add_src_value(fbsValue);
+    } else {
+      builder.add_dst_type(value_type(value.type()));
+      builder.add_dst_value(fbsValue);
+    }
+    return builder.Finish();
+  }
+
+  std::size_t _previewSize;
+  bool _summaryOnly;
+  flatbuffers::FlatBufferBuilder _builder;
+  std::vector<flatbuffers::Offset<fbs::Metadata>> _fresh;
+  std::vector<flatbuffers::Offset<fbs::Metadata>> _missing;
+  std::vector<flatbuffers::Offset<fbs::CaseComparison>> _common;
+  // buffer to render values into, reused to avoid allocations
+  std::string _value;
+};
+
+/**
+ * Compares common testcases of two result files a few at a time, enough
+ * to keep every thread busy, and passes their comparison results to a
+ * given function in the order of their names, discarding each one as soon
+ * as the function returns.
+ */
+void compare_in_windows(
+    const result_file_pair& files, const ComparisonOptions& options,
+    const std::function<void(const std::string&, const TestcaseComparison&)>&
+        consume) {
+  detail::ThreadPool pool(options.jobs);
+  const auto window = pool.size() == 1u ? 1u : 4u * pool.size();
+  const auto& common = files.common();
+  std::vector<std::unique_ptr<TestcaseComparison>> results(window);
+  for (std::size_t begin = 0; begin < common.size(); begin += window) {
+    const auto end = std::min(begin + window, common.size());
+    std::vector<std::function<void()>> tasks;
+    for (auto i = begin; i < end; ++i) {
+      tasks.emplace_back([&files, &common, &results, begin, i]() {
+        results[i - begin].reset(
+            new TestcaseComparison(files.compare(common[i])));
+      });
+    }
+    pool.run(std::move(tasks));
+    for (auto i = begin; i < end; ++i) {
+      consume(common[i], *results[i - begin]);
+      results[i - begin].reset();
+    }
+  }
+}
+
+/**
+ * Writes comparison results of two result files in binary format. Unlike
+ * their json representation, comparison results in binary format can only
+ * be written once they are complete.
+ */
+void write_binary_comparison(std::FILE* file, const result_file_pair& files,
+                             const ComparisonOptions& options) {
+  comparison_builder builder(options.preview_size, options.summary_only);
+  for (const auto& name : files.fresh()) {
+    builder.add_fresh(files.src_metadata(name));
+  }
+  for (const auto& name : files.missing()) {
+    builder.add_missing(files.dst_metadata(name));
+  }
+  compare_in_windows(
+      files, options,
+      [&builder](const std::string& name, const TestcaseComparison& cmp) {
+        builder.add_common(name, cmp);
+      });
+  const auto& buffer = builder.finish();
+  if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+    throw touca::detail::runtime_error("failed to write comparison results");
+  }
+}
+
+/**
+ * Describes the comparison result of a common testcase in json format, by
+ * its overview alone if `summary_only` is set.
+ */
+rapidjson::Value common_case_json(const std::string& name,
+                                  const TestcaseComparison& cmp,
+                                  const std::size_t preview_size,
+                                  const bool summary_only,
+                                  RJAllocator& allocator) {
+  if (!summary_only) {
+    return cmp.json(allocator, preview_size);
+  }
+  rapidjson::Value out(rapidjson::kObjectType);
+  out.AddMember("name", name, allocator);
+  out.AddMember("overview", cmp.overview().json(allocator), allocator);
+  return out;
+}
+
+void write_comparison(std::FILE* file, const touca::filesystem::path& src,
+                      const touca::filesystem::path& dst,
+                      const ComparisonOptions& options) {
+  const result_file_pair files(src, dst, options);
+  if (options.format == ComparisonFormat::Binary) {
+    write_binary_comparison(file, files, options);
+    return;
+  }
+  std::vector<char> buffer(64u << 10);
+  rapidjson::FileWriteStream stream(file, buffer.data(), buffer.size());
+  rapidjson::Writer<rapidjson::FileWriteStream> writer(stream);
+  writer.SetMaxDecimalPlaces(3);
+
+  // each value is built with an allocator of its own that is released as
+  // soon as the value is written.
+  const auto& write_metadata = [&writer](const Testcase::Metadata& meta) {
+    RJAllocator allocator;
+    meta.json(allocator).Accept(writer);
+  };
+  writer.StartObject();
+  writer.Key("newCases");
+  writer.StartArray();
+  for (const auto& name : files.fresh()) {
+    write_metadata(files.src_metadata(name));
+  }
+  writer.EndArray();
+  writer.Key("missingCases");
+  writer.StartArray();
+  for (const auto& name : files.missing()) {
+    write_metadata(files.dst_metadata(name));
+  }
+  writer.EndArray();
+
+  writer.Key("commonCases");
+  writer.StartArray();
+  compare_in_windows(
+      files, options,
+      [&writer, &options](const std::string& name,
+                          const TestcaseComparison& cmp) {
+        RJAllocator allocator;
+        common_case_json(name, cmp, options.preview_size,
+                         options.summary_only, allocator)
+            .Accept(writer);
+      });
+  writer.EndArray();
+  writer.EndObject();
+  stream.Flush();
+}
+
 std::string ElementsMapComparison::json() const {
   rapidjson::Document doc(rapidjson::kObjectType);
   auto& allocator = doc.GetAllocator();
@@ -560,7 +2786,9 @@ std::string ElementsMapComparison::json() const {
 
   rapidjson::Value rjCommon(rapidjson::kArrayType);
   for (const auto& item : common) {
-    rjCommon.PushBack(item.second.json(allocator), allocator);
+    rjCommon.PushBack(common_case_json(item.first, item.second, previewSize,
+                                       summaryOnly, allocator),
+                      allocator);
   }
 
   doc.AddMember("newCases", rjFresh, allocator);
@@ -574,4 +2802,18 @@ std::string ElementsMapComparison::json() const {
   return strbuf.GetString();
 }
 
+std::vector<std::uint8_t> ElementsMapComparison::binary() const {
+  comparison_builder builder(previewSize, summaryOnly);
+  for (const auto& item : fresh) {
+    builder.add_fresh(item.second->metadata());
+  }
+  for (const auto& item : missing) {
+    builder.add_missing(item.second->metadata());
+  }
+  for (const auto& item : common) {
+    builder.add_common(item.first, item.second);
+  }
+  return builder.finish();
+}
+
 }  // namespace touca
@@ -0,0 +1,202 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/comparison_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <tuple>
+
+#include "touca/core/digest.hpp"
+
+namespace touca {
+namespace detail {
+
+namespace {
+
+/**
+ * Each entry starts with these four bytes followed by the version of its
+ * layout as a 32-bit little-endian integer, and ends with the 64-bit
+ * digest of the content in between.
+ */
+constexpr char entry_magic[] = {'T', 'C', 'M', 'P'};
+constexpr std::uint32_t entry_version = 1;
+constexpr std::size_t entry_header_size = 8;
+constexpr std::size_t entry_trailer_size = 8;
+constexpr char entry_extension[] = ".cmp";
+
+template <typename T>
+void write_integer(std::vector<std::uint8_t>& content, const T value) {
+  for (auto i = 0u; i < sizeof(T); ++i) {
+    content.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+template <typename T>
+T read_integer(const void* data) {
+  const auto& bytes = static_cast<const std::uint8_t*>(data);
+  T value = 0;
+  for (auto i = sizeof(T); i > 0; --i) {
+    value = static_cast<T>((value << 8) | bytes[i - 1]);
+  }
+  return value;
+}
+
+bool is_intact(const std::string& entry) {
+  if (entry.size() < entry_header_size + entry_trailer_size ||
+      0 != std::memcmp(entry.data(), entry_magic, sizeof(entry_magic)) ||
+      entry_version != read_integer<std::uint32_t>(entry.data() + 4)) {
+    return false;
+  }
+  const auto size = entry.size() - entry_header_size - entry_trailer_size;
+  return touca::detail::digest(entry.data() + entry_header_size, size) ==
+         read_integer<std::uint64_t>(entry.data() + entry_header_size + size);
+}
+
+bool is_entry(const touca::filesystem::directory_entry& file) {
+  std::error_code ec;
+  return file.is_regular_file(ec) &&
+         file.path().extension() == touca::filesystem::path(entry_extension);
+}
+
+}  // namespace
+
+ComparisonCache::ComparisonCache(const touca::filesystem::path& directory,
+                                 const std::uintmax_t max_size)
+    : _directory(directory), _max_size(max_size) {
+  std::error_code ec;
+  touca::filesystem::create_directories(_directory, ec);
+  if (!touca::filesystem::is_directory(_directory, ec)) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "failed to create cache directory {}", _directory.string()));
+  }
+  for (const auto& file : touca::filesystem::directory_iterator(
+           _directory, touca::filesystem::directory_options::none, ec)) {
+    if (is_entry(file)) {
+      const auto size = file.file_size(ec);
+      _size += ec ? 0u : size;
+    }
+  }
+  if (0u != _max_size && _max_size < _size) {
+    evict();
+  }
+}
+
+bool ComparisonCache::load(const std::string& key,
+                           std::vector<std::uint8_t>& content) {
+  const auto& path = entry_path(key);
+  std::string entry;
+  std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+  if (file) {
+    entry.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  }
+  if (!is_intact(entry)) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_misses;
+    return false;
+  }
+  content.assign(entry.begin() + entry_header_size,
+                 entry.end() - entry_trailer_size);
+  // the modification time of entries tells how recently they were used
+  std::error_code ec;
+  touca::filesystem::last_write_time(
+      path, touca::filesystem::file_time_type::clock::now(), ec);
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++_hits;
+  return true;
+}
+
+void ComparisonCache::store(const std::string& key,
+                            const std::vector<std::uint8_t>& content) {
+  const auto& path = entry_path(key);
+  std::error_code ec;
+  if (touca::filesystem::exists(path, ec)) {
+    return;
+  }
+  std::vector<std::uint8_t> entry;
+  entry.reserve(entry_header_size + content.size() + entry_trailer_size);
+  entry.insert(entry.end(), std::begin(entry_magic), std::end(entry_magic));
+  write_integer<std::uint32_t>(entry, entry_version);
+  entry.insert(entry.end(), content.begin(), content.end());
+  write_integer<std::uint64_t>(
+      entry, touca::detail::digest(content.data(), content.size()));
+  // another thread or process may be storing the same entry
+  try {
+    save_binary_file(path.string(), entry);
+  } catch (const touca::detail::runtime_error&) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(_mutex);
+  _size += entry.size();
+  if (0u != _max_size && _max_size < _size) {
+    evict();
+  }
+}
+
+std::uintmax_t ComparisonCache::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _size;
+}
+
+std::size_t ComparisonCache::hits() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _hits;
+}
+
+std::size_t ComparisonCache::misses() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _misses;
+}
+
+touca::filesystem::path ComparisonCache::entry_path(
+    const std::string& key) const {
+  return _directory / (key + entry_extension);
+}
+
+/**
+ * Removes the least recently used entries until they take no more than
+ * three quarters of the allowed space, so that entries are not removed
+ * every time one is stored. Since other processes may share the directory,
+ * the size of the entries is counted anew. Expects the caller to hold the
+ * lock.
+ */
+void ComparisonCache::evict() {
+  using Entry = std::tuple<touca::filesystem::file_time_type, std::uintmax_t,
+                           touca::filesystem::path>;
+  std::vector<Entry> entries;
+  std::uintmax_t total = 0;
+  std::error_code ec;
+  for (const auto& file : touca::filesystem::directory_iterator(
+           _directory, touca::filesystem::directory_options::none, ec)) {
+    if (!is_entry(file)) {
+      continue;
+    }
+    const auto size = file.file_size(ec);
+    if (ec) {
+      continue;
+    }
+    const auto time = file.last_write_time(ec);
+    if (ec) {
+      continue;
+    }
+    entries.emplace_back(time, size, file.path());
+    total += size;
+  }
+  std::sort(entries.begin(), entries.end());
+  const auto target = _max_size / 4u * 3u;
+  for (const auto& entry : entries) {
+    if (total <= target) {
+      break;
+    }
+    if (touca::filesystem::remove(std::get<2>(entry), ec)) {
+      total -= std::get<1>(entry);
+    }
+  }
+  _size = total;
+}
+
+}  // namespace detail
+}  // namespace touca
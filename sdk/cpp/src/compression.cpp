@@ -0,0 +1,190 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/compression.hpp"
+
+#include <limits>
+
+#include "touca/core/filesystem.hpp"
+
+#ifdef TOUCA_HAS_ZSTD
+#include "zstd.h"
+#endif
+
+#ifdef TOUCA_HAS_LZ4
+#include "lz4.h"
+#include "lz4hc.h"
+#endif
+
+namespace touca {
+
+bool is_supported(const Compression codec) {
+  switch (codec) {
+    case Compression::None:
+      return true;
+#ifdef TOUCA_HAS_ZSTD
+    case Compression::Zstd:
+      return true;
+#endif
+#ifdef TOUCA_HAS_LZ4
+    case Compression::Lz4:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+Compression parse_compression(const std::string& name) {
+  if (name.empty() || name == "none") {
+    return Compression::None;
+  }
+  if (name == "zstd") {
+    return Compression::Zstd;
+  }
+  if (name == "lz4") {
+    return Compression::Lz4;
+  }
+  throw touca::detail::runtime_error(
+      touca::detail::format("compression codec {} is not known", name));
+}
+
+namespace detail {
+
+runtime_error unsupported_codec(const Compression codec) {
+  if (codec != Compression::Zstd && codec != Compression::Lz4) {
+    return runtime_error("compression codec is not known");
+  }
+  return runtime_error(touca::detail::format(
+      "touca was built without support for {} compression",
+      codec == Compression::Zstd ? "zstd" : "lz4"));
+}
+
+#ifdef TOUCA_HAS_ZSTD
+
+std::vector<std::uint8_t> compress_zstd(const int level,
+                                        const std::uint8_t* data,
+                                        const std::size_t size) {
+  std::vector<std::uint8_t> out(ZSTD_compressBound(size));
+  const auto ret = ZSTD_compress(out.data(), out.size(), data, size,
+                                 level == 0 ? ZSTD_CLEVEL_DEFAULT : level);
+  if (ZSTD_isError(ret)) {
+    throw runtime_error(touca::detail::format("failed to compress data: {}",
+                                              ZSTD_getErrorName(ret)));
+  }
+  out.resize(ret);
+  return out;
+}
+
+std::vector<std::uint8_t> decompress_zstd(const std::uint8_t* data,
+                                          const std::size_t size,
+                                          const std::size_t raw_size) {
+  // frames produced by `compress_zstd` record their content size, which
+  // must agree with the size recorded in the file before we allocate it.
+  const auto content_size = ZSTD_getFrameContentSize(data, size);
+  if (content_size == ZSTD_CONTENTSIZE_ERROR ||
+      content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size != raw_size) {
+    throw runtime_error("failed to decompress data");
+  }
+  std::vector<std::uint8_t> out(raw_size);
+  const auto ret = ZSTD_decompress(out.data(), out.size(), data, size);
+  if (ZSTD_isError(ret) || ret != raw_size) {
+    throw runtime_error("failed to decompress data");
+  }
+  return out;
+}
+
+#endif
+
+#ifdef TOUCA_HAS_LZ4
+
+/**
+ * Positive levels select the high compression mode of lz4. Negative levels
+ * select the acceleration factor of its fast mode.
+ */
+std::vector<std::uint8_t> compress_lz4(const int level,
+                                       const std::uint8_t* data,
+                                       const std::size_t size) {
+  if (size > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+    throw runtime_error("failed to compress data: input is too large");
+  }
+  const auto src = reinterpret_cast<const char*>(data);
+  const auto src_size = static_cast<int>(size);
+  std::vector<std::uint8_t> out(LZ4_compressBound(src_size));
+  const auto dst = reinterpret_cast<char*>(out.data());
+  const auto dst_size = static_cast<int>(out.size());
+  const auto ret =
+      level > 0 ? LZ4_compress_HC(src, dst, src_size, dst_size, level)
+                : LZ4_compress_fast(src, dst, src_size, dst_size,
+                                    level < 0 ? -level : 1);
+  if (ret <= 0) {
+    throw runtime_error("failed to compress data");
+  }
+  out.resize(ret);
+  return out;
+}
+
+std::vector<std::uint8_t> decompress_lz4(const std::uint8_t* data,
+                                         const std::size_t size,
+                                         const std::size_t raw_size) {
+  // lz4 blocks do not record their content size but cannot expand data by
+  // more than a factor of 255, which bounds what a corrupted size costs us.
+  const auto limit = static_cast<std::size_t>(std::numeric_limits<int>::max());
+  if (limit < size || limit < raw_size || size < raw_size / 255) {
+    throw runtime_error("failed to decompress data");
+  }
+  std::vector<std::uint8_t> out(raw_size);
+  const auto ret = LZ4_decompress_safe(reinterpret_cast<const char*>(data),
+                                       reinterpret_cast<char*>(out.data()),
+                                       static_cast<int>(size),
+                                       static_cast<int>(out.size()));
+  if (ret < 0 || static_cast<std::size_t>(ret) != raw_size) {
+    throw runtime_error("failed to decompress data");
+  }
+  return out;
+}
+
+#endif
+
+std::vector<std::uint8_t> compress(const Compression codec, const int level,
+                                   const std::uint8_t* data,
+                                   const std::size_t size) {
+  static_cast<void>(level);  // unused if built without any codec
+  switch (codec) {
+    case Compression::None:
+      return {data, data + size};
+#ifdef TOUCA_HAS_ZSTD
+    case Compression::Zstd:
+      return compress_zstd(level, data, size);
+#endif
+#ifdef TOUCA_HAS_LZ4
+    case Compression::Lz4:
+      return compress_lz4(level, data, size);
+#endif
+    default:
+      throw unsupported_codec(codec);
+  }
+}
+
+std::vector<std::uint8_t> decompress(const Compression codec,
+                                     const std::uint8_t* data,
+                                     const std::size_t size,
+                                     const std::size_t raw_size) {
+  static_cast<void>(raw_size);  // unused if built without any codec
+  switch (codec) {
+    case Compression::None:
+      return {data, data + size};
+#ifdef TOUCA_HAS_ZSTD
+    case Compression::Zstd:
+      return decompress_zstd(data, size, raw_size);
+#endif
+#ifdef TOUCA_HAS_LZ4
+    case Compression::Lz4:
+      return decompress_lz4(data, size, raw_size);
+#endif
+    default:
+      throw unsupported_codec(codec);
+  }
+}
+
+}  // namespace detail
+}  // namespace touca
@@ -2,17 +2,132 @@
 
 #include "touca/core/deserialize.hpp"
 
+#include <functional>
+#include <limits>
 #include <stdexcept>
 
 #include "flatbuffers/flatbuffers.h"
+#include "rapidjson/reader.h"
+#include "touca/core/compression.hpp"
 #include "touca/core/filesystem.hpp"
+#include "touca/core/result_file.hpp"
 #include "touca/core/testcase.hpp"
 #include "touca/core/types.hpp"
 #include "touca/impl/schema.hpp"
 
 namespace touca {
 
-data_point deserialize_value(const fbs::TypeWrapper* ptr) {
+/**
+ * Decodes a packed vector of scalars into an array of individual values,
+ * identical to the array from which it was serialized.
+ */
+template <typename Table, typename Convert>
+data_point deserialize_vector(const void* value, Convert convert) {
+  array out;
+  for (const auto element : *static_cast<const Table*>(value)->values()) {
+    out.add(convert(element));
+  }
+  return out;
+}
+
+VerifyMode parse_verify_mode(const std::string& name) {
+  if (name == "full") {
+    return VerifyMode::Full;
+  }
+  if (name == "checksum") {
+    return VerifyMode::Checksum;
+  }
+  if (name == "lazy") {
+    return VerifyMode::Lazy;
+  }
+  throw touca::detail::runtime_error(
+      touca::detail::format("verification mode {} is not known", name));
+}
+
+const flatbuffers::String* lookup_string(const flatbuffers::String* value,
+                                         std::uint32_t id,
+                                         const fbs::Dictionary* dictionary) {
+  if (value || !dictionary) {
+    return value;
+  }
+  const auto& values = dictionary->values();
+  if (!values || values->size() <= id) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("string table has no entry {}", id));
+  }
+  return values->Get(id);
+}
+
+const fbs::Dictionary* find_dictionary(const fbs::Messages* messages) {
+  return messages->dictionary() ? messages->dictionary_nested_root() : nullptr;
+}
+
+const fbs::Dictionary* find_dictionary(const std::string& content) {
+  return is_result_stream(content)
+             ? nullptr
+             : find_dictionary(fbs::GetMessages(content.data()));
+}
+
+const fbs::Message* get_message(const std::uint8_t* data,
+                                const std::size_t size, const bool verify) {
+  if (verify &&
+      !flatbuffers::Verifier(data, size).VerifyBuffer<fbs::Message>()) {
+    throw touca::detail::runtime_error("result file has a corrupted testcase");
+  }
+  return flatbuffers::GetRoot<fbs::Message>(data);
+}
+
+const fbs::Message* read_message(const fbs::MessageBuffer* buffer,
+                                 std::vector<std::uint8_t>& storage,
+                                 const bool verify) {
+  const auto& frame = buffer->frame();
+  if (frame) {
+    storage = touca::detail::decompress(
+        static_cast<Compression>(buffer->compression()), frame->data(),
+        frame->size(), buffer->raw_size());
+    return get_message(storage.data(), storage.size(), verify);
+  }
+  const auto& buf = buffer->buf();
+  return buf ? get_message(buf->data(), buf->size(), verify)
+             : get_message(nullptr, 0, verify);
+}
+
+const fbs::Message* read_message(const std::string& content,
+                                 const ResultFileEntry& entry,
+                                 std::vector<std::uint8_t>& storage,
+                                 const bool verify) {
+  const auto& data =
+      reinterpret_cast<const std::uint8_t*>(content.data()) + entry.offset;
+  if (entry.compression == Compression::None) {
+    return get_message(data, entry.size, verify);
+  }
+  storage = touca::detail::decompress(entry.compression, data, entry.size,
+                                      entry.raw_size);
+  return get_message(storage.data(), storage.size(), verify);
+}
+
+void for_each_message(
+    const std::string& content, const bool verify,
+    const std::function<void(const fbs::Message*,
+                             std::vector<std::uint8_t>&)>& func) {
+  // testcases appended more than once are enumerated from their latest copy
+  if (is_result_stream(content)) {
+    const auto& records = read_records(content);
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+      std::vector<std::uint8_t> storage;
+      func(read_message(content, *it, storage, verify), storage);
+    }
+    return;
+  }
+  const auto& messages = fbs::GetMessages(content.data());
+  for (const auto&& message : *messages->messages()) {
+    std::vector<std::uint8_t> storage;
+    func(read_message(message, storage, verify), storage);
+  }
+}
+
+data_point deserialize_value(const fbs::TypeWrapper* ptr,
+                             const fbs::Dictionary* dictionary) {
   const auto& value = ptr->value();
   const auto& type = ptr->value_type();
   switch (type) {
@@ -44,38 +159,64 @@ data_point deserialize_value(const fbs::TypeWrapper* ptr) {
       const auto& fbsArr = static_cast<const fbs::Array*>(value);
       array out;
       for (const auto&& element : *fbsArr->values()) {
-        out.add(deserialize_value(element));
+        out.add(deserialize_value(element, dictionary));
       }
       return out;
     }
     case fbs::Type::Object: {
       const auto& fbsObj = static_cast<const fbs::Object*>(value);
-      touca::object out(fbsObj->key()->data());
+      const auto& key =
+          lookup_string(fbsObj->key(), fbsObj->key_id(), dictionary);
+      touca::object out(key ? key->data() : "");
       for (const auto&& member : *fbsObj->values()) {
-        out.add(member->name()->data(), deserialize_value(member->value()));
+        const auto& name =
+            lookup_string(member->name(), member->name_id(), dictionary);
+        out.add(name->data(), deserialize_value(member->value(), dictionary));
       }
       return out;
     }
+    case fbs::Type::BoolVector:
+      return deserialize_vector<fbs::BoolVector>(value, [](uint8_t v) {
+        return data_point::boolean(v != 0);
+      });
+    case fbs::Type::IntVector:
+      return deserialize_vector<fbs::IntVector>(
+          value, [](int64_t v) { return data_point::number_signed(v); });
+    case fbs::Type::UIntVector:
+      return deserialize_vector<fbs::UIntVector>(
+          value, [](uint64_t v) { return data_point::number_unsigned(v); });
+    case fbs::Type::FloatVector:
+      return deserialize_vector<fbs::FloatVector>(
+          value, [](float v) { return data_point::number_float(v); });
+    case fbs::Type::DoubleVector:
+      return deserialize_vector<fbs::DoubleVector>(
+          value, [](double v) { return data_point::number_double(v); });
     default:
       throw touca::detail::runtime_error("encountered unexpected type");
   }
 }
 
-Testcase deserialize_testcase(const std::vector<uint8_t>& buffer) {
-  const auto message = flatbuffers::GetRoot<touca::fbs::Message>(buffer.data());
-  Testcase::Metadata metadata = {message->metadata()->teamslug()
-                                     ? message->metadata()->teamslug()->data()
-                                     : "unknown",
-                                 message->metadata()->testsuite()->data(),
-                                 message->metadata()->version()->data(),
-                                 message->metadata()->testcase()->data(),
-                                 message->metadata()->builtAt()->data()};
+Testcase::Metadata deserialize_metadata(const fbs::Metadata* ptr,
+                                        const fbs::Dictionary* dictionary) {
+  const auto& teamslug =
+      lookup_string(ptr->teamslug(), ptr->teamslug_id(), dictionary);
+  return {
+      teamslug ? teamslug->data() : "unknown",
+      lookup_string(ptr->testsuite(), ptr->testsuite_id(), dictionary)->data(),
+      lookup_string(ptr->version(), ptr->version_id(), dictionary)->data(),
+      ptr->testcase()->data(), ptr->builtAt()->data()};
+}
+
+Testcase deserialize_testcase(const fbs::Message& message,
+                              const fbs::Dictionary* dictionary) {
+  const auto& metadata = deserialize_metadata(message.metadata(), dictionary);
 
   ResultsMap resultsMap;
-  const auto& results = message->results()->entries();
+  const auto& results = message.results()->entries();
   for (const auto&& result : *results) {
-    const auto& key = result->key()->data();
-    const auto& value = deserialize_value(result->value());
+    const auto& key =
+        lookup_string(result->key(), result->key_id(), dictionary)->data();
+    const auto& value = deserialize_value(result->value(), dictionary);
     if (value.type() == touca::detail::internal_type::unknown) {
       throw touca::detail::runtime_error("failed to parse results map entry");
     }
@@ -86,10 +227,11 @@ Testcase deserialize_testcase(const std::vector<uint8_t>& buffer) {
   }
 
   std::unordered_map<std::string, touca::detail::number_unsigned_t> metricsMap;
-  const auto& metrics = message->metrics()->entries();
+  const auto& metrics = message.metrics()->entries();
   for (const auto&& metric : *metrics) {
-    const auto& key = metric->key()->data();
-    const auto& value = deserialize_value(metric->value());
+    const auto& key =
+        lookup_string(metric->key(), metric->key_id(), dictionary)->data();
+    const auto& value = deserialize_value(metric->value(), dictionary);
     if (value.type() != touca::detail::internal_type::number_signed) {
       throw touca::detail::runtime_error("failed to parse metrics map entry");
     }
@@ -99,9 +241,414 @@ Testcase deserialize_testcase(const std::vector<uint8_t>& buffer) {
   return Testcase(metadata, resultsMap, metricsMap);
 }
 
-ElementsMap deserialize_file(const touca::filesystem::path& path) {
-  const auto& content = touca::detail::load_text_file(
-      path.string(), std::ios::in | std::ios::binary);
+Testcase deserialize_testcase(const std::vector<uint8_t>& buffer,
+                              const fbs::Dictionary* dictionary) {
+  return deserialize_testcase(
+      *flatbuffers::GetRoot<touca::fbs::Message>(buffer.data()), dictionary);
+}
+
+bool is_json_result(const std::string& content) {
+  const auto& pos = content.find_first_not_of(" \t\r\n");
+  return pos != std::string::npos && content[pos] == '[';
+}
+
+/**
+ * Builds a value from the events that a rapidjson reader emits for its json
+ * representation, as written by `data_point::write_json`. Integers become
+ * signed numbers unless they are too large to fit one and other numbers
+ * become double-precision numbers.
+ */
+class json_value_builder {
+  enum class scope { array, wrapper, members };
+
+  struct frame {
+    explicit frame(const scope type) : kind(type) {}
+    scope kind;
+    touca::array elements;
+    touca::object members;
+    std::string key;
+    bool named = false;
+    bool complete = false;
+  };
+
+ public:
+  bool done() const { return _done; }
+
+  data_point take() {
+    _done = false;
+    return std::move(_value);
+  }
+
+  bool Null() { return add(data_point::null()); }
+  bool Bool(bool value) { return add(data_point::boolean(value)); }
+  bool Int(int value) { return add(data_point::number_signed(value)); }
+  bool Uint(unsigned value) { return add(data_point::number_signed(value)); }
+  bool Int64(int64_t value) { return add(data_point::number_signed(value)); }
+  bool Uint64(uint64_t value) {
+    return add(value > static_cast<uint64_t>(
+                           std::numeric_limits<detail::number_signed_t>::max())
+                   ? data_point::number_unsigned(value)
+                   : data_point::number_signed(
+                         static_cast<detail::number_signed_t>(value)));
+  }
+  bool Double(double value) { return add(data_point::number_double(value)); }
+  bool RawNumber(const char*, rapidjson::SizeType, bool) { return false; }
+
+  bool String(const char* value, rapidjson::SizeType length, bool) {
+    return add(data_point::string(std::string(value, length)));
+  }
+
+  // objects are written as `{name: {members}}`
+  bool StartObject() {
+    if (!_frames.empty() && _frames.back().kind == scope::wrapper) {
+      if (_frames.back().complete) {
+        return false;
+      }
+      touca::object members(_frames.back().key);
+      _frames.emplace_back(scope::members);
+      _frames.back().members = std::move(members);
+      return true;
+    }
+    _frames.emplace_back(scope::wrapper);
+    return true;
+  }
+
+  bool Key(const char* value, rapidjson::SizeType length, bool) {
+    auto& top = _frames.back();
+    if (top.kind == scope::wrapper && top.named) {
+      return false;
+    }
+    top.key.assign(value, length);
+    top.named = true;
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType) {
+    auto top = std::move(_frames.back());
+    _frames.pop_back();
+    if (top.kind == scope::members) {
+      _frames.back().members = std::move(top.members);
+      _frames.back().complete = true;
+      return true;
+    }
+    return top.complete && add(std::move(top.members));
+  }
+
+  bool StartArray() {
+    if (!_frames.empty() && _frames.back().kind == scope::wrapper) {
+      return false;
+    }
+    _frames.emplace_back(scope::array);
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType) {
+    auto top = std::move(_frames.back());
+    _frames.pop_back();
+    return add(std::move(top.elements));
+  }
+
+ private:
+  bool add(data_point value) {
+    if (_frames.empty()) {
+      _value = std::move(value);
+      _done = true;
+      return true;
+    }
+    auto& top = _frames.back();
+    switch (top.kind) {
+      case scope::array:
+        top.elements.add(std::move(value));
+        return true;
+      case scope::members:
+        top.members.add(top.key, std::move(value));
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  std::vector<frame> _frames;
+  data_point _value = data_point::null();
+  bool _done = false;
+};
+
+/**
+ * Collects testcases from the events that a rapidjson reader emits for a
+ * result file in json format. Fields that are not part of the format are
+ * skipped.
+ */
+class json_testcases_handler {
+  enum class scope {
+    root,
+    testcases,
+    testcase,
+    metadata,
+    entries,
+    entry,
+    value,
+    skip
+  };
+
+ public:
+  struct testcase_fields {
+    unsigned format_version = 0;
+    Testcase::Metadata metadata;
+    ResultsMap results;
+    std::map<std::string, data_point> metrics;
+  };
+
+  std::vector<testcase_fields>& testcases() { return _testcases; }
+
+  bool Null() { return is_value() ? forward(_builder.Null()) : true; }
+  bool Bool(bool value) {
+    return is_value() ? forward(_builder.Bool(value)) : true;
+  }
+  bool Int(int value) {
+    return is_value() ? forward(_builder.Int(value)) : true;
+  }
+  bool Uint(unsigned value) {
+    if (is_value()) {
+      return forward(_builder.Uint(value));
+    }
+    if (_scopes.back() == scope::testcase && _field == "formatVersion") {
+      _current.format_version = value;
+    }
+    return true;
+  }
+  bool Int64(int64_t value) {
+    return is_value() ? forward(_builder.Int64(value)) : true;
+  }
+  bool Uint64(uint64_t value) {
+    return is_value() ? forward(_builder.Uint64(value)) : true;
+  }
+  bool Double(double value) {
+    return is_value() ? forward(_builder.Double(value)) : true;
+  }
+  bool RawNumber(const char*, rapidjson::SizeType, bool) { return false; }
+
+  bool String(const char* value, rapidjson::SizeType length, bool copy) {
+    if (is_value()) {
+      return forward(_builder.String(value, length, copy));
+    }
+    if (_scopes.back() == scope::metadata) {
+      auto& metadata = _current.metadata;
+      auto* field = _field == "teamslug"    ? &metadata.teamslug
+                    : _field == "testsuite" ? &metadata.testsuite
+                    : _field == "version"   ? &metadata.version
+                    : _field == "testcase"  ? &metadata.testcase
+                    : _field == "builtAt"   ? &metadata.builtAt
+                                            : nullptr;
+      if (field) {
+        field->assign(value, length);
+      }
+    } else if (_scopes.back() == scope::entry && _field == "key") {
+      _key.assign(value, length);
+    }
+    return true;
+  }
+
+  bool StartObject() {
+    if (is_value()) {
+      return forward(_builder.StartObject());
+    }
+    const auto current = _scopes.back();
+    if (current == scope::testcases) {
+      _current = testcase_fields();
+      _current.metadata.teamslug = "unknown";
+      _scopes.push_back(scope::testcase);
+    } else if (current == scope::testcase && _field == "metadata") {
+      _scopes.push_back(scope::metadata);
+    } else if (current == scope::entries) {
+      _key.clear();
+      _has_value = false;
+      _scopes.push_back(scope::entry);
+    } else {
+      _scopes.push_back(scope::skip);
+    }
+    return true;
+  }
+
+  bool Key(const char* value, rapidjson::SizeType length, bool copy) {
+    if (_scopes.back() == scope::value) {
+      return forward(_builder.Key(value, length, copy));
+    }
+    _field.assign(value, length);
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType count) {
+    const auto current = _scopes.back();
+    if (current == scope::value) {
+      return forward(_builder.EndObject(count));
+    }
+    if (current == scope::testcase) {
+      _testcases.push_back(std::move(_current));
+    } else if (current == scope::entry && !add_entry()) {
+      return false;
+    }
+    _scopes.pop_back();
+    return true;
+  }
+
+  bool StartArray() {
+    if (is_value()) {
+      return forward(_builder.StartArray());
+    }
+    const auto current = _scopes.back();
+    if (current == scope::root) {
+      _scopes.push_back(scope::testcases);
+    } else if (current == scope::testcase &&
+               (_field == "results" || _field == "assertion" ||
+                _field == "metrics")) {
+      _list = _field;
+      _scopes.push_back(scope::entries);
+    } else {
+      _scopes.push_back(scope::skip);
+    }
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType count) {
+    if (_scopes.back() == scope::value) {
+      return forward(_builder.EndArray(count));
+    }
+    _scopes.pop_back();
+    return true;
+  }
+
+ private:
+  bool is_value() {
+    if (_scopes.back() == scope::entry && _field == "value") {
+      _field.clear();
+      _scopes.push_back(scope::value);
+    }
+    return _scopes.back() == scope::value;
+  }
+
+  bool forward(const bool ok) {
+    if (ok && _builder.done()) {
+      _value = _builder.take();
+      _has_value = true;
+      _scopes.pop_back();
+    }
+    return ok;
+  }
+
+  bool add_entry() {
+    if (!_has_value) {
+      return false;
+    }
+    if (_list == "metrics") {
+      _current.metrics.emplace(_key, std::move(_value));
+      return true;
+    }
+    _current.results.emplace(
+        _key, ResultEntry{std::move(_value), _list == "assertion"
+                                                 ? ResultCategory::Assert
+                                                 : ResultCategory::Check});
+    return true;
+  }
+
+  std::vector<scope> _scopes{scope::root};
+  std::vector<testcase_fields> _testcases;
+  testcase_fields _current;
+  json_value_builder _builder;
+  std::string _field;
+  std::string _list;
+  std::string _key;
+  data_point _value = data_point::null();
+  bool _has_value = false;
+};
+
+/**
+ * Recovers the value that `data_point::to_string` rendered as a string in json
+ * result files without a `formatVersion` field. Strings that are not valid json
+ * were strings to begin with.
+ */
+data_point parse_legacy_value(const data_point& value) {
+  if (value.type() != detail::internal_type::string) {
+    return value;
+  }
+  auto content = *value.as_string();
+  json_value_builder builder;
+  rapidjson::Reader reader;
+  rapidjson::InsituStringStream stream(&content[0]);
+  if (reader.Parse<rapidjson::kParseInsituFlag>(stream, builder).IsError() ||
+      !builder.done()) {
+    return value;
+  }
+  return builder.take();
+}
+
+ElementsMap deserialize_json(std::string content) {
+  json_testcases_handler handler;
+  rapidjson::Reader reader;
+  rapidjson::InsituStringStream stream(&content[0]);
+  const auto& result =
+      reader.Parse<rapidjson::kParseInsituFlag |
+                   rapidjson::kParseNanAndInfFlag>(stream, handler);
+  if (result.IsError()) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "failed to parse json result file at offset {}", result.Offset()));
+  }
+
+  ElementsMap testcases;
+  for (auto& fields : handler.testcases()) {
+    // values are written as native json values since version 2
+    const auto legacy = fields.format_version < 2;
+    if (legacy) {
+      for (auto& entry : fields.results) {
+        entry.second.val = parse_legacy_value(entry.second.val);
+      }
+    }
+    std::unordered_map<std::string, detail::number_unsigned_t> metrics;
+    for (const auto& metric : fields.metrics) {
+      const auto& value =
+          legacy ? parse_legacy_value(metric.second) : metric.second;
+      if (value.type() != detail::internal_type::number_signed) {
+        throw touca::detail::runtime_error("failed to parse metrics map entry");
+      }
+      metrics.emplace(metric.first, value.as_metric());
+    }
+    const auto& name = fields.metadata.testcase;
+    testcases.emplace(name, std::make_shared<Testcase>(
+                                fields.metadata, fields.results, metrics));
+  }
+  return testcases;
+}
+
+std::string load_result_file(const touca::filesystem::path& path,
+                             const VerifyMode mode, bool& verify_testcases) {
+  auto content = touca::detail::load_text_file(path.string(),
+                                               std::ios::in | std::ios::binary);
+
+  // json result files are checked as they are parsed
+  verify_testcases = false;
+  if (is_json_result(content)) {
+    return content;
+  }
+
+  // a matching checksum is enough to trust files that we wrote ourselves
+  if (mode == VerifyMode::Checksum) {
+    const auto& status = verify_checksum(content);
+    if (status == ChecksumStatus::Match) {
+      return content;
+    }
+    if (status == ChecksumStatus::Mismatch) {
+      throw touca::detail::runtime_error(
+          touca::detail::format("result file corrupted: {}", path.string()));
+    }
+  }
+
+  // testcases are nested buffers, possibly compressed, that are verified
+  // as they are read so that they are decompressed only once.
+  verify_testcases = true;
+
+  // files written one testcase at a time have no top-level flatbuffers data
+  if (is_result_stream(content)) {
+    return content;
+  }
 
   // verify that given content represents valid flatbuffers data
   if (!flatbuffers::Verifier((const uint8_t*)content.data(), content.size())
@@ -110,18 +657,54 @@ ElementsMap deserialize_file(const touca::filesystem::path& path) {
         touca::detail::format("result file invalid: {}", path.string()));
   }
 
+  // the string table is a nested buffer that the check above does not cover
+  const auto& dictionary =
+      touca::fbs::GetMessages(content.data())->dictionary();
+  if (dictionary &&
+      !flatbuffers::Verifier(dictionary->data(), dictionary->size())
+           .VerifyBuffer<touca::fbs::Dictionary>()) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("result file invalid: {}", path.string()));
+  }
+  return content;
+}
+
+std::string load_result_file(const touca::filesystem::path& path,
+                             const VerifyMode mode) {
+  auto verify_testcases = false;
+  auto content = load_result_file(path, mode, verify_testcases);
+  if (verify_testcases && mode != VerifyMode::Lazy) {
+    for_each_message(content, true,
+                     [](const fbs::Message*, std::vector<std::uint8_t>&) {});
+  }
+  return content;
+}
+
+ElementsMap deserialize_content(std::string content,
+                                const bool verify_testcases) {
+  if (is_json_result(content)) {
+    return deserialize_json(std::move(content));
+  }
+
   ElementsMap testcases;
   // parse content of given file
-  const auto& messages = touca::fbs::GetMessages(content.c_str());
-  for (const auto&& message : *messages->messages()) {
-    const auto& buffer = message->buf();
-    const auto& ptr = buffer->data();
-    std::vector<uint8_t> data(ptr, ptr + buffer->size());
-    const auto& testcase =
-        std::make_shared<Testcase>(deserialize_testcase(data));
-    testcases.emplace(testcase->metadata().testcase, testcase);
-  }
+  const auto& dictionary = find_dictionary(content);
+  for_each_message(content, verify_testcases,
+                   [&testcases, dictionary](const fbs::Message* message,
+                                            std::vector<std::uint8_t>&) {
+                     const auto& testcase = std::make_shared<Testcase>(
+                         deserialize_testcase(*message, dictionary));
+                     testcases.emplace(testcase->metadata().testcase,
+                                       testcase);
+                   });
   return testcases;
 }
 
+ElementsMap deserialize_file(const touca::filesystem::path& path,
+                             const VerifyMode mode) {
+  auto verify_testcases = false;
+  auto content = load_result_file(path, mode, verify_testcases);
+  return deserialize_content(std::move(content), verify_testcases);
+}
+
 }  // namespace touca
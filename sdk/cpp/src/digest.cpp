@@ -0,0 +1,129 @@
+// Copyright 2022 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/digest.hpp"
+
+#include <cstring>
+
+namespace touca {
+namespace detail {
+
+namespace {
+
+constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t rotl(const std::uint64_t x, const int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+inline std::uint64_t read64(const std::uint8_t* p) {
+  std::uint64_t v = 0;
+  for (int i = 7; i >= 0; --i) {
+    v = (v << 8) | p[i];
+  }
+  return v;
+}
+
+inline std::uint32_t read32(const std::uint8_t* p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline std::uint64_t round(std::uint64_t acc, const std::uint64_t input) {
+  acc += input * prime2;
+  acc = rotl(acc, 31);
+  return acc * prime1;
+}
+
+inline std::uint64_t merge_round(std::uint64_t acc, const std::uint64_t val) {
+  acc ^= round(0, val);
+  return acc * prime1 + prime4;
+}
+
+}  // namespace
+
+xxh64::xxh64(const std::uint64_t seed) : _seed(seed) {
+  _acc[0] = seed + prime1 + prime2;
+  _acc[1] = seed + prime2;
+  _acc[2] = seed;
+  _acc[3] = seed - prime1;
+}
+
+void xxh64::update(const void* data, const std::size_t size) {
+  auto p = static_cast<const std::uint8_t*>(data);
+  const auto end = p + size;
+  _total += size;
+
+  if (_buffered + size < sizeof(_buffer)) {
+    std::memcpy(_buffer + _buffered, p, size);
+    _buffered += size;
+    return;
+  }
+  if (_buffered != 0) {
+    const auto fill = sizeof(_buffer) - _buffered;
+    std::memcpy(_buffer + _buffered, p, fill);
+    for (auto i = 0; i < 4; ++i) {
+      _acc[i] = round(_acc[i], read64(_buffer + 8 * i));
+    }
+    p += fill;
+    _buffered = 0;
+  }
+  for (; p + sizeof(_buffer) <= end; p += sizeof(_buffer)) {
+    for (auto i = 0; i < 4; ++i) {
+      _acc[i] = round(_acc[i], read64(p + 8 * i));
+    }
+  }
+  _buffered = static_cast<std::size_t>(end - p);
+  std::memcpy(_buffer, p, _buffered);
+}
+
+std::uint64_t xxh64::digest() const {
+  std::uint64_t h = 0;
+  if (_total >= sizeof(_buffer)) {
+    h = rotl(_acc[0], 1) + rotl(_acc[1], 7) + rotl(_acc[2], 12) +
+        rotl(_acc[3], 18);
+    for (auto i = 0; i < 4; ++i) {
+      h = merge_round(h, _acc[i]);
+    }
+  } else {
+    h = _seed + prime5;
+  }
+  h += _total;
+
+  auto p = _buffer;
+  const auto end = _buffer + _buffered;
+  for (; p + 8 <= end; p += 8) {
+    h ^= round(0, read64(p));
+    h = rotl(h, 27) * prime1 + prime4;
+  }
+  if (p + 4 <= end) {
+    h ^= static_cast<std::uint64_t>(read32(p)) * prime1;
+    h = rotl(h, 23) * prime2 + prime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    h ^= (*p) * prime5;
+    h = rotl(h, 11) * prime1;
+  }
+
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+  return h;
+}
+
+std::uint64_t digest(const void* data, const std::size_t size) {
+  xxh64 state;
+  state.update(data, size);
+  return state.digest();
+}
+
+}  // namespace detail
+}  // namespace touca
@@ -14,10 +14,21 @@
 #endif
 #endif
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include <codecvt>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <locale>
+#include <random>
 #include <sstream>
 
 #include "fmt/core.h"
@@ -47,30 +58,151 @@ void create_parent_directory(const std::string& path) {
   }
 }
 
-void save_text_file(const std::string& path, const std::string& content) {
-  create_parent_directory(path);
-  try {
-    std::ofstream out(path);
-    out << content;
-    out.close();
-  } catch (const std::exception& ex) {
+SyncPolicy parse_sync_policy(const std::string& name) {
+  if (name.empty() || name == "never") {
+    return SyncPolicy::Never;
+  }
+  if (name == "file") {
+    return SyncPolicy::PerFile;
+  }
+  if (name == "batch") {
+    return SyncPolicy::PerBatch;
+  }
+  if (name == "run") {
+    return SyncPolicy::EndOfRun;
+  }
+  throw touca::detail::runtime_error(
+      touca::detail::format("sync policy {} is not known", name));
+}
+
+/**
+ * Flushes content of an open file to stable storage.
+ */
+bool sync_descriptor(const int fd) {
+#ifdef _WIN32
+  return _commit(fd) == 0;
+#else
+  return fsync(fd) == 0;
+#endif
+}
+
+/**
+ * Flushes the list of entries of the directory that contains a given file,
+ * so that a file that was just created or renamed survives a crash. Windows
+ * offers no equivalent and persists directory entries with the file.
+ */
+bool sync_parent_directory(const std::string& path) {
+#ifdef _WIN32
+  (void)path;
+  return true;
+#else
+  const auto& parent =
+      touca::filesystem::absolute(touca::filesystem::path(path)).parent_path();
+  const auto fd = open(parent.string().c_str(), O_RDONLY);
+  if (fd == -1) {
+    return false;
+  }
+  const auto synced = sync_descriptor(fd);
+  return close(fd) == 0 && synced;
+#endif
+}
+
+void sync_file(const std::string& path) {
+#ifdef _WIN32
+  const auto fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+#else
+  const auto fd = open(path.c_str(), O_RDONLY);
+#endif
+  if (fd == -1) {
     throw touca::detail::runtime_error(
-        touca::detail::format("failed to save content to disk: {}", ex.what()));
+        touca::detail::format("failed to open {} to flush it", path));
+  }
+  const auto synced = sync_descriptor(fd);
+#ifdef _WIN32
+  const auto closed = _close(fd) == 0;
+#else
+  const auto closed = close(fd) == 0;
+#endif
+  if (!synced || !closed || !sync_parent_directory(path)) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("failed to flush {} to disk", path));
   }
 }
 
-void save_binary_file(const std::string& path,
-                      const std::vector<uint8_t>& data) {
+/**
+ * Provides a path next to a given path to which its new content can be
+ * written before it is renamed over it. The path is unique to this process
+ * and call so that processes and threads saving the same file concurrently
+ * do not write to each other's temporary file.
+ */
+std::string make_temporary_path(const std::string& path) {
+#ifdef _WIN32
+  const auto pid = _getpid();
+#else
+  const auto pid = getpid();
+#endif
+  std::random_device device;
+  return touca::detail::format("{}.{}.{:08x}.tmp", path, pid, device());
+}
+
+void save_file(const std::string& path,
+               const std::function<void(std::FILE*)>& write, const bool binary,
+               const bool sync) {
   create_parent_directory(path);
+  const auto& tmp_path = make_temporary_path(path);
+  auto file = std::fopen(tmp_path.c_str(), binary ? "wb" : "w");
+  if (!file) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "failed to save content to disk: cannot create {}", tmp_path));
+  }
   try {
-    std::ofstream out(path, std::ios::binary);
-    out.write((const char*)data.data(), data.size());
-    out.close();
-  } catch (const std::exception& ex) {
+    write(file);
+  } catch (...) {
+    std::fclose(file);
+    std::remove(tmp_path.c_str());
+    throw;
+  }
+#ifdef _WIN32
+  const auto fd = _fileno(file);
+#else
+  const auto fd = fileno(file);
+#endif
+  auto written = std::ferror(file) == 0 && std::fflush(file) == 0 &&
+                 (!sync || sync_descriptor(fd));
+  written = std::fclose(file) == 0 && written;
+  std::error_code ec;
+  if (written) {
+    touca::filesystem::rename(tmp_path, path, ec);
+  }
+  if (!written || ec) {
+    std::remove(tmp_path.c_str());
+    throw touca::detail::runtime_error(touca::detail::format(
+        "failed to save content to disk: cannot write {}", path));
+  }
+  if (sync && !sync_parent_directory(path)) {
     throw touca::detail::runtime_error(
-        touca::detail::format("failed to save content to disk: {}", ex.what()));
+        touca::detail::format("failed to flush {} to disk", path));
   }
 }
 
+void save_file(const std::string& path, const char* data,
+               const std::size_t size, const bool binary, const bool sync) {
+  save_file(
+      path,
+      [data, size](std::FILE* file) { std::fwrite(data, 1, size, file); },
+      binary, sync);
+}
+
+void save_text_file(const std::string& path, const std::string& content,
+                    const bool sync) {
+  save_file(path, content.data(), content.size(), false, sync);
+}
+
+void save_binary_file(const std::string& path,
+                      const std::vector<uint8_t>& data, const bool sync) {
+  save_file(path, reinterpret_cast<const char*>(data.data()), data.size(),
+            true, sync);
+}
+
 }  // namespace detail
 }  // namespace touca
@@ -11,6 +11,7 @@
 #include "fmt/format.h"
 #include "rapidjson/document.h"
 #include "touca/client/detail/options.hpp"
+#include "touca/core/compression.hpp"
 #include "touca/core/filesystem.hpp"
 
 #ifdef TOUCA_INCLUDE_RUNNER
@@ -50,6 +51,8 @@ void assign_core_options(
   assign_option(source, target.version, "version");
   assign_option(source, target.offline, "offline");
   assign_option(source, target.concurrency, "concurrency");
+  assign_option(source, target.compact_binary, "compact_binary");
+  assign_option(source, target.compression, "compression");
   assign_option(source, target.api_key, "api-key");
   assign_option(source, target.api_url, "api-url");
   assign_option(source, target.version, "revision");
@@ -142,6 +145,11 @@ void validate_core_options(const ClientOptions& options) {
         touca::detail::format("required configuration options {} are missing",
                               fmt::join(missing_keys, ", ")));
   }
+  if (!is_supported(parse_compression(options.compression))) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "compression codec {} is not supported by this build of the sdk",
+        options.compression));
+  }
 }
 
 void update_core_options(ClientOptions& options,
@@ -179,6 +187,8 @@ void assign_runner_options(
   assign_option(source, target.workflow_filter, "workflow_filter");
   assign_option(source, target.save_binary, "save_binary");
   assign_option(source, target.save_json, "save_json");
+  assign_option(source, target.archive_results, "archive_results");
+  assign_option(source, target.sync_policy, "sync_policy");
   assign_option(source, target.log_level, "log_level");
   assign_option(source, target.redirect_output, "redirect_output");
   assign_option(source, target.skip_logs, "skip_logs");
@@ -186,6 +196,8 @@ void assign_runner_options(
   assign_option(source, target.no_color, "no-color");
   assign_option(source, target.save_binary, "save-as-binary");
   assign_option(source, target.save_json, "save-as-json");
+  assign_option(source, target.archive_results, "archive");
+  assign_option(source, target.sync_policy, "sync");
   assign_option(source, target.output_directory, "output-directory");
   assign_option(source, target.overwrite_results, "overwrite");
   assign_option(source, target.workflow_filter, "filter");
@@ -304,6 +316,18 @@ static cxxopts::Options cli_options(const char* program = "./app") {
       ("save-as-json",
           "save a copy of test results on local disk in json format",
           cxxopts::value<bool>()->implicit_value("true"))
+      ("archive",
+          "save binary results of all testcases into a single file",
+          cxxopts::value<bool>()->implicit_value("true"))
+      ("sync",
+          "when to flush result files to disk: never, file, batch or run",
+          cxxopts::value<std::string>())
+      ("compact-binary",
+          "use compact encodings in binary result files",
+          cxxopts::value<bool>()->implicit_value("true"))
+      ("compression",
+          "codec to compress testcases in binary result files",
+          cxxopts::value<std::string>())
       ("output-directory",
           "path to a local directory to store results files",
           cxxopts::value<std::string>())
@@ -384,6 +408,10 @@ void apply_cli_arguments(int argc, char* argv[], RunnerOptions& options) {
     parse_cli_option(result, "log-level", options.log_level);
     parse_cli_option(result, "save-as-binary", options.save_binary);
     parse_cli_option(result, "save-as-json", options.save_json);
+    parse_cli_option(result, "archive", options.archive_results);
+    parse_cli_option(result, "sync", options.sync_policy);
+    parse_cli_option(result, "compact-binary", options.compact_binary);
+    parse_cli_option(result, "compression", options.compression);
     parse_cli_option(result, "redirect-output", options.redirect_output);
     parse_cli_option(result, "no-color", options.no_color);
     parse_cli_option(result, "api-key", options.api_key);
@@ -451,6 +479,10 @@ void apply_config_file(RunnerOptions& options) {
       parse_file_option(result, "log-level", options.log_level);
       parse_file_option(result, "save-as-binary", options.save_binary);
       parse_file_option(result, "save-as-json", options.save_json);
+      parse_file_option(result, "archive", options.archive_results);
+      parse_file_option(result, "sync", options.sync_policy);
+      parse_file_option(result, "compact-binary", options.compact_binary);
+      parse_file_option(result, "compression", options.compression);
       parse_file_option(result, "skip-logs", options.skip_logs);
       parse_file_option(result, "redirect-output", options.redirect_output);
       parse_file_option(result, "overwrite", options.overwrite_results);
@@ -603,6 +635,8 @@ void validate_runner_options(const RunnerOptions& options) {
         "workflows.");
   }
 
+  touca::detail::parse_sync_policy(options.sync_policy);
+
   const auto& levels = {"debug", "info", "warning"};
   if (std::find(levels.begin(), levels.end(), options.log_level) ==
       levels.end()) {
@@ -0,0 +1,843 @@
+// Copyright 2022 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/result_file.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#include "flatbuffers/flatbuffers.h"
+#include "touca/core/deserialize.hpp"
+#include "touca/core/digest.hpp"
+#include "touca/impl/schema.hpp"
+
+namespace touca {
+
+/**
+ * Result files that have a footer end with the serialized `fbs::Footer`
+ * followed by its size as a 32-bit little-endian integer and these four
+ * bytes.
+ */
+constexpr char footer_magic[] = {'T', 'I', 'D', 'X'};
+constexpr std::size_t footer_trailer_size = 8;
+
+/**
+ * Result files written by `ResultFileWriter` start with these four bytes
+ * followed by the version of their layout as a 32-bit little-endian integer.
+ * Each testcase is then stored as a record made of a 16-byte header, the
+ * serialized message padded with zeros to a multiple of eight bytes, and the
+ * 64-bit digest of the message that marks the record as complete. The header
+ * holds the size of the message as a 32-bit integer, its compression codec
+ * and the kind of the record as single bytes, two reserved bytes and its
+ * size before compression as a 64-bit integer. Records of files attached to
+ * testcases hold a serialized `fbs::Attachment` instead of `fbs::Message`.
+ */
+constexpr char stream_magic[] = {'T', 'S', 'T', 'R'};
+constexpr std::uint32_t stream_version = 1;
+constexpr std::size_t stream_header_size = 8;
+constexpr std::size_t record_header_size = 16;
+constexpr std::size_t record_trailer_size = 8;
+constexpr std::uint8_t record_kind_testcase = 0;
+constexpr std::uint8_t record_kind_attachment = 1;
+
+/**
+ * `ResultFileWriter` rewrites a result file without the records of
+ * superseded testcases and attachments when it is finalized, once these
+ * records take up more than this share of the file.
+ */
+constexpr double compaction_threshold = 0.25;
+
+template <typename T>
+void write_integer(std::vector<std::uint8_t>& content, const T value) {
+  for (auto i = 0u; i < sizeof(T); ++i) {
+    content.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+template <typename T>
+T read_integer(const void* data) {
+  const auto& bytes = static_cast<const std::uint8_t*>(data);
+  T value = 0;
+  for (auto i = sizeof(T); i > 0; --i) {
+    value = static_cast<T>((value << 8) | bytes[i - 1]);
+  }
+  return value;
+}
+
+std::uint64_t align_to_eight(const std::uint64_t size) {
+  return (size + 7) & ~std::uint64_t(7);
+}
+
+/**
+ * @return size of the record written by `ResultFileWriter` that holds a
+ *         given message, including its header and trailer
+ */
+std::uint64_t record_size(const ResultFileEntry& entry) {
+  return record_header_size + align_to_eight(entry.size) + record_trailer_size;
+}
+
+/**
+ * @param trailer last eight bytes of a result file
+ * @param file_size size of the result file
+ * @throw touca::detail::runtime_error if the footer size is invalid
+ * @return offset of the footer within the result file or `file_size` if the
+ *         file has no footer
+ */
+std::uint64_t find_footer(const char* trailer, const std::uint64_t file_size) {
+  if (std::memcmp(trailer + 4, footer_magic, sizeof(footer_magic)) != 0) {
+    return file_size;
+  }
+  const auto footer_size = read_integer<std::uint32_t>(trailer);
+  if (file_size < footer_trailer_size + footer_size) {
+    throw touca::detail::runtime_error("result file has an invalid footer");
+  }
+  return file_size - footer_trailer_size - footer_size;
+}
+
+std::uint64_t find_footer(const std::string& content) {
+  if (content.size() < footer_trailer_size) {
+    return content.size();
+  }
+  return find_footer(content.data() + content.size() - footer_trailer_size,
+                     content.size());
+}
+
+/**
+ * Reads the header of a record written by `ResultFileWriter`.
+ *
+ * @param header first bytes of the record
+ * @param offset position of the record within the result file
+ * @param end position within the result file where records end
+ * @param entry set to the position of the message held by the record
+ * @param kind set to the kind of the record
+ * @return `false` if the record does not fit before `end`
+ */
+bool read_record_header(const char* header, const std::uint64_t offset,
+                        const std::uint64_t end, ResultFileEntry& entry,
+                        std::uint8_t& kind) {
+  entry.offset = offset + record_header_size;
+  entry.size = read_integer<std::uint32_t>(header);
+  entry.compression =
+      static_cast<Compression>(static_cast<std::uint8_t>(header[4]));
+  kind = static_cast<std::uint8_t>(header[5]);
+  entry.raw_size = read_integer<std::uint64_t>(header + 8);
+  return entry.offset + align_to_eight(entry.size) + record_trailer_size <=
+         end;
+}
+
+flatbuffers::Offset<fbs::IndexEntry> create_index_entry(
+    flatbuffers::FlatBufferBuilder& builder, const char* testcase,
+    const ResultFileEntry& entry, const char* name = nullptr) {
+  return fbs::CreateIndexEntryDirect(
+      builder, testcase, entry.offset, entry.size, entry.digest,
+      static_cast<fbs::Compression>(entry.compression), entry.raw_size, name);
+}
+
+ResultFileEntry create_entry(const std::vector<std::uint8_t>& content,
+                             const flatbuffers::Vector<std::uint8_t>* buffer,
+                             const Compression compression = Compression::None,
+                             const std::uint64_t raw_size = 0) {
+  return {static_cast<std::uint64_t>(buffer->data() - content.data()),
+          buffer->size(), touca::detail::digest(buffer->data(), buffer->size()),
+          compression, raw_size};
+}
+
+/**
+ * Serializes the footer of a result file, followed by its trailer.
+ *
+ * @param checksum digest of everything that precedes the footer
+ * @param attachments files stored alongside the testcases, if any
+ */
+std::vector<std::uint8_t> create_footer(
+    const ResultFileIndex& index, const ResultFileEntry* dictionary,
+    const std::uint64_t checksum,
+    const ResultFileAttachments* attachments = nullptr) {
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<flatbuffers::Offset<fbs::IndexEntry>> entries;
+  for (const auto& kvp : index) {
+    entries.push_back(
+        create_index_entry(builder, kvp.first.c_str(), kvp.second));
+  }
+  const auto& dictionary_entry =
+      dictionary ? create_index_entry(builder, "", *dictionary)
+                 : flatbuffers::Offset<fbs::IndexEntry>();
+  std::vector<flatbuffers::Offset<fbs::IndexEntry>> files;
+  if (attachments) {
+    for (const auto& testcase : *attachments) {
+      for (const auto& file : testcase.second) {
+        files.push_back(create_index_entry(builder, testcase.first.c_str(),
+                                           file.second, file.first.c_str()));
+      }
+    }
+  }
+  builder.Finish(fbs::CreateFooterDirect(builder, &entries, dictionary_entry,
+                                         checksum,
+                                         files.empty() ? nullptr : &files));
+  const auto& ptr = builder.GetBufferPointer();
+  std::vector<std::uint8_t> footer(ptr, ptr + builder.GetSize());
+  write_integer<std::uint32_t>(footer, builder.GetSize());
+  footer.insert(footer.end(), std::begin(footer_magic), std::end(footer_magic));
+  return footer;
+}
+
+/**
+ * Reads a given region of a result file and checks that its content
+ * matches its recorded digest.
+ *
+ * @return `false` if the region could not be read or is corrupted
+ */
+bool read_entry(std::ifstream& file, const ResultFileEntry& entry,
+                std::vector<std::uint8_t>& buffer) {
+  buffer.resize(entry.size);
+  file.seekg(static_cast<std::streamoff>(entry.offset));
+  return file.read(reinterpret_cast<char*>(buffer.data()), buffer.size()) &&
+         touca::detail::digest(buffer.data(), buffer.size()) == entry.digest;
+}
+
+void append_footer(std::vector<std::uint8_t>& content) {
+  ResultFileIndex index;
+  const auto& messages = fbs::GetMessages(content.data());
+  for (const auto&& message : *messages->messages()) {
+    std::vector<std::uint8_t> storage;
+    const auto& testcase =
+        read_message(message, storage)->metadata()->testcase()->str();
+    index.emplace(testcase,
+                  message->frame()
+                      ? create_entry(content, message->frame(),
+                                     static_cast<Compression>(
+                                         message->compression()),
+                                     message->raw_size())
+                      : create_entry(content, message->buf()));
+  }
+  const auto has_dictionary = messages->dictionary() != nullptr;
+  ResultFileEntry dictionary{0, 0, 0, Compression::None, 0};
+  if (has_dictionary) {
+    dictionary = create_entry(content, messages->dictionary());
+  }
+
+  // keep the footer aligned to its largest scalar, relative to the start
+  // of the file, so that it can be read in place.
+  content.resize(align_to_eight(content.size()), 0);
+  const auto& checksum = touca::detail::digest(content.data(), content.size());
+  const auto& footer =
+      create_footer(index, has_dictionary ? &dictionary : nullptr, checksum);
+  content.insert(content.end(), footer.begin(), footer.end());
+}
+
+ChecksumStatus verify_checksum(const std::string& content) {
+  const auto footer_offset = find_footer(content);
+  if (footer_offset == content.size()) {
+    return ChecksumStatus::Missing;
+  }
+  const auto footer_size = content.size() - footer_trailer_size - footer_offset;
+  const auto& footer =
+      reinterpret_cast<const std::uint8_t*>(content.data()) + footer_offset;
+  if (!flatbuffers::Verifier(footer, footer_size).VerifyBuffer<fbs::Footer>()) {
+    throw touca::detail::runtime_error("result file has an invalid footer");
+  }
+  const auto& checksum = flatbuffers::GetRoot<fbs::Footer>(footer)->checksum();
+  if (!checksum) {
+    return ChecksumStatus::Missing;
+  }
+  const auto& digest = touca::detail::digest(content.data(), footer_offset);
+  return digest == *checksum ? ChecksumStatus::Match : ChecksumStatus::Mismatch;
+}
+
+bool is_result_stream(const std::string& content) {
+  return content.compare(0, sizeof(stream_magic), stream_magic,
+                         sizeof(stream_magic)) == 0;
+}
+
+/**
+ * Finds the complete records of a given kind in the content of a result file
+ * written by `ResultFileWriter`, in the order they were written.
+ */
+std::vector<ResultFileEntry> find_records(const std::string& content,
+                                          const std::uint8_t kind) {
+  std::vector<ResultFileEntry> records;
+  const auto end = find_footer(content);
+  auto offset = static_cast<std::uint64_t>(stream_header_size);
+  ResultFileEntry entry{0, 0, 0, Compression::None, 0};
+  std::uint8_t record_kind = 0;
+  while (offset + record_header_size <= end &&
+         read_record_header(content.data() + offset, offset, end, entry,
+                            record_kind)) {
+    const auto& padded_size = align_to_eight(entry.size);
+    entry.digest = touca::detail::digest(content.data() + entry.offset,
+                                         entry.size);
+    if (entry.digest != read_integer<std::uint64_t>(content.data() +
+                                                    entry.offset +
+                                                    padded_size)) {
+      break;
+    }
+    if (record_kind == kind) {
+      records.push_back(entry);
+    }
+    offset = entry.offset + padded_size + record_trailer_size;
+  }
+  return records;
+}
+
+std::vector<ResultFileEntry> read_records(const std::string& content) {
+  return find_records(content, record_kind_testcase);
+}
+
+/**
+ * Provides the serialized attachment at a given position of a result file,
+ * decompressing it first if it is compressed.
+ *
+ * @param storage buffer to hold the decompressed attachment, if necessary
+ * @return `nullptr` if the attachment is corrupted
+ */
+const fbs::Attachment* read_attachment(const std::uint8_t* data,
+                                       const ResultFileEntry& entry,
+                                       std::vector<std::uint8_t>& storage) {
+  std::size_t size = entry.size;
+  if (entry.compression != Compression::None) {
+    storage = touca::detail::decompress(entry.compression, data, size,
+                                        entry.raw_size);
+    data = storage.data();
+    size = storage.size();
+  }
+  if (!flatbuffers::Verifier(data, size).VerifyBuffer<fbs::Attachment>()) {
+    return nullptr;
+  }
+  return flatbuffers::GetRoot<fbs::Attachment>(data);
+}
+
+/**
+ * Compares the first bytes of a file against a given digest, reading them
+ * in blocks so that the file need not fit in memory.
+ */
+bool matches_digest(std::ifstream& file, const std::uint64_t size,
+                    const std::uint64_t expected) {
+  touca::detail::xxh64 hasher;
+  std::vector<char> block(1u << 20);
+  file.seekg(0);
+  for (auto remaining = size; remaining != 0;) {
+    const auto count = std::min<std::uint64_t>(remaining, block.size());
+    if (!file.read(block.data(), static_cast<std::streamsize>(count))) {
+      return false;
+    }
+    hasher.update(block.data(), static_cast<std::size_t>(count));
+    remaining -= count;
+  }
+  return hasher.digest() == expected;
+}
+
+/**
+ * @param dictionary if not null, set to the location of the string table of
+ *                   the result file, if the file has one
+ * @param checksum if not null, set to the outcome of checking the file
+ *                 against the checksum recorded in its footer, which takes
+ *                 reading the entire file
+ */
+ResultFileIndex read_index(std::ifstream& file, const std::string& path,
+                           ResultFileEntry* dictionary = nullptr,
+                           ChecksumStatus* checksum = nullptr) {
+  file.seekg(0, std::ios::end);
+  const auto file_size = static_cast<std::uint64_t>(file.tellg());
+  if (file_size < footer_trailer_size) {
+    return {};
+  }
+  char trailer[footer_trailer_size];
+  file.seekg(static_cast<std::streamoff>(file_size - footer_trailer_size));
+  if (!file.read(trailer, footer_trailer_size) ||
+      std::memcmp(trailer + 4, footer_magic, sizeof(footer_magic)) != 0) {
+    return {};
+  }
+  const auto footer_size = read_integer<std::uint32_t>(trailer);
+  if (file_size < footer_trailer_size + footer_size) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("result file invalid: {}", path));
+  }
+  const auto footer_offset = file_size - footer_trailer_size - footer_size;
+  std::vector<std::uint8_t> footer(footer_size);
+  file.seekg(static_cast<std::streamoff>(footer_offset));
+  if (!file.read(reinterpret_cast<char*>(footer.data()), footer_size) ||
+      !flatbuffers::Verifier(footer.data(), footer.size())
+           .VerifyBuffer<fbs::Footer>()) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("result file invalid: {}", path));
+  }
+
+  const auto& is_valid = [footer_offset](const fbs::IndexEntry* entry) {
+    return entry->offset() <= footer_offset &&
+           entry->size() <= footer_offset - entry->offset();
+  };
+  ResultFileIndex index;
+  const auto& root = flatbuffers::GetRoot<fbs::Footer>(footer.data());
+  if (!root->entries()) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("result file invalid: {}", path));
+  }
+  for (const auto&& entry : *root->entries()) {
+    if (!entry->testcase() || !is_valid(entry)) {
+      throw touca::detail::runtime_error(
+          touca::detail::format("result file invalid: {}", path));
+    }
+    const auto& compression = static_cast<Compression>(entry->compression());
+    index.emplace(entry->testcase()->str(),
+                  ResultFileEntry{entry->offset(), entry->size(),
+                                  entry->digest(), compression,
+                                  entry->raw_size()});
+  }
+  const auto& entry = root->dictionary();
+  if (entry && dictionary) {
+    if (!is_valid(entry)) {
+      throw touca::detail::runtime_error(
+          touca::detail::format("result file invalid: {}", path));
+    }
+    *dictionary = {entry->offset(), entry->size(), entry->digest(),
+                   Compression::None, 0};
+  }
+  if (checksum && !root->checksum()) {
+    *checksum = ChecksumStatus::Missing;
+  } else if (checksum) {
+    *checksum = matches_digest(file, footer_offset, *root->checksum())
+                    ? ChecksumStatus::Match
+                    : ChecksumStatus::Mismatch;
+  }
+  return index;
+}
+
+ResultFileIndex read_index(const touca::filesystem::path& path) {
+  std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+  if (!file) {
+    throw touca::detail::runtime_error("failed to read file");
+  }
+  return read_index(file, path.string());
+}
+
+ResultFileReader::ResultFileReader(const touca::filesystem::path& path,
+                                   const VerifyMode mode)
+    : _path(path.string()) {
+  std::ifstream file(_path, std::ios::in | std::ios::binary);
+  if (!file) {
+    throw touca::detail::runtime_error("failed to read file");
+  }
+  ResultFileEntry dictionary_entry{0, 0, 0, Compression::None, 0};
+  auto checksum = ChecksumStatus::Missing;
+  _index = read_index(file, _path, &dictionary_entry,
+                      mode == VerifyMode::Checksum ? &checksum : nullptr);
+  if (checksum == ChecksumStatus::Mismatch) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("result file corrupted: {}", _path));
+  }
+
+  // a matching checksum is enough to trust files that we wrote ourselves
+  _verify = checksum != ChecksumStatus::Match;
+
+  // keys of testcases written with a string table are stored separately
+  if (dictionary_entry.size == 0) {
+    return;
+  }
+  if (!read_entry(file, dictionary_entry, _dictionary) ||
+      (_verify &&
+       !flatbuffers::Verifier(_dictionary.data(), _dictionary.size())
+            .VerifyBuffer<fbs::Dictionary>())) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("string table in {} is corrupted", _path));
+  }
+}
+
+const fbs::Dictionary* ResultFileReader::dictionary() const {
+  return _dictionary.empty()
+             ? nullptr
+             : flatbuffers::GetRoot<fbs::Dictionary>(_dictionary.data());
+}
+
+std::vector<std::uint8_t> ResultFileReader::read_message(
+    const std::string& name) const {
+  const auto& it = _index.find(name);
+  if (it == _index.end()) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("testcase {} not found in {}", name, _path));
+  }
+  // each call has a stream of its own so that calls may run in parallel
+  std::ifstream file(_path, std::ios::in | std::ios::binary);
+  if (!file) {
+    throw touca::detail::runtime_error("failed to read file");
+  }
+  const auto& entry = it->second;
+  std::vector<std::uint8_t> buffer;
+  if (!read_entry(file, entry, buffer)) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "testcase {} in {} is corrupted", name, _path));
+  }
+  if (entry.compression != Compression::None) {
+    buffer = touca::detail::decompress(entry.compression, buffer.data(),
+                                       buffer.size(), entry.raw_size);
+  }
+  if (_verify && !flatbuffers::Verifier(buffer.data(), buffer.size())
+                      .VerifyBuffer<fbs::Message>()) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "testcase {} in {} is corrupted", name, _path));
+  }
+  return buffer;
+}
+
+Testcase read_testcase(const touca::filesystem::path& path,
+                       const std::string& name) {
+  const ResultFileReader reader(path);
+
+  // files written without a footer are deserialized in their entirety
+  if (reader.index().empty()) {
+    const auto& testcases = deserialize_file(path);
+    if (!testcases.count(name)) {
+      throw touca::detail::runtime_error(
+          touca::detail::format("testcase {} not found in {}", name,
+                                path.string()));
+    }
+    return *testcases.at(name);
+  }
+  return deserialize_testcase(reader.read_message(name), reader.dictionary());
+}
+
+std::string read_attachment(const touca::filesystem::path& path,
+                            const std::string& testcase,
+                            const std::string& name) {
+  const auto& content = touca::detail::load_text_file(
+      path.string(), std::ios::in | std::ios::binary);
+  if (!is_result_stream(content)) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "result file {} has no attachments", path.string()));
+  }
+  const auto& data = reinterpret_cast<const std::uint8_t*>(content.data());
+  const auto& matches = [&testcase, &name](const flatbuffers::String* owner,
+                                           const flatbuffers::String* file) {
+    return owner && file && owner->str() == testcase && file->str() == name;
+  };
+
+  // look the attachment up in the footer of finalized files and otherwise
+  // scan all their records, keeping the copy that was attached last.
+  ResultFileEntry entry{0, 0, 0, Compression::None, 0};
+  auto found = false;
+  const auto footer_offset = find_footer(content);
+  if (footer_offset != content.size()) {
+    const auto footer_size =
+        content.size() - footer_trailer_size - footer_offset;
+    if (!flatbuffers::Verifier(data + footer_offset, footer_size)
+             .VerifyBuffer<fbs::Footer>()) {
+      throw touca::detail::runtime_error(
+          touca::detail::format("result file invalid: {}", path.string()));
+    }
+    const auto& files =
+        flatbuffers::GetRoot<fbs::Footer>(data + footer_offset)->attachments();
+    for (auto i = 0u; files && i < files->size(); ++i) {
+      const auto& file = files->Get(i);
+      if (matches(file->testcase(), file->name()) &&
+          file->offset() <= footer_offset &&
+          file->size() <= footer_offset - file->offset()) {
+        entry = {file->offset(), file->size(), file->digest(),
+                 static_cast<Compression>(file->compression()),
+                 file->raw_size()};
+        found = true;
+      }
+    }
+  } else {
+    std::vector<std::uint8_t> storage;
+    for (const auto& record : find_records(content, record_kind_attachment)) {
+      const auto& file = read_attachment(data + record.offset, record, storage);
+      if (file && matches(file->testcase(), file->name())) {
+        entry = record;
+        found = true;
+      }
+    }
+  }
+  if (!found) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("attachment {} of testcase {} not found in {}",
+                              name, testcase, path.string()));
+  }
+
+  std::vector<std::uint8_t> storage;
+  const auto& file =
+      touca::detail::digest(data + entry.offset, entry.size) == entry.digest
+          ? read_attachment(data + entry.offset, entry, storage)
+          : nullptr;
+  if (!file) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("attachment {} of testcase {} in {} is corrupted",
+                              name, testcase, path.string()));
+  }
+  const auto& bytes = file->content();
+  return bytes ? std::string(bytes->begin(), bytes->end()) : std::string();
+}
+
+ResultFileWriter::ResultFileWriter(const touca::filesystem::path& path,
+                                   const SerializationOptions& options)
+    : _path(path.string()), _options(options) {
+  _options.string_table = false;
+  touca::detail::create_parent_directory(_path);
+
+  // recover testcases of an existing file, up to its last complete record
+  std::ifstream file(_path, std::ios::in | std::ios::binary);
+  std::uint64_t file_size = 0;
+  if (file) {
+    file.seekg(0, std::ios::end);
+    file_size = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0);
+  }
+  if (file_size != 0) {
+    char header[record_header_size];
+    if (file_size < stream_header_size ||
+        !file.read(header, stream_header_size) ||
+        std::memcmp(header, stream_magic, sizeof(stream_magic)) != 0 ||
+        read_integer<std::uint32_t>(header + 4) != stream_version) {
+      throw touca::detail::runtime_error(touca::detail::format(
+          "result file {} was not written by ResultFileWriter", _path));
+    }
+    _checksum.update(header, stream_header_size);
+    _size = stream_header_size;
+
+    auto end = file_size;
+    if (file_size >= _size + footer_trailer_size) {
+      file.seekg(static_cast<std::streamoff>(file_size - footer_trailer_size));
+      end = file.read(header, footer_trailer_size)
+                ? find_footer(header, file_size)
+                : _size;
+      file.seekg(static_cast<std::streamoff>(_size));
+    }
+    ResultFileEntry entry{0, 0, 0, Compression::None, 0};
+    std::uint8_t kind = 0;
+    std::vector<std::uint8_t> record;
+    std::vector<std::uint8_t> storage;
+    while (_size + record_header_size <= end &&
+           file.read(header, record_header_size) &&
+           read_record_header(header, _size, end, entry, kind)) {
+      const auto& padded_size = align_to_eight(entry.size);
+      record.resize(padded_size + record_trailer_size);
+      if (!file.read(reinterpret_cast<char*>(record.data()), record.size())) {
+        break;
+      }
+      entry.digest = touca::detail::digest(record.data(), entry.size);
+      if (entry.digest !=
+          read_integer<std::uint64_t>(record.data() + padded_size)) {
+        break;
+      }
+      if (kind == record_kind_attachment) {
+        const auto& attachment = read_attachment(record.data(), entry, storage);
+        if (!attachment || !attachment->testcase() || !attachment->name()) {
+          break;
+        }
+        supersede(_attachments[attachment->testcase()->str()]
+                              [attachment->name()->str()],
+                  entry);
+      } else {
+        const std::uint8_t* data = record.data();
+        std::size_t size = entry.size;
+        if (entry.compression != Compression::None) {
+          storage = touca::detail::decompress(entry.compression, data, size,
+                                              entry.raw_size);
+          data = storage.data();
+          size = storage.size();
+        }
+        if (!flatbuffers::Verifier(data, size).VerifyBuffer<fbs::Message>()) {
+          break;
+        }
+        const auto& message = flatbuffers::GetRoot<fbs::Message>(data);
+        supersede(_index[message->metadata()->testcase()->str()], entry);
+      }
+      _checksum.update(header, record_header_size);
+      _checksum.update(record.data(), record.size());
+      _size = entry.offset + record.size();
+    }
+    file.close();
+    touca::filesystem::resize_file(_path, _size);
+  }
+
+  _file.open(_path, std::ios::out | std::ios::binary | std::ios::app);
+  if (!_file) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("failed to open result file {}", _path));
+  }
+  if (_size == 0) {
+    std::vector<std::uint8_t> header(std::begin(stream_magic),
+                                     std::end(stream_magic));
+    write_integer<std::uint32_t>(header, stream_version);
+    write(header);
+  }
+}
+
+void ResultFileWriter::append(const Testcase& testcase) {
+  append(testcase.metadata().testcase, testcase.flatbuffers(_options));
+}
+
+void ResultFileWriter::append(const std::string& testcase,
+                              std::vector<std::uint8_t> message) {
+  const auto& entry = write_record(record_kind_testcase, std::move(message));
+  supersede(_index[testcase], entry);
+}
+
+void ResultFileWriter::attach(const std::string& testcase,
+                              const std::string& name,
+                              const std::string& content) {
+  flatbuffers::FlatBufferBuilder builder;
+  const std::vector<std::uint8_t> bytes(content.begin(), content.end());
+  builder.Finish(fbs::CreateAttachmentDirect(builder, testcase.c_str(),
+                                             name.c_str(), &bytes));
+  const auto& ptr = builder.GetBufferPointer();
+  const auto& entry =
+      write_record(record_kind_attachment,
+                   std::vector<std::uint8_t>(ptr, ptr + builder.GetSize()));
+  supersede(_attachments[testcase][name], entry);
+}
+
+void ResultFileWriter::finalize(const bool sync) {
+  if (!_file.is_open()) {
+    return;
+  }
+  if (_superseded > compaction_threshold * _size) {
+    _file.close();
+    compact(sync);
+    return;
+  }
+  write(create_footer(_index, nullptr, _checksum.digest(), &_attachments));
+  _file.close();
+  if (sync) {
+    touca::detail::sync_file(_path);
+  }
+}
+
+/**
+ * Replaces the result file with a finalized copy that only has the latest
+ * record of each testcase and attachment. The copy is written next to the
+ * file and renamed over it, so that an interrupted compaction leaves the
+ * original file in place.
+ */
+void ResultFileWriter::compact(const bool sync) {
+  std::ifstream file(_path, std::ios::in | std::ios::binary);
+  if (!file) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("failed to read result file {}", _path));
+  }
+  // copy records in the order they were written and only update positions
+  // of testcases and attachments once the copy is in place.
+  auto index = _index;
+  auto attachments = _attachments;
+  std::vector<ResultFileEntry*> entries;
+  for (auto& kvp : index) {
+    entries.push_back(&kvp.second);
+  }
+  for (auto& testcase : attachments) {
+    for (auto& kvp : testcase.second) {
+      entries.push_back(&kvp.second);
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const ResultFileEntry* a, const ResultFileEntry* b) {
+              return a->offset < b->offset;
+            });
+
+  std::uint64_t size = 0;
+  const auto& copy = [this, &file, &entries, &index, &attachments,
+                      &size](std::FILE* out) {
+    touca::detail::xxh64 checksum;
+    const auto& emit = [&checksum, &size,
+                        out](const std::vector<std::uint8_t>& content) {
+      if (std::fwrite(content.data(), 1, content.size(), out) !=
+          content.size()) {
+        throw touca::detail::runtime_error("failed to write result file");
+      }
+      checksum.update(content.data(), content.size());
+      size += content.size();
+    };
+    std::vector<std::uint8_t> record(std::begin(stream_magic),
+                                     std::end(stream_magic));
+    write_integer<std::uint32_t>(record, stream_version);
+    emit(record);
+    for (const auto& entry : entries) {
+      record.resize(record_size(*entry));
+      file.seekg(
+          static_cast<std::streamoff>(entry->offset - record_header_size));
+      if (!file.read(reinterpret_cast<char*>(record.data()), record.size())) {
+        throw touca::detail::runtime_error(
+            touca::detail::format("failed to read result file {}", _path));
+      }
+      entry->offset = size + record_header_size;
+      emit(record);
+    }
+    // the copy is renamed over the file once written, which fails on
+    // windows while the file is still open.
+    file.close();
+    emit(create_footer(index, nullptr, checksum.digest(), &attachments));
+  };
+  touca::detail::save_file(_path, copy, true, sync);
+  _index.swap(index);
+  _attachments.swap(attachments);
+  _size = size;
+  _superseded = 0;
+}
+
+/**
+ * Points a testcase or attachment to the record that holds its latest
+ * copy, keeping track of the space taken by the record it supersedes.
+ */
+void ResultFileWriter::supersede(ResultFileEntry& current,
+                                 const ResultFileEntry& entry) {
+  if (current.size != 0) {
+    _superseded += record_size(current);
+  }
+  current = entry;
+}
+
+/**
+ * Appends a record of a given kind to the result file, compressing its
+ * content first if the file is configured to do so.
+ *
+ * @return position of the content of the record within the result file
+ */
+ResultFileEntry ResultFileWriter::write_record(
+    const std::uint8_t kind, std::vector<std::uint8_t> content) {
+  if (!_file.is_open()) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("result file {} is finalized", _path));
+  }
+  ResultFileEntry entry{_size + record_header_size, 0, 0,
+                        _options.compression, 0};
+  if (_options.compression != Compression::None) {
+    entry.raw_size = content.size();
+    content =
+        touca::detail::compress(_options.compression,
+                                _options.compression_level, content.data(),
+                                content.size());
+  }
+  // record headers hold the size of their content as a 32-bit integer
+  if (content.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw touca::detail::runtime_error(touca::detail::format(
+        "record of {} bytes is too large for result file {}", content.size(),
+        _path));
+  }
+  entry.size = content.size();
+  entry.digest = touca::detail::digest(content.data(), content.size());
+
+  std::vector<std::uint8_t> record;
+  record.reserve(record_size(entry));
+  write_integer<std::uint32_t>(record, static_cast<std::uint32_t>(entry.size));
+  record.push_back(static_cast<std::uint8_t>(entry.compression));
+  record.push_back(kind);
+  record.resize(8, 0);
+  write_integer<std::uint64_t>(record, entry.raw_size);
+  record.insert(record.end(), content.begin(), content.end());
+  record.resize(record_header_size + align_to_eight(entry.size), 0);
+  write_integer<std::uint64_t>(record, entry.digest);
+  write(record);
+  return entry;
+}
+
+void ResultFileWriter::write(const std::vector<std::uint8_t>& content) {
+  _file.write(reinterpret_cast<const char*>(content.data()), content.size());
+  _file.flush();
+  if (!_file) {
+    throw touca::detail::runtime_error(
+        touca::detail::format("failed to write to result file {}", _path));
+  }
+  _checksum.update(content.data(), content.size());
+  _size += content.size();
+}
+
+}  // namespace touca
@@ -149,6 +149,12 @@ void Statistics::inc(Status value) {
   _v[value] += 1U;
 }
 
+void Statistics::dec(Status value) {
+  if (count(value)) {
+    _v[value] -= 1U;
+  }
+}
+
 unsigned long Statistics::count(Status value) const {
   return _v.count(value) ? _v.at(value) : 0u;
 }
@@ -237,7 +243,7 @@ void Printer::print_footer(const Statistics& stats, Timer& timer,
   }
 }
 
-void Runner::run_workflows() {
+bool Runner::run_workflows() {
   if (!options.output_directory.empty() &&
       (options.save_binary || options.save_json)) {
     touca::filesystem::create_directories(options.output_directory);
@@ -253,6 +259,7 @@ void Runner::run_workflows() {
     }
   }
   printer.print_app_footer();
+  return !failed;
 }
 
 void Runner::run_workflow(const Workflow& workflow) {
@@ -270,6 +277,19 @@ void Runner::run_workflow(const Workflow& workflow) {
       workflow.version;
   touca::filesystem::create_directories(version_directory);
 
+  // in archive mode, results of all testcases of this workflow are appended
+  // to a single file whose index tells which testcases were processed.
+  archive.reset();
+  archived.clear();
+  if (options.save_binary && options.archive_results) {
+    archive = std::make_shared<ResultFileWriter>(
+        version_directory / "touca.bin",
+        touca::detail::get_serialization_options());
+    for (const auto& kvp : archive->index()) {
+      archived.insert(kvp.first);
+    }
+  }
+
   // unless explicitly instructed not to do so, register a separate
   // file logger to write our events to a file in the output directory.
   if (!options.skip_logs) {
@@ -298,6 +318,35 @@ void Runner::run_workflow(const Workflow& workflow) {
   for (const auto& testcase : workflow.testcases) {
     run_testcase(workflow, testcase, index++);
   }
+
+  // wait for the results of all testcases to be written to disk
+  if (archive) {
+    // like files written by the writer, the archive is flushed as soon as
+    // it is finalized only if it is flushed file by file.
+    const auto& file = archive;
+    if (parse_sync_policy(options.sync_policy) == SyncPolicy::PerFile) {
+      writer.post([file]() { file->finalize(true); });
+    } else {
+      writer.post([file]() { file->finalize(); }, 0, file->path());
+    }
+    archive.reset();
+  }
+  // testcases whose results may not have been saved are not reported as
+  // submitted.
+  try {
+    writer.flush();
+  } catch (const std::exception& ex) {
+    const auto& msg =
+        touca::detail::format("failed to save test results: {}", ex.what());
+    logger.error(msg);
+    printer.print_error(msg);
+    for (std::size_t i = 0; i < unsaved.size(); ++i) {
+      stats.dec(Status::Sent);
+      stats.inc(Status::Fail);
+    }
+    failed = true;
+  }
+  unsaved.clear();
   timer.toc("__workflow__");
   printer.print_footer(stats, timer, workflow, options);
   if (!options.offline) {
@@ -313,6 +362,7 @@ void Runner::run_testcase(const Workflow& workflow, const std::string& testcase,
 
   // unless `overwrite` is specified, check whether to skip this testcase.
   if (options.overwrite_results ? false
+      : archive ? archived.count(testcase) != 0
       : options.save_binary
           ? touca::filesystem::exists(case_directory / "touca.bin")
       : options.save_json
@@ -330,13 +380,16 @@ void Runner::run_testcase(const Workflow& workflow, const std::string& testcase,
   // remove result directory for this testcase if it already exists.
   // since subsequent operations may expect to write into this directory,
   // we wait a few milliseconds to ensure it is entirely removed from disk.
-  if (touca::filesystem::exists(case_directory.string())) {
-    touca::filesystem::remove_all(case_directory);
-    logger.debug(
-        touca::detail::format("removed result directory for {}", testcase));
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // in archive mode, only results in json format need this directory.
+  if (!archive || options.save_json) {
+    if (touca::filesystem::exists(case_directory.string())) {
+      touca::filesystem::remove_all(case_directory);
+      logger.debug(
+          touca::detail::format("removed result directory for {}", testcase));
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    touca::filesystem::create_directories(case_directory);
   }
-  touca::filesystem::create_directories(case_directory);
 
   logger.info(touca::detail::format("processing testcase: {}", testcase));
   timer.tic(testcase);
@@ -359,21 +412,46 @@ void Runner::run_testcase(const Workflow& workflow, const std::string& testcase,
   timer.toc(testcase);
   Status status = errors.empty() ? Status::Sent : Status::Fail;
 
-  if (!capturer.cerr().empty()) {
-    const auto resultFile = case_directory / "stderr.txt";
-    touca::detail::save_text_file(resultFile.string(), capturer.cerr());
-  }
-  if (!capturer.cout().empty()) {
-    const auto resultFile = case_directory / "stdout.txt";
-    touca::detail::save_text_file(resultFile.string(), capturer.cout());
-  }
-  if (errors.empty() && options.save_binary) {
+  // results are serialized here but written to disk on a background thread
+  // while the next testcase runs. Once opened, the archive is only used by
+  // that thread.
+  const auto& save_output = [this, &testcase, &case_directory](
+                                const std::string& name,
+                                const std::string& content) {
+    if (content.empty()) {
+      return;
+    }
+    if (!archive) {
+      writer.write((case_directory / name).string(),
+                   std::vector<std::uint8_t>(content.begin(), content.end()));
+      return;
+    }
+    const auto& file = archive;
+    writer.post(
+        [file, testcase, name, content]() {
+          file->attach(testcase, name, content);
+        },
+        content.size(), file->path());
+  };
+  save_output("stderr.txt", capturer.cerr());
+  save_output("stdout.txt", capturer.cout());
+  if (errors.empty() && archive) {
+    const auto& file = archive;
+    const auto& message = std::make_shared<std::vector<std::uint8_t>>(
+        touca::detail::serialize_message(testcase, file->options()));
+    writer.post(
+        [file, testcase, message]() {
+          file->append(testcase, std::move(*message));
+        },
+        message->size(), file->path());
+  } else if (errors.empty() && options.save_binary) {
     const auto resultFile = case_directory / "touca.bin";
-    touca::save_binary(resultFile.string(), {testcase});
+    writer.write(resultFile.string(),
+                 touca::detail::serialize_binary(testcase));
   }
   if (errors.empty() && options.save_json) {
     const auto resultFile = case_directory / "touca.json";
-    touca::save_json(resultFile.string(), {testcase});
+    writer.write(resultFile.string(), touca::detail::serialize_json(testcase));
   }
   if (errors.empty() && !options.offline) {
     Post::Options opts;
@@ -382,6 +460,10 @@ void Runner::run_testcase(const Workflow& workflow, const std::string& testcase,
   }
 
   stats.inc(status);
+  if (status == Status::Sent &&
+      (archive || options.save_binary || options.save_json)) {
+    unsaved.push_back(testcase);
+  }
   printer.print_progress(index, status, testcase, timer, errors);
   touca::forget_testcase(testcase);
   logger.info(touca::detail::format("processed testcase: {}", testcase));
@@ -420,7 +502,10 @@ int run(int argc, char* argv[]) {
   try {
     touca::detail::update_runner_options(argc, argv,
                                          touca::detail::_meta.options);
-    touca::detail::Runner(touca::detail::_meta.options).run_workflows();
+    if (!touca::detail::Runner(touca::detail::_meta.options)
+             .run_workflows()) {
+      return EXIT_FAILURE;
+    }
   } catch (const touca::detail::graceful_exit_error& ex) {
     fmt::print(std::cout, "{}\n", ex.what());
     return EXIT_SUCCESS;
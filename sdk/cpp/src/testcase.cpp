@@ -2,11 +2,16 @@
 
 #include "touca/core/testcase.hpp"
 
+#include <cmath>
+#include <limits>
+
 #include "flatbuffers/flatbuffers.h"
 #include "rapidjson/document.h"
+#include "rapidjson/filewritestream.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "touca/core/compression.hpp"
 #include "touca/core/filesystem.hpp"
 #include "touca/core/types.hpp"
 #include "touca/impl/schema.hpp"
@@ -164,6 +169,7 @@ MetricsMap Testcase::metrics() const {
 rapidjson::Value Testcase::json(
     rapidjson::Document::AllocatorType& allocator) const {
   rapidjson::Value out(rapidjson::kObjectType);
+  out.AddMember("formatVersion", detail::json_format_version, allocator);
   out.AddMember("metadata", _metadata.json(allocator), allocator);
 
   rapidjson::Value rjResults(rapidjson::kArrayType);
@@ -173,7 +179,8 @@ rapidjson::Value Testcase::json(
     }
     rapidjson::Value rjEntry(rapidjson::kObjectType);
     rjEntry.AddMember("key", entry.first, allocator);
-    rjEntry.AddMember("value", entry.second.val.to_string(), allocator);
+    rjEntry.AddMember("value", to_json(entry.second.val, allocator),
+                      allocator);
     rjResults.PushBack(rjEntry, allocator);
   }
   out.AddMember("results", rjResults, allocator);
@@ -185,7 +192,8 @@ rapidjson::Value Testcase::json(
     }
     rapidjson::Value rjEntry(rapidjson::kObjectType);
     rjEntry.AddMember("key", entry.first, allocator);
-    rjEntry.AddMember("value", entry.second.val.to_string(), allocator);
+    rjEntry.AddMember("value", to_json(entry.second.val, allocator),
+                      allocator);
     rjAssertions.PushBack(rjEntry, allocator);
   }
   out.AddMember("assertion", rjAssertions, allocator);
@@ -194,7 +202,8 @@ rapidjson::Value Testcase::json(
   for (const auto& entry : metrics()) {
     rapidjson::Value rjEntry(rapidjson::kObjectType);
     rjEntry.AddMember("key", entry.first, allocator);
-    rjEntry.AddMember("value", entry.second.value.to_string(), allocator);
+    rjEntry.AddMember("value", to_json(entry.second.value, allocator),
+                      allocator);
     rjMetrics.PushBack(rjEntry, allocator);
   }
   out.AddMember("metrics", rjMetrics, allocator);
@@ -202,23 +211,37 @@ rapidjson::Value Testcase::json(
   return out;
 }
 
-std::vector<uint8_t> Testcase::flatbuffers() const {
+std::vector<uint8_t> Testcase::flatbuffers(
+    const SerializationOptions& options, detail::string_table* strings) const {
   flatbuffers::FlatBufferBuilder builder;
-  const auto& fbsMetadata = fbs::CreateMetadataDirect(
-      builder, _metadata.testsuite.c_str(), _metadata.version.c_str(),
-      _metadata.testcase.c_str(), _metadata.builtAt.c_str(),
-      _metadata.teamslug.c_str());
+  const auto& fbsMetadata =
+      strings ? fbs::CreateMetadataDirect(
+                    builder, nullptr, nullptr, _metadata.testcase.c_str(),
+                    _metadata.builtAt.c_str(), nullptr,
+                    strings->add(_metadata.testsuite),
+                    strings->add(_metadata.version),
+                    strings->add(_metadata.teamslug))
+              : fbs::CreateMetadataDirect(
+                    builder, _metadata.testsuite.c_str(),
+                    _metadata.version.c_str(), _metadata.testcase.c_str(),
+                    _metadata.builtAt.c_str(), _metadata.teamslug.c_str());
 
   // serialize results map
 
+  detail::subtree_cache cache;
+  auto subtrees = options.deduplicate ? &cache : nullptr;
   std::vector<flatbuffers::Offset<fbs::Result>> fbsResultEntries;
   for (const auto& result : _resultsMap) {
     const auto& key = result.first.c_str();
-    const auto& value = result.second.val.serialize(builder);
+    const auto& value =
+        result.second.val.serialize(builder, options, strings, subtrees);
     const auto& type = result.second.typ == ResultCategory::Assert
                            ? fbs::ResultType::Assert
                            : fbs::ResultType::Check;
-    const auto& entry = fbs::CreateResultDirect(builder, key, value, type);
+    const auto& entry =
+        strings ? fbs::CreateResult(builder, 0, value, type,
+                                    strings->add(result.first))
+                : fbs::CreateResultDirect(builder, key, value, type);
     fbsResultEntries.push_back(entry);
   }
   const auto& fbsResults = fbs::CreateResultsDirect(builder, &fbsResultEntries);
@@ -228,8 +251,11 @@ std::vector<uint8_t> Testcase::flatbuffers() const {
   std::vector<flatbuffers::Offset<fbs::Metric>> fbsMetricEntries;
   for (const auto& metric : metrics()) {
     const auto& key = metric.first.c_str();
-    const auto& value = metric.second.value.serialize(builder);
-    const auto& entry = fbs::CreateMetricDirect(builder, key, value);
+    const auto& value = metric.second.value.serialize(builder, options);
+    const auto& entry =
+        strings
+            ? fbs::CreateMetric(builder, 0, value, strings->add(metric.first))
+            : fbs::CreateMetricDirect(builder, key, value);
     fbsMetricEntries.push_back(entry);
   }
   const auto& fbsMetrics = fbs::CreateMetricsDirect(builder, &fbsMetricEntries);
@@ -272,31 +298,187 @@ void Testcase::clear() {
   _tocs.clear();
 }
 
+/**
+ * @return whether a given integer converts to a given floating point type
+ *         and back without losing its value
+ */
+template <typename T>
+bool preserves(const detail::number_signed_t number) {
+  const auto converted = static_cast<T>(number);
+  const auto limit = std::ldexp(T(1), 63);
+  return -limit <= converted && converted < limit &&
+         static_cast<detail::number_signed_t>(converted) == number;
+}
+
+/**
+ * @return whether a given number converts to single precision and back
+ *         without losing its value
+ */
+bool preserves(const detail::number_double_t number) {
+  if (std::isnan(number) || std::isinf(number)) {
+    return true;
+  }
+  const auto limit = std::numeric_limits<detail::number_float_t>::max();
+  return std::fabs(number) <= limit &&
+         static_cast<detail::number_double_t>(
+             static_cast<detail::number_float_t>(number)) == number;
+}
+
+/**
+ * Converts a number to the numeric type of a given value where the
+ * conversion preserves the number, descending into arrays and objects.
+ */
+void conform_number(data_point& value, const data_point& reference) {
+  using detail::internal_type;
+  const auto target = reference.type();
+  switch (value.type()) {
+    case internal_type::array:
+      if (target == internal_type::array) {
+        auto& elements = *value.as_array();
+        const auto& others = *reference.as_array();
+        for (std::size_t i = 0; i < elements.size() && i < others.size(); ++i) {
+          conform_number(elements[i], others[i]);
+        }
+      }
+      break;
+    case internal_type::object:
+      if (target == internal_type::object) {
+        const auto& others = *reference.as_object();
+        for (auto& member : *value.as_object()) {
+          const auto& other = others.find(member.first);
+          if (other != others.end()) {
+            conform_number(member.second, other->second);
+          }
+        }
+      }
+      break;
+    case internal_type::number_signed: {
+      const auto number = value.as_number_signed();
+      if (target == internal_type::number_unsigned && number >= 0) {
+        value = data_point::number_unsigned(
+            static_cast<detail::number_unsigned_t>(number));
+      } else if (target == internal_type::number_double &&
+                 preserves<detail::number_double_t>(number)) {
+        value = data_point::number_double(
+            static_cast<detail::number_double_t>(number));
+      } else if (target == internal_type::number_float &&
+                 preserves<detail::number_float_t>(number)) {
+        value = data_point::number_float(
+            static_cast<detail::number_float_t>(number));
+      }
+      break;
+    }
+    case internal_type::number_double:
+      if (target == internal_type::number_float &&
+          preserves(value.as_number_double())) {
+        value = data_point::number_float(
+            static_cast<detail::number_float_t>(value.as_number_double()));
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void Testcase::conform_numbers(const Testcase& reference) {
+  for (auto& entry : _resultsMap) {
+    const auto& other = reference._resultsMap.find(entry.first);
+    if (other != reference._resultsMap.end()) {
+      conform_number(entry.second.val, other->second.val);
+    }
+  }
+}
+
 std::vector<uint8_t> Testcase::serialize(
-    const std::vector<Testcase>& testcases) {
+    const std::vector<Testcase>& testcases,
+    const SerializationOptions& options) {
   flatbuffers::FlatBufferBuilder builder;
+  detail::string_table table;
+  auto strings = options.string_table ? &table : nullptr;
   std::vector<flatbuffers::Offset<fbs::MessageBuffer>> messageBuffers;
   for (const auto& tc : testcases) {
-    const auto& out = tc.flatbuffers();
-    messageBuffers.push_back(fbs::CreateMessageBufferDirect(builder, &out));
+    const auto& out = tc.flatbuffers(options, strings);
+    if (options.compression == Compression::None) {
+      messageBuffers.push_back(fbs::CreateMessageBufferDirect(builder, &out));
+      continue;
+    }
+    const auto& frame =
+        detail::compress(options.compression, options.compression_level,
+                         out.data(), out.size());
+    messageBuffers.push_back(fbs::CreateMessageBufferDirect(
+        builder, nullptr, &frame,
+        static_cast<fbs::Compression>(options.compression), out.size()));
   }
-  const auto& messages = fbs::CreateMessagesDirect(builder, &messageBuffers);
+
+  // serialize strings shared by all testcases as a nested buffer so that
+  // they can be loaded on their own when reading a single testcase
+
+  std::vector<uint8_t> dictionary;
+  if (strings) {
+    flatbuffers::FlatBufferBuilder dictionary_builder;
+    dictionary_builder.Finish(fbs::CreateDictionary(
+        dictionary_builder,
+        dictionary_builder.CreateVectorOfStrings(table.values())));
+    const auto& ptr = dictionary_builder.GetBufferPointer();
+    dictionary.assign(ptr, ptr + dictionary_builder.GetSize());
+  }
+  const auto& messages = fbs::CreateMessagesDirect(
+      builder, &messageBuffers, strings ? &dictionary : nullptr);
   builder.Finish(messages);
   const auto& ptr = builder.GetBufferPointer();
   return {ptr, ptr + builder.GetSize()};
 }
 
-std::string elements_map_to_json(const ElementsMap& elements_map) {
-  rapidjson::Document doc(rapidjson::kArrayType);
-  rapidjson::Document::AllocatorType& allocator = doc.GetAllocator();
+/**
+ * Writes given testcases as a json array. Numbers are written with as many
+ * digits as it takes to read them back without losing precision, so that
+ * result files in json format compare equal to their binary counterparts.
+ */
+template <typename Writer>
+void write_testcases(Writer& writer,
+                     const std::vector<const Testcase*>& testcases) {
+  writer.StartArray();
+  for (const auto& testcase : testcases) {
+    if (!testcase->write_json(writer)) {
+      throw touca::detail::runtime_error(touca::detail::format(
+          "failed to write testcase {} as json",
+          testcase->metadata().testcase));
+    }
+  }
+  writer.EndArray();
+}
+
+std::vector<const Testcase*> list_testcases(const ElementsMap& elements_map) {
+  std::vector<const Testcase*> testcases;
+  testcases.reserve(elements_map.size());
   for (const auto& item : elements_map) {
-    doc.PushBack(item.second->json(allocator), allocator);
+    testcases.push_back(item.second.get());
   }
+  return testcases;
+}
+
+std::string testcases_to_json(const std::vector<const Testcase*>& testcases) {
   rapidjson::StringBuffer strbuf;
   rapidjson::Writer<rapidjson::StringBuffer> writer(strbuf);
-  writer.SetMaxDecimalPlaces(3);
-  doc.Accept(writer);
-  return strbuf.GetString();
+  write_testcases(writer, testcases);
+  return {strbuf.GetString(), strbuf.GetSize()};
+}
+
+void write_json(std::FILE* file,
+                const std::vector<const Testcase*>& testcases) {
+  std::vector<char> buffer(64u << 10);
+  rapidjson::FileWriteStream stream(file, buffer.data(), buffer.size());
+  rapidjson::Writer<rapidjson::FileWriteStream> writer(stream);
+  write_testcases(writer, testcases);
+  stream.Flush();
+}
+
+std::string elements_map_to_json(const ElementsMap& elements_map) {
+  return testcases_to_json(list_testcases(elements_map));
+}
+
+void write_json(std::FILE* file, const ElementsMap& elements_map) {
+  write_json(file, list_testcases(elements_map));
 }
 
 }  // namespace touca
@@ -0,0 +1,220 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/text_diff.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "touca/core/digest.hpp"
+
+namespace touca {
+namespace detail {
+
+namespace {
+
+/**
+ * Line of a text, without its line break. Lines are told apart by their
+ * digest before their content is compared.
+ */
+struct text_line {
+  const char* data;
+  std::size_t size;
+  std::uint64_t digest;
+};
+
+bool operator==(const text_line& lhs, const text_line& rhs) {
+  return lhs.digest == rhs.digest && lhs.size == rhs.size &&
+         0 == std::memcmp(lhs.data, rhs.data, lhs.size);
+}
+
+std::vector<text_line> split_lines(const std::string& text) {
+  std::vector<text_line> out;
+  std::size_t begin = 0;
+  while (true) {
+    const auto end = text.find('\n', begin);
+    const auto size = (end == std::string::npos ? text.size() : end) - begin;
+    const auto data = text.data() + begin;
+    out.push_back({data, size, touca::detail::digest(data, size)});
+    if (end == std::string::npos) {
+      return out;
+    }
+    begin = end + 1;
+  }
+}
+
+enum class edit : unsigned char {
+  keep,   /**< line is in both texts */
+  remove, /**< line is only in `src` */
+  insert  /**< line is only in `dst` */
+};
+
+/**
+ * Picks the diagonal from which the furthest reaching path with `d` edits
+ * on diagonal `k` continues: the diagonal above it if the path inserts a
+ * line or the diagonal below it if the path removes a line.
+ *
+ * @param reach function that provides how far along `src` each diagonal
+ *              reaches with `d - 1` edits
+ */
+template <typename Reach>
+std::ptrdiff_t previous_diagonal(const std::ptrdiff_t d,
+                                 const std::ptrdiff_t k, Reach reach) {
+  return k == -d || (k != d && reach(k - 1) < reach(k + 1)) ? k + 1 : k - 1;
+}
+
+/**
+ * Walks back from the end of both texts, reached with `d` edits, to their
+ * start and collects the edits on the way.
+ */
+void walk_back(const std::vector<std::ptrdiff_t>& trace, std::ptrdiff_t d,
+               std::ptrdiff_t x, std::ptrdiff_t y, std::vector<edit>& out) {
+  for (; 0 < d; --d) {
+    // reach of diagonals `-d` through `d` before the `d`-th edit
+    const auto reach = [&trace, d](const std::ptrdiff_t k) {
+      return trace[static_cast<std::size_t>(d * d + d + k)];
+    };
+    const auto prev_k = previous_diagonal(d, x - y, reach);
+    const auto prev_x = reach(prev_k);
+    const auto prev_y = prev_x - prev_k;
+    for (; prev_x < x && prev_y < y; --x, --y) {
+      out.push_back(edit::keep);
+    }
+    out.push_back(x == prev_x ? edit::insert : edit::remove);
+    x = prev_x;
+    y = prev_y;
+  }
+  out.insert(out.end(), static_cast<std::size_t>(x), edit::keep);
+  std::reverse(out.begin(), out.end());
+}
+
+/**
+ * Finds the shortest sequence of edits that turns `n` lines of `src` into
+ * `m` lines of `dst`. For each number of edits `d`, we keep how far along
+ * `src` each diagonal `k = x - y` can reach with `d` edits, so that we can
+ * walk back from the end once it is reached.
+ *
+ * @return whether the lines could be turned into each other with no more
+ *         than `max_edits` lines inserted or removed
+ */
+bool find_edits(const text_line* src, const std::size_t n,
+                const text_line* dst, const std::size_t m,
+                const std::size_t max_edits, std::vector<edit>& out) {
+  const auto max_d =
+      static_cast<std::ptrdiff_t>(std::min<std::size_t>(n + m, max_edits));
+  const auto width = static_cast<std::ptrdiff_t>(n);
+  const auto height = static_cast<std::ptrdiff_t>(m);
+  const auto offset = max_d + 1;
+  std::vector<std::ptrdiff_t> v(static_cast<std::size_t>(2 * offset + 1), 0);
+  const auto reach = [&v, offset](const std::ptrdiff_t k) {
+    return v[static_cast<std::size_t>(offset + k)];
+  };
+  std::vector<std::ptrdiff_t> trace;
+  for (std::ptrdiff_t d = 0; d <= max_d; ++d) {
+    trace.insert(trace.end(), v.begin() + offset - d,
+                 v.begin() + offset + d + 1);
+    for (auto k = -d; k <= d; k += 2) {
+      const auto prev_k = previous_diagonal(d, k, reach);
+      auto x = 0 == d ? 0 : reach(prev_k) + (prev_k < k ? 1 : 0);
+      auto y = x - k;
+      while (x < width && y < height && src[x] == dst[y]) {
+        ++x;
+        ++y;
+      }
+      v[static_cast<std::size_t>(offset + k)] = x;
+      if (width <= x && height <= y) {
+        walk_back(trace, d, x, y, out);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+double TextComparison::similarity() const {
+  const auto total = src_lines + dst_lines;
+  return 0u == total ? 1.0 : 2.0 * common_lines / total;
+}
+
+TextComparison compare_lines(const std::string& src, const std::string& dst,
+                             const std::size_t max_hunks,
+                             const std::size_t max_edits) {
+  const auto& lhs = split_lines(src);
+  const auto& rhs = split_lines(dst);
+  TextComparison out;
+  out.src_lines = lhs.size();
+  out.dst_lines = rhs.size();
+
+  // lines at the start and end of both texts are usually the same, and
+  // are set aside so that only the lines in between are compared.
+  std::size_t prefix = 0;
+  while (prefix < lhs.size() && prefix < rhs.size() &&
+         lhs[prefix] == rhs[prefix]) {
+    ++prefix;
+  }
+  std::size_t suffix = 0;
+  while (suffix < lhs.size() - prefix && suffix < rhs.size() - prefix &&
+         lhs[lhs.size() - 1 - suffix] == rhs[rhs.size() - 1 - suffix]) {
+    ++suffix;
+  }
+  const auto n = lhs.size() - prefix - suffix;
+  const auto m = rhs.size() - prefix - suffix;
+  out.common_lines = prefix + suffix;
+
+  const auto& add_hunk = [&out, max_hunks](const TextHunk& hunk) {
+    ++out.hunk_count;
+    if (out.hunks.size() < max_hunks) {
+      out.hunks.push_back(hunk);
+    }
+  };
+  std::vector<edit> edits;
+  if (!find_edits(lhs.data() + prefix, n, rhs.data() + prefix, m, max_edits,
+                  edits)) {
+    out.complete = false;
+    TextHunk hunk;
+    hunk.src_line = hunk.dst_line = prefix;
+    hunk.src_count = n;
+    hunk.dst_count = m;
+    add_hunk(hunk);
+    return out;
+  }
+
+  TextHunk hunk;
+  auto open = false;
+  auto i = prefix;
+  auto j = prefix;
+  for (const auto op : edits) {
+    if (op == edit::keep) {
+      if (open) {
+        add_hunk(hunk);
+        open = false;
+      }
+      ++out.common_lines;
+      ++i;
+      ++j;
+      continue;
+    }
+    if (!open) {
+      hunk = TextHunk();
+      hunk.src_line = i;
+      hunk.dst_line = j;
+      open = true;
+    }
+    if (op == edit::remove) {
+      ++hunk.src_count;
+      ++i;
+    } else {
+      ++hunk.dst_count;
+      ++j;
+    }
+  }
+  if (open) {
+    add_hunk(hunk);
+  }
+  return out;
+}
+
+}  // namespace detail
+}  // namespace touca
@@ -0,0 +1,166 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/thread_pool.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "touca/core/filesystem.hpp"
+
+namespace touca {
+namespace detail {
+
+namespace {
+
+/** pool that owns the current thread, if any, and the queue of that thread */
+thread_local ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_queue = 0;
+
+}  // namespace
+
+struct ThreadPool::Batch {
+  explicit Batch(const std::size_t count) : pending(count) {}
+
+  std::atomic<std::size_t> pending;
+  std::mutex mutex;
+  std::string error;
+};
+
+ThreadPool::ThreadPool(const std::size_t size) {
+  const auto count = std::max<std::size_t>(
+      size ? size : std::thread::hardware_concurrency(), 1u);
+  for (std::size_t i = 0; i < count; ++i) {
+    _queues.emplace_back(new Queue());
+  }
+  // the first queue is shared by threads outside of this pool
+  for (std::size_t i = 1; i < count; ++i) {
+    _threads.emplace_back(&ThreadPool::work, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopped = true;
+  }
+  _changed.notify_all();
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::run(std::vector<std::function<void()>> tasks) {
+  if (tasks.empty()) {
+    return;
+  }
+  Batch batch(tasks.size());
+  const auto index = own_queue();
+  {
+    auto& queue = *_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    for (auto& task : tasks) {
+      queue.tasks.push_back(Task{std::move(task), &batch});
+    }
+  }
+  _queued += tasks.size();
+  { std::lock_guard<std::mutex> lock(_mutex); }
+  _changed.notify_all();
+
+  // tasks that the calling thread runs while it waits belong to this pool
+  const auto outer_pool = current_pool;
+  const auto outer_queue = current_queue;
+  current_pool = this;
+  current_queue = index;
+  Task task;
+  while (batch.pending != 0) {
+    if (pop(index, task)) {
+      execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait(lock, [this, &batch] {
+      return batch.pending == 0 || _queued != 0;
+    });
+  }
+  current_pool = outer_pool;
+  current_queue = outer_queue;
+  if (!batch.error.empty()) {
+    throw touca::detail::runtime_error(batch.error);
+  }
+}
+
+ThreadPool* ThreadPool::current() {
+  return current_pool;
+}
+
+std::size_t ThreadPool::own_queue() const {
+  return current_pool == this ? current_queue : 0;
+}
+
+/**
+ * Takes the task queued most recently to the queue with given index or,
+ * if that queue is empty, the task queued least recently to any other.
+ */
+bool ThreadPool::pop(const std::size_t index, Task& task) {
+  for (std::size_t i = 0; i < _queues.size() && _queued != 0; ++i) {
+    auto& queue = *_queues[(index + i) % _queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --_queued;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::execute(Task& task) {
+  std::string error;
+  try {
+    task.run();
+  } catch (const std::exception& ex) {
+    error = ex.what();
+  } catch (...) {
+    error = "unknown error";
+  }
+  auto& batch = *task.batch;
+  task.run = nullptr;
+  if (!error.empty()) {
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    if (batch.error.empty()) {
+      batch.error = error;
+    }
+  }
+  // the batch may be gone as soon as its last task is counted as done
+  if (--batch.pending == 0) {
+    { std::lock_guard<std::mutex> lock(_mutex); }
+    _changed.notify_all();
+  }
+}
+
+void ThreadPool::work(const std::size_t index) {
+  current_pool = this;
+  current_queue = index;
+  Task task;
+  while (true) {
+    if (pop(index, task)) {
+      execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait(lock, [this] { return _stopped || _queued != 0; });
+    if (_stopped) {
+      return;
+    }
+  }
+}
+
+}  // namespace detail
+}  // namespace touca
@@ -87,5 +87,22 @@ void set_client_options(const ClientOptions& options) {
 const std::unique_ptr<Transport>& get_client_transport() {
   return instance.get_client_transport();
 }
+/** see ClientImpl::serialization_options */
+SerializationOptions get_serialization_options() {
+  return instance.serialization_options();
+}
+/** see ClientImpl::serialize */
+std::vector<std::uint8_t> serialize_binary(const std::string& testcase) {
+  return instance.serialize({testcase}, DataFormat::FBS);
+}
+/** see ClientImpl::serialize */
+std::vector<std::uint8_t> serialize_json(const std::string& testcase) {
+  return instance.serialize({testcase}, DataFormat::JSON);
+}
+/** see ClientImpl::serialize_message */
+std::vector<std::uint8_t> serialize_message(
+    const std::string& testcase, const SerializationOptions& options) {
+  return instance.serialize_message(testcase, options);
+}
 }  // namespace detail
 }  // namespace touca
@@ -2,21 +2,180 @@
 
 #include "touca/core/types.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <type_traits>
 #include <utility>
 
 #include "flatbuffers/flatbuffers.h"
+#include "fmt/format.h"
 #include "rapidjson/document.h"
 #include "rapidjson/rapidjson.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "touca/core/digest.hpp"
 #include "touca/core/variant.hpp"
 #include "touca/impl/schema.hpp"
 
 namespace touca {
 namespace detail {
 
+std::uint32_t string_table::add(const std::string& value) {
+  const auto& it = _ids.find(value);
+  if (it != _ids.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<std::uint32_t>(_values.size());
+  _ids.emplace(value, id);
+  _values.push_back(value);
+  return id;
+}
+
+/**
+ * Objects, arrays and strings are the only values whose serialized form is
+ * large enough to be worth sharing.
+ */
+bool is_subtree(const internal_type type) {
+  return type == internal_type::object || type == internal_type::array ||
+         type == internal_type::string;
+}
+
+template <typename T>
+void update_digest(xxh64& state, const T& value) {
+  state.update(&value, sizeof(value));
+}
+
+void update_digest(xxh64& state, const std::string& value) {
+  update_digest(state, value.size());
+  state.update(value.data(), value.size());
+}
+
+std::uint32_t subtree_cache::find(const data_point& value) {
+  if (!is_subtree(value.type())) {
+    return 0;
+  }
+  const auto& range = _offsets.equal_range(hash(value));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (is_same(*it->second.first, value)) {
+      return it->second.second;
+    }
+  }
+  return 0;
+}
+
+void subtree_cache::add(const data_point& value, const std::uint32_t offset) {
+  if (is_subtree(value.type())) {
+    _offsets.emplace(hash(value), std::make_pair(&value, offset));
+  }
+}
+
+/**
+ * Computes digest of a given value from the digests of its elements and
+ * remembers it, so that hashing nested values is linear in their size.
+ */
+std::uint64_t subtree_cache::hash(const data_point& value) {
+  const auto& it = _digests.find(&value);
+  if (it != _digests.end()) {
+    return it->second;
+  }
+  xxh64 state;
+  update_digest(state, value._type);
+  switch (value._type) {
+    case internal_type::object: {
+      const auto& obj = get<deep_copy_ptr<object>>(value._value);
+      update_digest(state, obj->get_name());
+      for (const auto& member : *obj) {
+        update_digest(state, member.first);
+        update_digest(state, hash(member.second));
+      }
+      break;
+    }
+    case internal_type::array:
+      for (const auto& element : *value.as_array()) {
+        update_digest(state, hash(element));
+      }
+      break;
+    case internal_type::string:
+      update_digest(state, *value.as_string());
+      break;
+    case internal_type::boolean:
+      update_digest(state, value.as_boolean());
+      break;
+    case internal_type::number_signed:
+      update_digest(state, value.as_number_signed());
+      break;
+    case internal_type::number_unsigned:
+      update_digest(state, value.as_number_unsigned());
+      break;
+    case internal_type::number_float:
+      update_digest(state, value.as_number_float());
+      break;
+    case internal_type::number_double:
+      update_digest(state, value.as_number_double());
+      break;
+    default:
+      break;
+  }
+  const auto digest = state.digest();
+  if (is_subtree(value._type)) {
+    _digests.emplace(&value, digest);
+  }
+  return digest;
+}
+
+/**
+ * Checks whether two values have identical serialized forms. Unlike
+ * `compare`, numbers are compared bitwise so that values such as `0.0`
+ * and `-0.0` are kept apart.
+ */
+bool subtree_cache::is_same(const data_point& lhs, const data_point& rhs) {
+  if (lhs._type != rhs._type) {
+    return false;
+  }
+  switch (lhs._type) {
+    case internal_type::object: {
+      const auto& left = get<deep_copy_ptr<object>>(lhs._value);
+      const auto& right = get<deep_copy_ptr<object>>(rhs._value);
+      return left->get_name() == right->get_name() &&
+             lhs.as_object()->size() == rhs.as_object()->size() &&
+             std::equal(left->begin(), left->end(), right->begin(),
+                        [](const object_t::value_type& a,
+                           const object_t::value_type& b) {
+                          return a.first == b.first &&
+                                 is_same(a.second, b.second);
+                        });
+    }
+    case internal_type::array: {
+      const auto& left = *lhs.as_array();
+      const auto& right = *rhs.as_array();
+      return left.size() == right.size() &&
+             std::equal(left.begin(), left.end(), right.begin(), is_same);
+    }
+    case internal_type::string:
+      return *lhs.as_string() == *rhs.as_string();
+    case internal_type::boolean:
+      return lhs.as_boolean() == rhs.as_boolean();
+    case internal_type::number_signed:
+      return lhs.as_number_signed() == rhs.as_number_signed();
+    case internal_type::number_unsigned:
+      return lhs.as_number_unsigned() == rhs.as_number_unsigned();
+    case internal_type::number_float: {
+      const auto left = lhs.as_number_float();
+      const auto right = rhs.as_number_float();
+      return 0 == std::memcmp(&left, &right, sizeof(left));
+    }
+    case internal_type::number_double: {
+      const auto left = lhs.as_number_double();
+      const auto right = rhs.as_number_double();
+      return 0 == std::memcmp(&left, &right, sizeof(left));
+    }
+    default:
+      return true;
+  }
+}
+
 flatbuffers::Offset<fbs::TypeWrapper> serialize(
     flatbuffers::FlatBufferBuilder& builder,
     const touca::detail::boolean_t value) {
@@ -59,45 +218,149 @@ flatbuffers::Offset<fbs::TypeWrapper> serialize(
   return fbs::CreateTypeWrapper(builder, fbs::Type::String, fbsValue.Union());
 }
 
-flatbuffers::Offset<fbs::TypeWrapper> serialize(
+template <typename T, typename Getter>
+flatbuffers::Offset<flatbuffers::Vector<T>> create_scalar_vector(
+    flatbuffers::FlatBufferBuilder& builder, const array& elements,
+    Getter get) {
+  std::vector<T> values;
+  values.reserve(std::distance(elements.begin(), elements.end()));
+  for (const auto& element : elements) {
+    values.push_back(static_cast<T>(get(element)));
+  }
+  return builder.CreateVector(values);
+}
+
+/**
+ * Writes a non-empty array whose elements are all booleans or all numbers
+ * of the same type as a packed vector of scalars. Returns a null offset for
+ * any other array.
+ */
+flatbuffers::Offset<fbs::TypeWrapper> serialize_packed(
     flatbuffers::FlatBufferBuilder& builder, const array& elements) {
+  if (elements.begin() == elements.end()) {
+    return 0;
+  }
+  const auto type = elements.begin()->type();
+  for (const auto& element : elements) {
+    if (element.type() != type) {
+      return 0;
+    }
+  }
+  switch (type) {
+    case internal_type::boolean: {
+      const auto& values = create_scalar_vector<uint8_t>(
+          builder, elements,
+          [](const data_point& value) { return value.as_boolean(); });
+      return fbs::CreateTypeWrapper(
+          builder, fbs::Type::BoolVector,
+          fbs::CreateBoolVector(builder, values).Union());
+    }
+    case internal_type::number_signed: {
+      const auto& values = create_scalar_vector<number_signed_t>(
+          builder, elements,
+          [](const data_point& value) { return value.as_number_signed(); });
+      return fbs::CreateTypeWrapper(
+          builder, fbs::Type::IntVector,
+          fbs::CreateIntVector(builder, values).Union());
+    }
+    case internal_type::number_unsigned: {
+      const auto& values = create_scalar_vector<number_unsigned_t>(
+          builder, elements,
+          [](const data_point& value) { return value.as_number_unsigned(); });
+      return fbs::CreateTypeWrapper(
+          builder, fbs::Type::UIntVector,
+          fbs::CreateUIntVector(builder, values).Union());
+    }
+    case internal_type::number_float: {
+      const auto& values = create_scalar_vector<number_float_t>(
+          builder, elements,
+          [](const data_point& value) { return value.as_number_float(); });
+      return fbs::CreateTypeWrapper(
+          builder, fbs::Type::FloatVector,
+          fbs::CreateFloatVector(builder, values).Union());
+    }
+    case internal_type::number_double: {
+      const auto& values = create_scalar_vector<number_double_t>(
+          builder, elements,
+          [](const data_point& value) { return value.as_number_double(); });
+      return fbs::CreateTypeWrapper(
+          builder, fbs::Type::DoubleVector,
+          fbs::CreateDoubleVector(builder, values).Union());
+    }
+    default:
+      return 0;
+  }
+}
+
+flatbuffers::Offset<fbs::TypeWrapper> serialize(
+    flatbuffers::FlatBufferBuilder& builder, const array& elements,
+    const SerializationOptions& options, string_table* strings,
+    subtree_cache* subtrees) {
+  if (options.packed_arrays) {
+    const auto& packed = serialize_packed(builder, elements);
+    if (!packed.IsNull()) {
+      return packed;
+    }
+  }
   std::vector<flatbuffers::Offset<fbs::TypeWrapper>> entries;
   for (const auto& element : elements) {
-    entries.push_back(element.serialize(builder));
+    entries.push_back(element.serialize(builder, options, strings, subtrees));
   }
   const auto& fbsValue = fbs::CreateArrayDirect(builder, &entries);
   return fbs::CreateTypeWrapper(builder, fbs::Type::Array, fbsValue.Union());
 }
 
 flatbuffers::Offset<fbs::TypeWrapper> serialize(
-    flatbuffers::FlatBufferBuilder& builder, const object& obj) {
+    flatbuffers::FlatBufferBuilder& builder, const object& obj,
+    const SerializationOptions& options, string_table* strings,
+    subtree_cache* subtrees) {
   std::vector<flatbuffers::Offset<fbs::ObjectMember>> members;
   for (const auto& value : obj) {
-    members.push_back(fbs::CreateObjectMemberDirect(
-        builder, value.first.c_str(), value.second.serialize(builder)));
+    const auto& member =
+        value.second.serialize(builder, options, strings, subtrees);
+    members.push_back(
+        strings ? fbs::CreateObjectMember(builder, 0, member,
+                                          strings->add(value.first))
+                : fbs::CreateObjectMemberDirect(builder, value.first.c_str(),
+                                                member));
   }
   const auto& fbsValue =
-      fbs::CreateObjectDirect(builder, obj.get_name().c_str(), &members);
+      strings ? fbs::CreateObjectDirect(builder, nullptr, &members,
+                                        strings->add(obj.get_name()))
+              : fbs::CreateObjectDirect(builder, obj.get_name().c_str(),
+                                        &members);
   return fbs::CreateTypeWrapper(builder, fbs::Type::Object, fbsValue.Union());
 }
 
 class data_point_serializer_visitor {
   flatbuffers::FlatBufferBuilder& _builder;
+  const SerializationOptions& _options;
+  string_table* _strings;
+  subtree_cache* _subtrees;
 
  public:
-  explicit data_point_serializer_visitor(
-      flatbuffers::FlatBufferBuilder& builder)
-      : _builder(builder) {}
+  data_point_serializer_visitor(flatbuffers::FlatBufferBuilder& builder,
+                                const SerializationOptions& options,
+                                string_table* strings, subtree_cache* subtrees)
+      : _builder(builder),
+        _options(options),
+        _strings(strings),
+        _subtrees(subtrees) {}
 
   template <typename T>
   flatbuffers::Offset<fbs::TypeWrapper> operator()(const T& value) {
     return serialize(_builder, value);
   }
 
+  flatbuffers::Offset<fbs::TypeWrapper> operator()(
+      const touca::detail::deep_copy_ptr<string_t>& ptr) {
+    return serialize(_builder, *ptr);
+  }
+
   template <typename T>
   flatbuffers::Offset<fbs::TypeWrapper> operator()(
       const touca::detail::deep_copy_ptr<T>& ptr) {
-    return serialize(_builder, *ptr);
+    return serialize(_builder, *ptr, _options, _strings, _subtrees);
   }
 
   flatbuffers::Offset<fbs::TypeWrapper> operator()(std::nullptr_t) {
@@ -179,23 +442,78 @@ void data_point::increment() noexcept {
 }
 
 flatbuffers::Offset<fbs::TypeWrapper> data_point::serialize(
-    flatbuffers::FlatBufferBuilder& builder) const {
-  return touca::detail::visit(
-      touca::detail::data_point_serializer_visitor(builder), _value);
+    flatbuffers::FlatBufferBuilder& builder,
+    const SerializationOptions& options, detail::string_table* strings,
+    detail::subtree_cache* subtrees) const {
+  if (subtrees) {
+    const auto offset = subtrees->find(*this);
+    if (offset) {
+      return flatbuffers::Offset<fbs::TypeWrapper>(offset);
+    }
+  }
+  const auto& out = touca::detail::visit(
+      touca::detail::data_point_serializer_visitor(builder, options, strings,
+                                                   subtrees),
+      _value);
+  if (subtrees) {
+    subtrees->add(*this, out.o);
+  }
+  return out;
 }
 
 std::string data_point::to_string() const {
-  rapidjson::Document doc;
-  auto& allocator = doc.GetAllocator();
-  const auto& value = to_json(*this, allocator);
-  if (value.IsString()) {
-    return value.GetString();
-  }
-  rapidjson::StringBuffer strbuf;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(strbuf);
+  std::string out;
+  to_string(out);
+  return out;
+}
+
+void data_point::to_string(std::string& out) const {
+  to_string(out, std::string::npos);
+}
+
+/**
+ * Appends as much of given content to a given string as fits in a given
+ * size.
+ *
+ * @return whether the content was appended in full
+ */
+bool append_bounded(std::string& out, const char* data, const std::size_t size,
+                    const std::size_t max_size) {
+  const auto room = max_size - std::min(max_size, out.size());
+  out.append(data, std::min(room, size));
+  return size <= room;
+}
+
+bool data_point::to_string(std::string& out, const std::size_t max_size) const {
+  out.clear();
+  switch (_type) {
+    case detail::internal_type::null:
+      return append_bounded(out, "null", 4, max_size);
+    case detail::internal_type::string:
+      return append_bounded(out, as_string()->data(), as_string()->size(),
+                            max_size);
+    case detail::internal_type::boolean:
+      return as_boolean() ? append_bounded(out, "true", 4, max_size)
+                          : append_bounded(out, "false", 5, max_size);
+    case detail::internal_type::number_signed: {
+      const fmt::format_int number(as_number_signed());
+      return append_bounded(out, number.data(), number.size(), max_size);
+    }
+    case detail::internal_type::number_unsigned: {
+      const fmt::format_int number(as_number_unsigned());
+      return append_bounded(out, number.data(), number.size(), max_size);
+    }
+    default:
+      break;
+  }
+  // floating point numbers are left to rapidjson, whose limit on decimal
+  // places fmt does not reproduce. each thread keeps its own writer to reuse
+  // the stack that the writer allocates for nested values.
+  thread_local rapidjson::Writer<detail::string_output_stream> writer;
+  detail::string_output_stream stream(out, max_size);
+  writer.Reset(stream);
   writer.SetMaxDecimalPlaces(3);
-  value.Accept(writer);
-  return strbuf.GetString();
+  return write_json(writer) && !stream.truncated();
 }
 
 rapidjson::Value to_json(const data_point& value, RJAllocator& allocator) {
@@ -0,0 +1,70 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/array_kernels.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+using touca::detail::ArrayKernel;
+using touca::detail::compare_numeric_arrays;
+
+template <typename T>
+void check_kernels(const std::vector<T>& src, const std::vector<T>& dst) {
+  const auto& expected = compare_numeric_arrays(
+      src.data(), dst.data(), src.size(), 4, ArrayKernel::Scalar);
+  for (const auto kernel : {ArrayKernel::SSE2, ArrayKernel::AVX2}) {
+    const auto& actual =
+        compare_numeric_arrays(src.data(), dst.data(), src.size(), 4, kernel);
+    CHECK(actual.matches == expected.matches);
+    CHECK(actual.score == expected.score);
+    CHECK(actual.mismatches == expected.mismatches);
+  }
+}
+
+TEST_CASE("numeric array kernels") {
+  SECTION("integers") {
+    std::vector<std::int64_t> src(37, 10);
+    auto dst = src;
+    dst[3] = 11;
+    dst[20] = -10;
+    dst[36] = std::int64_t(1) << 40;
+    const auto& cmp = compare_numeric_arrays(
+        src.data(), dst.data(), src.size(), 2, ArrayKernel::Scalar);
+    CHECK(cmp.matches == 34u);
+    CHECK(cmp.score == Approx(1.0 - 1.0 / 11));
+    CHECK(cmp.mismatches == std::vector<std::size_t>{3, 20});
+    check_kernels(src, dst);
+
+    const std::vector<std::uint64_t> lhs(src.begin(), src.end());
+    const std::vector<std::uint64_t> rhs(dst.begin(), dst.end());
+    check_kernels(lhs, rhs);
+  }
+
+  SECTION("floating point") {
+    std::vector<double> src(29, 2.5);
+    auto dst = src;
+    dst[0] = 2.0;
+    dst[9] = 0.0;
+    src[17] = dst[17] = std::numeric_limits<double>::quiet_NaN();
+    const auto& cmp = compare_numeric_arrays(
+        src.data(), dst.data(), src.size(), 8, ArrayKernel::Scalar);
+    CHECK(cmp.matches == 26u);
+    CHECK(cmp.score == 0.0);
+    CHECK(cmp.mismatches == std::vector<std::size_t>{0, 9, 17});
+    check_kernels(src, dst);
+
+    const std::vector<float> lhs(src.begin(), src.end());
+    const std::vector<float> rhs(dst.begin(), dst.end());
+    check_kernels(lhs, rhs);
+  }
+
+  SECTION("empty") {
+    const std::vector<double> empty;
+    const auto& cmp = compare_numeric_arrays(empty.data(), empty.data(), 0, 8);
+    CHECK(cmp.matches == 0u);
+    CHECK(cmp.mismatches.empty());
+  }
+}
@@ -0,0 +1,59 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/background_writer.hpp"
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "tests/core/shared.hpp"
+#include "touca/core/filesystem.hpp"
+
+TEST_CASE("background writer") {
+  touca::detail::BackgroundWriter writer(16);
+
+  SECTION("order") {
+    std::vector<int> order;
+    for (auto i = 0; i < 100; ++i) {
+      writer.post([&order, i]() { order.push_back(i); }, 8);
+    }
+    writer.flush();
+    REQUIRE(order.size() == 100u);
+    for (auto i = 0; i < 100; ++i) {
+      CHECK(order[i] == i);
+    }
+  }
+
+  SECTION("write") {
+    TmpFile file;
+    writer.write(file.path.string(), {'f', 'o', 'o'});
+    writer.write(file.path.string(), {'b', 'a', 'r'});
+    writer.flush();
+    CHECK(touca::detail::load_text_file(file.path.string()) == "bar");
+  }
+
+  SECTION("sync policies") {
+    for (const auto policy :
+         {touca::detail::SyncPolicy::PerFile,
+          touca::detail::SyncPolicy::PerBatch,
+          touca::detail::SyncPolicy::EndOfRun}) {
+      TmpFile file;
+      touca::detail::BackgroundWriter durable(16, policy);
+      durable.write(file.path.string(), {'f', 'o', 'o'});
+      CHECK_NOTHROW(durable.flush());
+      CHECK(touca::detail::load_text_file(file.path.string()) == "foo");
+      durable.post([]() {}, 0, file.path.string() + ".missing");
+      CHECK_THROWS_AS(durable.flush(), touca::detail::runtime_error);
+    }
+  }
+
+  SECTION("errors") {
+    auto count = 0;
+    writer.post([]() { throw std::runtime_error("first"); });
+    writer.post([]() { throw std::runtime_error("second"); });
+    writer.post([&count]() { ++count; });
+    CHECK_THROWS_WITH(writer.flush(), "first");
+    CHECK(count == 1);
+    CHECK_NOTHROW(writer.flush());
+  }
+}
@@ -81,7 +81,7 @@ TEST_CASE("using a configured client") {
     CHECK_NOTHROW(client.add_array_element("some-array-value", v1));
     const auto& content = save_and_read_back(client);
     const auto& expected =
-        R"("results":[{"key":"some-array-value","value":"[true]"},{"key":"some-other-value","value":"1"},{"key":"some-value","value":"true"}])";
+        R"("results":[{"key":"some-array-value","value":[true]},{"key":"some-other-value","value":1},{"key":"some-value","value":true}])";
     CHECK_THAT(content, Catch::Contains(expected));
   }
 
@@ -110,7 +110,7 @@ TEST_CASE("using a configured client") {
     CHECK(tc->metrics().count("b"));
     const auto& content = save_and_read_back(client);
     const auto& expected =
-        R"("results":[],"assertion":[],"metrics":[{"key":"b","value":"0"}])";
+        R"("results":[],"assertion":[],"metrics":[{"key":"b","value":0}])";
     CHECK_THAT(content, Catch::Contains(expected));
   }
 
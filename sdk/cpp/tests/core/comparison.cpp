@@ -6,6 +6,9 @@
 #include "tests/core/shared.hpp"
 #include "touca/client/detail/client.hpp"
 #include "touca/core/deserialize.hpp"
+#include "touca/core/filesystem.hpp"
+#include "touca/core/result_file.hpp"
+#include "touca/impl/comparison_schema.hpp"
 
 using touca::data_point;
 using touca::detail::internal_type;
@@ -31,6 +34,87 @@ TEST_CASE("Testcase Serialization") {
     CHECK_THAT(output, Catch::Contains(check3));
   }
 
+  SECTION("compare: summary only") {
+    const auto& dst =
+        std::make_shared<touca::Testcase>("team", "suite", "version", "case");
+    testcase.check("gpa", data_point::number_double(3.5));
+    dst->check("gpa", data_point::number_double(3.0));
+    touca::ComparisonOptions options;
+    options.summary_only = true;
+    const touca::TestcaseComparison summary(testcase, *dst, options);
+    const touca::TestcaseComparison full(testcase, *dst);
+    CHECK(summary.overview().keysScore == full.overview().keysScore);
+    // values are described right away since the testcases may be discarded
+    const auto& summaryJson = make_json([&summary](touca::RJAllocator& x) {
+      return summary.json(x);
+    });
+    const auto& fullJson = make_json(
+        [&full](touca::RJAllocator& x) { return full.json(x); });
+    CHECK(summaryJson == fullJson);
+    CHECK_THAT(summaryJson, Catch::Contains("value is larger by"));
+  }
+
+  SECTION("compare: summary only with line limits") {
+    const auto& src =
+        std::make_shared<touca::Testcase>("team", "suite", "v1", "case");
+    const auto& dst =
+        std::make_shared<touca::Testcase>("team", "suite", "v2", "case");
+    src->check("text", data_point::string("a\nb\nc\nd\nf"));
+    dst->check("text", data_point::string("a\nx\ny\nc\nd\ne"));
+    touca::ComparisonOptions options;
+    options.summary_only = true;
+    options.max_hunks = 1;
+    const touca::TestcaseComparison cmp(src, dst, options);
+    const auto& output = make_json(
+        [&cmp](touca::RJAllocator& x) { return cmp.json(x); });
+    CHECK_THAT(output, Catch::Contains("1 more ranges of lines are different"));
+  }
+
+  SECTION("compare: discarded testcases") {
+    touca::ComparisonOptions options;
+    options.summary_only = true;
+    options.preview_size = 8;
+    const auto& cmp = [&options]() {
+      touca::Testcase src("team", "suite", "v1", "case");
+      touca::Testcase dst("team", "suite", "v2", "case");
+      src.check("name", data_point::string("some-long-name"));
+      dst.check("name", data_point::string("other-long-name"));
+      src.check("gpa", data_point::number_double(3.5));
+      dst.check("gpa", data_point::number_double(3.0));
+      src.check("fresh", data_point::boolean(true));
+      return touca::TestcaseComparison(src, dst, options);
+    }();
+    const auto& output = make_json(
+        [&cmp](touca::RJAllocator& x) { return cmp.json(x); });
+    CHECK_THAT(output, Catch::Contains(R"("srcValue":"some-lon...")"));
+    CHECK_THAT(output, Catch::Contains(R"("dstValue":"other-lo...")"));
+    CHECK_THAT(output, Catch::Contains("value is larger by"));
+    CHECK_THAT(output, Catch::Contains(R"("name":"fresh")"));
+  }
+
+  SECTION("compare: large testcase in parallel") {
+    const auto& dst =
+        std::make_shared<touca::Testcase>("team", "suite", "version", "case");
+    for (auto i = 0; i < 3000; ++i) {
+      const auto& key = "key-" + std::to_string(i);
+      testcase.check(key, data_point::number_signed(i));
+      dst->check(key, data_point::number_signed(i % 7 ? i : i + 1));
+    }
+    dst->check("other", data_point::boolean(true));
+    touca::ComparisonOptions options;
+    const touca::TestcaseComparison expected(testcase, *dst, options);
+    options.jobs = 4;
+    const touca::TestcaseComparison actual(testcase, *dst, options);
+    CHECK(actual.overview().keysCountCommon == 3000);
+    CHECK(actual.overview().keysCountMissing == 1);
+    CHECK(actual.overview().keysScore == expected.overview().keysScore);
+    const auto& actualJson = make_json(
+        [&actual](touca::RJAllocator& x) { return actual.json(x); });
+    const auto& expectedJson = make_json(
+        [&expected](touca::RJAllocator& x) { return expected.json(x); });
+    CHECK(actualJson == expectedJson);
+  }
+
   SECTION("compare: full") {
     auto dst =
         std::make_shared<touca::Testcase>("team", "suite", "version", "case");
@@ -164,4 +248,364 @@ TEST_CASE("Result File Operations") {
       CHECK_THAT(output, Catch::Contains(check3));
     }
   }
+
+  /**
+   * Compare two result files without deserializing them.
+   */
+  SECTION("compare_files") {
+    touca::ClientImpl other;
+    REQUIRE_NOTHROW(other.configure([](touca::ClientOptions& x) {
+      x.team = "acme";
+      x.suite = "students";
+      x.version = "1.1";
+      x.offline = true;
+    }));
+    other.declare_testcase("aanderson");
+    other.check("firstname", touca::data_point::string("alice"));
+    other.check("lastname", touca::data_point::string("andersen"));
+    other.check("courses", touca::array().add(1).add(2));
+    other.add_metric("duration", 10);
+    other.declare_testcase("cchen");
+    other.check("firstname", touca::data_point::string("charlie"));
+
+    TmpFile tmpFileA;
+    TmpFile tmpFileB;
+    client.save(tmpFileA.path, {}, touca::DataFormat::FBS, true);
+    other.save(tmpFileB.path, {}, touca::DataFormat::FBS, true);
+
+    const auto& contentA = touca::deserialize_file(tmpFileA.path);
+    const auto& contentB = touca::deserialize_file(tmpFileB.path);
+    const auto& expected = compare(contentA, contentB);
+    const auto& actual = touca::compare_files(tmpFileA.path, tmpFileB.path);
+
+    CHECK(actual.fresh.size() == 1u);
+    CHECK(actual.fresh.count("bbrown") == 1u);
+    CHECK(actual.missing.size() == 1u);
+    CHECK(actual.missing.count("cchen") == 1u);
+    REQUIRE(actual.common.count("aanderson") == 1u);
+
+    const auto& overview = actual.common.at("aanderson").overview();
+    CHECK(overview.keysCountCommon == 2);
+    CHECK(overview.keysCountMissing == 1);
+    CHECK(overview.metricsCountMissing == 1);
+    CHECK(overview.keysScore == Approx(1.0 / 3));
+    CHECK(actual.json() == expected.json());
+
+    TmpFile output;
+    touca::detail::save_file(
+        output.path.string(), [&tmpFileA, &tmpFileB](std::FILE* out) {
+          touca::write_comparison(out, tmpFileA.path, tmpFileB.path);
+        });
+    CHECK(touca::detail::load_text_file(output.path.string()) ==
+          actual.json());
+
+    // files without a footer index are loaded in their entirety instead
+    TmpFile legacy;
+    std::vector<touca::Testcase> testcases;
+    for (const auto& kvp : contentB) {
+      testcases.push_back(*kvp.second);
+    }
+    touca::detail::save_binary_file(legacy.path.string(),
+                                    touca::Testcase::serialize(testcases));
+    REQUIRE(touca::read_index(legacy.path).empty());
+    TmpFile legacyOutput;
+    touca::detail::save_file(
+        legacyOutput.path.string(), [&tmpFileA, &legacy](std::FILE* out) {
+          touca::write_comparison(out, tmpFileA.path, legacy.path);
+        });
+    CHECK(touca::detail::load_text_file(legacyOutput.path.string()) ==
+          actual.json());
+
+    touca::ComparisonOptions options;
+    options.summary_only = true;
+    const auto& summary =
+        touca::compare_files(tmpFileA.path, tmpFileB.path, options);
+    REQUIRE(summary.common.count("aanderson") == 1u);
+    CHECK(summary.common.at("aanderson").overview().keysScore ==
+          Approx(1.0 / 3));
+    CHECK_THAT(
+        summary.json(),
+        Catch::Contains(
+            R"("commonCases":[{"name":"aanderson","overview":{"keysCountCommon":2,)"));
+
+    const auto& binary = actual.binary();
+    REQUIRE(flatbuffers::Verifier(binary.data(), binary.size())
+                .VerifyBuffer<touca::fbs::FileComparison>());
+    const auto& root =
+        flatbuffers::GetRoot<touca::fbs::FileComparison>(binary.data());
+    REQUIRE(root->fresh()->size() == 1u);
+    CHECK(root->fresh()->Get(0)->testcase()->str() == "bbrown");
+    REQUIRE(root->missing()->size() == 1u);
+    CHECK(root->missing()->Get(0)->testcase()->str() == "cchen");
+    const auto& common = root->common()->LookupByKey("aanderson");
+    REQUIRE(common);
+    CHECK(common->overview()->keys_score() == Approx(1.0 / 3));
+    CHECK(common->overview()->keys_count_missing() == 1);
+    CHECK(common->dst()->version()->str() == "1.1");
+    const auto& lastname = common->results()->common()->LookupByKey("lastname");
+    REQUIRE(lastname);
+    CHECK_FALSE(lastname->match());
+    CHECK(lastname->score() == 0.0);
+    CHECK(lastname->src_value()->str() == "anderson");
+    CHECK(lastname->dst_value()->str() == "andersen");
+    const auto& firstname =
+        common->results()->common()->LookupByKey("firstname");
+    REQUIRE(firstname);
+    CHECK(firstname->match());
+    CHECK(firstname->src_type() == touca::fbs::ValueType::String);
+    CHECK_FALSE(firstname->dst_value());
+    const auto& courses = common->results()->missing()->LookupByKey("courses");
+    REQUIRE(courses);
+    CHECK(courses->dst_type() == touca::fbs::ValueType::Array);
+    CHECK(common->metrics()->missing()->size() == 1u);
+
+    // comparison results of testcases in summary mode have no details
+    options.format = touca::ComparisonFormat::Binary;
+    TmpFile binaryOutput;
+    touca::detail::save_file(
+        binaryOutput.path.string(),
+        [&tmpFileA, &tmpFileB, &options](std::FILE* out) {
+          touca::write_comparison(out, tmpFileA.path, tmpFileB.path, options);
+        },
+        true);
+    const auto& streamed = touca::detail::load_text_file(
+        binaryOutput.path.string(), std::ios::in | std::ios::binary);
+    CHECK(std::vector<std::uint8_t>(streamed.begin(), streamed.end()) ==
+          summary.binary());
+    const auto& brief =
+        flatbuffers::GetRoot<touca::fbs::FileComparison>(streamed.data())
+            ->common()
+            ->LookupByKey("aanderson");
+    REQUIRE(brief);
+    CHECK(brief->overview()->keys_count_common() == 2);
+    CHECK_FALSE(brief->results());
+  }
+
+  /**
+   * Compare result files that use different encodings for the same arrays
+   * and keys.
+   */
+  SECTION("compare_files_with_compact_encoding") {
+    touca::ClientImpl other;
+    REQUIRE_NOTHROW(other.configure([](touca::ClientOptions& x) {
+      x.team = "acme";
+      x.suite = "students";
+      x.version = "1.1";
+      x.offline = true;
+      x.compact_binary = true;
+    }));
+    other.declare_testcase("aanderson");
+    other.check("firstname", touca::data_point::string("alice"));
+    other.check("lastname", touca::data_point::string("anderson"));
+    other.check("scores", touca::array().add(2.5).add(3.5));
+    other.check("address", touca::object("address").add("city", "paris"));
+    client.declare_testcase("aanderson");
+    client.check("scores", touca::array().add(2.5).add(3.5));
+    client.check("address", touca::object("address").add("city", "paris"));
+
+    TmpFile tmpFileA;
+    TmpFile tmpFileB;
+    client.save(tmpFileA.path, {"aanderson"}, touca::DataFormat::FBS, true);
+    other.save(tmpFileB.path, {}, touca::DataFormat::FBS, true);
+
+    const auto& cmp = touca::compare_files(tmpFileA.path, tmpFileB.path);
+    REQUIRE(cmp.common.count("aanderson") == 1u);
+    const auto& overview = cmp.common.at("aanderson").overview();
+    CHECK(overview.keysCountCommon == 4);
+    CHECK(overview.keysScore == 1.0);
+    CHECK(cmp.json() ==
+          compare(touca::deserialize_file(tmpFileA.path),
+                  touca::deserialize_file(tmpFileB.path))
+              .json());
+  }
+
+  /**
+   * Compare result files while keeping no more than the start of each value.
+   */
+  SECTION("compare_files_with_preview_size") {
+    client.declare_testcase("aanderson");
+    client.check("biography", data_point::string(std::string(64, 'a')));
+
+    TmpFile tmpFileA;
+    TmpFile tmpFileB;
+    client.save(tmpFileA.path, {"aanderson"}, touca::DataFormat::FBS, true);
+    client.save(tmpFileB.path, {"aanderson"}, touca::DataFormat::FBS, true);
+
+    touca::ComparisonOptions options;
+    options.preview_size = 8;
+    const auto& cmp =
+        touca::compare_files(tmpFileA.path, tmpFileB.path, options);
+    const auto& output = cmp.json();
+    CHECK_THAT(output, Catch::Contains(R"("srcValue":"aaaaaaaa...")"));
+    CHECK_THAT(output, !Catch::Contains(std::string(9, 'a')));
+  }
+
+  /**
+   * Compare result files of different versions whose testcases have the
+   * same results, while keeping comparison results in a cache.
+   */
+  SECTION("compare_files_with_cache") {
+    const auto& save_version = [](const std::string& version,
+                                  const unsigned duration,
+                                  const touca::filesystem::path& path) {
+      touca::ClientImpl other;
+      REQUIRE_NOTHROW(other.configure([&version](touca::ClientOptions& x) {
+        x.team = "acme";
+        x.suite = "students";
+        x.version = version;
+        x.offline = true;
+      }));
+      other.declare_testcase("aanderson");
+      other.check("firstname", touca::data_point::string("alice"));
+      other.check("lastname", touca::data_point::string("andersen"));
+      other.add_metric("duration", duration);
+      other.save(path, {}, touca::DataFormat::FBS, true);
+    };
+    const auto& count_entries = [](const touca::filesystem::path& path) {
+      std::size_t count = 0u;
+      for (const auto& entry : touca::filesystem::directory_iterator(path)) {
+        count += entry.path().extension() == ".cmp" ? 1u : 0u;
+      }
+      return count;
+    };
+    TmpFile tmpFileA;
+    TmpFile tmpFileB;
+    TmpFile tmpFileC;
+    TmpFile cacheDir;
+    client.save(tmpFileA.path, {}, touca::DataFormat::FBS, true);
+    save_version("1.1", 10u, tmpFileB.path);
+    save_version("1.2", 20u, tmpFileC.path);
+
+    touca::ComparisonOptions options;
+    options.cache_directory = cacheDir.path.string();
+    for (const auto& path : {tmpFileB.path, tmpFileC.path, tmpFileB.path}) {
+      const auto& expected = touca::compare_files(tmpFileA.path, path);
+      const auto& actual = touca::compare_files(tmpFileA.path, path, options);
+      REQUIRE(actual.common.count("aanderson") == 1u);
+      CHECK(actual.common.at("aanderson").overview().keysScore ==
+            Approx(0.5));
+      CHECK(actual.json() == expected.json());
+      CHECK(count_entries(cacheDir.path) == 1u);
+    }
+
+    options.summary_only = true;
+    const auto& summary =
+        touca::compare_files(tmpFileA.path, tmpFileB.path, options);
+    CHECK(summary.common.at("aanderson").overview().keysScore ==
+          Approx(0.5));
+    CHECK(count_entries(cacheDir.path) == 2u);
+  }
+
+  /**
+   * Compare result files while the comparison cache holds results of the
+   * same testcases that were kept by an earlier version of the cache.
+   */
+  SECTION("compare_files_with_stale_cache") {
+    touca::ClientImpl other;
+    REQUIRE_NOTHROW(other.configure([](touca::ClientOptions& x) {
+      x.team = "acme";
+      x.suite = "students";
+      x.version = "1.1";
+      x.offline = true;
+    }));
+    other.declare_testcase("aanderson");
+    other.check("firstname", touca::data_point::string("alice"));
+    other.check("lastname", touca::data_point::string("andersen"));
+    const auto& find_entry =
+        [](const touca::filesystem::path& path) -> touca::filesystem::path {
+      for (const auto& entry : touca::filesystem::directory_iterator(path)) {
+        if (entry.path().extension() == ".cmp") {
+          return entry.path();
+        }
+      }
+      return {};
+    };
+    TmpFile tmpFileA;
+    TmpFile tmpFileB;
+    TmpFile cacheDir;
+    TmpFile otherDir;
+    client.save(tmpFileA.path, {"aanderson"}, touca::DataFormat::FBS, true);
+    other.save(tmpFileB.path, {}, touca::DataFormat::FBS, true);
+
+    // results of a perfect match, to be planted in place of other results
+    touca::ComparisonOptions options;
+    options.cache_directory = otherDir.path.string();
+    touca::compare_files(tmpFileA.path, tmpFileA.path, options);
+    const auto& planted = touca::detail::load_text_file(
+        find_entry(otherDir.path).string(), std::ios::in | std::ios::binary);
+
+    options.cache_directory = cacheDir.path.string();
+    const auto& score = [&tmpFileA, &tmpFileB, &options]() {
+      return touca::compare_files(tmpFileA.path, tmpFileB.path, options)
+          .common.at("aanderson")
+          .overview()
+          .keysScore;
+    };
+    CHECK(score() == Approx(0.5));
+    const auto& path = find_entry(cacheDir.path);
+    const auto& name = path.stem().string();
+    const auto srcDigest = std::stoull(name.substr(0, 16), nullptr, 16);
+    const auto dstDigest = std::stoull(name.substr(16, 16), nullptr, 16);
+    REQUIRE(name ==
+            touca::detail::comparison_cache_key(srcDigest, dstDigest, options));
+
+    // the planted results are used when kept by the current version
+    touca::detail::save_text_file(path.string(), planted);
+    CHECK(score() == Approx(1.0));
+
+    touca::filesystem::remove(path);
+    const auto& stale = touca::detail::comparison_cache_key(
+        srcDigest, dstDigest, options,
+        touca::detail::comparison_cache_version - 1);
+    touca::detail::save_text_file((cacheDir.path / stale).string() + ".cmp",
+                                  planted);
+    CHECK(score() == Approx(0.5));
+  }
+
+  SECTION("compare_files_in_parallel") {
+    touca::ClientImpl other;
+    REQUIRE_NOTHROW(other.configure([](touca::ClientOptions& x) {
+      x.team = "acme";
+      x.suite = "students";
+      x.version = "1.1";
+      x.offline = true;
+    }));
+    for (auto i = 0; i < 50; ++i) {
+      const auto& name = "case-" + std::to_string(i);
+      client.declare_testcase(name);
+      client.check("value", data_point::number_signed(i));
+      other.declare_testcase(name);
+      other.check("value", data_point::number_signed(i % 3 ? i : -i));
+    }
+
+    TmpFile tmpFileA;
+    TmpFile tmpFileB;
+    client.save(tmpFileA.path, {}, touca::DataFormat::FBS, true);
+    other.save(tmpFileB.path, {}, touca::DataFormat::FBS, true);
+
+    touca::ComparisonOptions options;
+    const auto& expected =
+        touca::compare_files(tmpFileA.path, tmpFileB.path, options);
+    options.jobs = 4;
+    const auto& actual =
+        touca::compare_files(tmpFileA.path, tmpFileB.path, options);
+    REQUIRE(actual.common.size() == 50u);
+    CHECK(actual.json() == expected.json());
+
+    // fresh testcases are listed in a different order
+    TmpFile output;
+    touca::detail::save_file(
+        output.path.string(),
+        [&tmpFileA, &tmpFileB, &options](std::FILE* out) {
+          touca::write_comparison(out, tmpFileA.path, tmpFileB.path, options);
+        });
+    const auto& streamed = touca::detail::load_text_file(output.path.string());
+    const auto& json = expected.json();
+    CHECK(streamed.substr(streamed.find("\"commonCases\"")) ==
+          json.substr(json.find("\"commonCases\"")));
+
+    const auto& contentA = touca::deserialize_file(tmpFileA.path);
+    const auto& contentB = touca::deserialize_file(tmpFileB.path);
+    CHECK(compare(contentA, contentB, options).json() == expected.json());
+  }
 }
@@ -0,0 +1,63 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/comparison_cache.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "tests/core/shared.hpp"
+
+using touca::detail::ComparisonCache;
+
+TEST_CASE("comparison cache") {
+  TmpFile directory;
+  const std::vector<std::uint8_t> content(150, 7);
+  std::vector<std::uint8_t> loaded;
+
+  SECTION("load and store") {
+    ComparisonCache cache(directory.path, 0u);
+    CHECK_FALSE(cache.load("first", loaded));
+    cache.store("first", content);
+    REQUIRE(cache.load("first", loaded));
+    CHECK(loaded == content);
+    CHECK(cache.hits() == 1u);
+    CHECK(cache.misses() == 1u);
+    CHECK(cache.size() > content.size());
+
+    // entries outlive the object that stored them
+    ComparisonCache other(directory.path, 0u);
+    CHECK(other.size() == cache.size());
+    CHECK(other.load("first", loaded));
+    CHECK(loaded == content);
+  }
+
+  SECTION("damaged entries") {
+    ComparisonCache cache(directory.path, 0u);
+    cache.store("first", content);
+    const auto& path = directory.path / "first.cmp";
+    auto entry = touca::detail::load_text_file(path.string(),
+                                               std::ios::in | std::ios::binary);
+    entry[20] = 8;
+    touca::detail::save_text_file(path.string(), entry);
+    CHECK_FALSE(cache.load("first", loaded));
+    touca::detail::save_text_file(path.string(), entry.substr(0, 10));
+    CHECK_FALSE(cache.load("first", loaded));
+  }
+
+  SECTION("eviction") {
+    ComparisonCache cache(directory.path, 500u);
+    // entries stored at the same time are removed in the order of their keys
+    for (const auto& key : {"a", "b", "c", "d"}) {
+      cache.store(key, content);
+    }
+    CHECK(cache.size() <= 375u);
+    CHECK_FALSE(cache.load("a", loaded));
+    CHECK(cache.load("d", loaded));
+
+    ComparisonCache smaller(directory.path, 100u);
+    CHECK(smaller.size() == 0u);
+    CHECK_FALSE(smaller.load("d", loaded));
+  }
+}
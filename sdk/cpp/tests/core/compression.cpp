@@ -0,0 +1,53 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/compression.hpp"
+
+#include <string>
+
+#include "catch2/catch.hpp"
+#include "touca/core/filesystem.hpp"
+
+TEST_CASE("compression") {
+  SECTION("parse") {
+    CHECK(touca::parse_compression("") == touca::Compression::None);
+    CHECK(touca::parse_compression("none") == touca::Compression::None);
+    CHECK(touca::parse_compression("zstd") == touca::Compression::Zstd);
+    CHECK(touca::parse_compression("lz4") == touca::Compression::Lz4);
+    CHECK_THROWS_AS(touca::parse_compression("gzip"),
+                    touca::detail::runtime_error);
+    CHECK(touca::is_supported(touca::Compression::None));
+  }
+
+  SECTION("round trip") {
+    std::string input;
+    for (auto i = 0; i < 1000; ++i) {
+      input += "some repetitive content " + std::to_string(i % 10);
+    }
+    const auto data = reinterpret_cast<const std::uint8_t*>(input.data());
+    for (const auto codec : {touca::Compression::None, touca::Compression::Zstd,
+                             touca::Compression::Lz4}) {
+      if (!touca::is_supported(codec)) {
+        CHECK_THROWS_AS(touca::detail::compress(codec, 0, data, input.size()),
+                        touca::detail::runtime_error);
+        continue;
+      }
+      const auto& frame = touca::detail::compress(codec, 0, data, input.size());
+      if (codec != touca::Compression::None) {
+        CHECK(frame.size() < input.size());
+      }
+      const auto& output = touca::detail::decompress(
+          codec, frame.data(), frame.size(), input.size());
+      CHECK(std::string(output.begin(), output.end()) == input);
+      if (codec != touca::Compression::None) {
+        CHECK_THROWS_AS(touca::detail::decompress(codec, frame.data(),
+                                                  frame.size() / 2,
+                                                  input.size()),
+                        touca::detail::runtime_error);
+        CHECK_THROWS_AS(
+            touca::detail::decompress(codec, frame.data(), frame.size(),
+                                      std::size_t(1) << 30),
+            touca::detail::runtime_error);
+      }
+    }
+  }
+}
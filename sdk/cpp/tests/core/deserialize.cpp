@@ -2,6 +2,9 @@
 
 #include "touca/core/deserialize.hpp"
 
+#include <cmath>
+#include <limits>
+
 #include "catch2/catch.hpp"
 #include "tests/core/shared.hpp"
 #include "touca/client/detail/client.hpp"
@@ -12,9 +15,13 @@
 
 using touca::detail::internal_type;
 
-std::string serialize(const touca::data_point& value) {
+std::string serialize(
+    const touca::data_point& value,
+    const touca::SerializationOptions& options = {}) {
   flatbuffers::FlatBufferBuilder builder;
-  const auto& wrapper = value.serialize(builder);
+  touca::detail::subtree_cache cache;
+  const auto& wrapper = value.serialize(
+      builder, options, nullptr, options.deduplicate ? &cache : nullptr);
   builder.Finish(wrapper);
   const auto& ptr = builder.GetBufferPointer();
   return {ptr, ptr + builder.GetSize()};
@@ -211,6 +218,45 @@ TEST_CASE("Serialize and Deserialize Data Types") {
     }
   }
 
+  SECTION("type: packed array") {
+    touca::SerializationOptions options;
+    options.packed_arrays = true;
+
+    SECTION("serialize: homogeneous") {
+      const auto& value = touca::array().add(41).add(42).add(43);
+      const auto& buffer = serialize(value, options);
+      const auto& wrapper =
+          flatbuffers::GetRoot<touca::fbs::TypeWrapper>(buffer.data());
+      CHECK(touca::fbs::Type::IntVector == wrapper->value_type());
+      CHECK(buffer.size() < serialize(value).size());
+
+      const auto& itype = deserialize(buffer);
+      const auto& cmp = compare(value, itype);
+      CHECK(internal_type::array == itype.type());
+      CHECK(itype.to_string() == R"([41,42,43])");
+      CHECK(MatchType::Perfect == cmp.match);
+    }
+
+    SECTION("serialize: heterogeneous") {
+      const auto& value = touca::array().add(true).add(42);
+      const auto& buffer = serialize(value, options);
+      const auto& wrapper =
+          flatbuffers::GetRoot<touca::fbs::TypeWrapper>(buffer.data());
+      CHECK(touca::fbs::Type::Array == wrapper->value_type());
+      CHECK(deserialize(buffer).to_string() == R"([true,42])");
+    }
+
+    SECTION("serialize: nested") {
+      touca::object value("creature");
+      value.add("eyes", touca::array().add(1.5).add(2.5));
+      value.add("legs", touca::array().add(false).add(true));
+      const auto& itype = deserialize(serialize(value, options));
+      CHECK(itype.to_string() ==
+            R"({"creature":{"eyes":[1.5,2.5],"legs":[false,true]}})");
+      CHECK(MatchType::Perfect == compare(value, itype).match);
+    }
+  }
+
   SECTION("type: object") {
     SECTION("initialize: add number to object") {
       touca::object value("creature");
@@ -292,6 +338,25 @@ TEST_CASE("Serialize and Deserialize Data Types") {
       CHECK(cmp.score == 1.0);
       CHECK(cmp.desc.empty());
     }
+
+    SECTION("serialize: deduplicate") {
+      touca::SerializationOptions options;
+      options.deduplicate = true;
+      touca::object value("creature");
+      value.add("first_head", Head(2));
+      value.add("second_head", Head(2));
+      value.add("third_head", Head(3));
+      value.add("weights", touca::array()
+                               .add(touca::array().add(0.0))
+                               .add(touca::array().add(-0.0)));
+      const auto& buffer = serialize(value, options);
+      const auto& itype = deserialize(buffer);
+
+      CHECK(buffer.size() < serialize(value).size());
+      CHECK(itype.to_string() == data_point(value).to_string());
+      CHECK_THAT(itype.to_string(),
+                 Catch::Contains(R"("third_head":{"head":{"eyes":3}})"));
+    }
   }
 }
 
@@ -324,4 +389,230 @@ TEST_CASE("Deserialize file") {
     CHECK(content.at("some-case")->overview().keysCount == 2);
     CHECK(content.at("some-other-case")->overview().keysCount == 1);
   }
+
+  SECTION("string table") {
+    const auto& testcase = *client.declare_testcase("some-case");
+    client.check("some-key",
+                 touca::object("some-object").add("some-member", 1));
+    client.add_metric("some-metric", 10);
+
+    touca::SerializationOptions options;
+    options.string_table = true;
+    TmpFile file;
+    touca::detail::save_binary_file(
+        file.path.string(), touca::Testcase::serialize({testcase}, options));
+    const auto& content = touca::deserialize_file(file.path);
+
+    REQUIRE(content.count("some-case"));
+    const auto& actual = *content.at("some-case");
+    CHECK(actual.metadata().teamslug == "myteam");
+    CHECK(actual.metadata().testsuite == "mysuite");
+    CHECK(actual.metadata().version == "myversion");
+    CHECK(touca::compare(testcase, actual).overview().keysScore == 1.0);
+    CHECK(actual.metrics().count("some-metric"));
+  }
+
+  SECTION("verify modes") {
+    client.declare_testcase("some-case");
+    client.add_hit_count("some-key");
+    TmpFile file;
+    client.save(file.path, {}, touca::DataFormat::FBS, true);
+    for (const auto mode :
+         {touca::VerifyMode::Full, touca::VerifyMode::Checksum,
+          touca::VerifyMode::Lazy}) {
+      const auto& content = touca::deserialize_file(file.path, mode);
+      REQUIRE(content.count("some-case"));
+      CHECK(content.at("some-case")->overview().keysCount == 1);
+    }
+    // testcases of files that match their checksum need no verification
+    auto verify_testcases = false;
+    touca::load_result_file(file.path, touca::VerifyMode::Full,
+                            verify_testcases);
+    CHECK(verify_testcases);
+    touca::load_result_file(file.path, touca::VerifyMode::Checksum,
+                            verify_testcases);
+    CHECK_FALSE(verify_testcases);
+    CHECK(touca::parse_verify_mode("lazy") == touca::VerifyMode::Lazy);
+    CHECK_THROWS_AS(touca::parse_verify_mode("some-mode"),
+                    touca::detail::runtime_error);
+  }
+
+  SECTION("verify modes: corrupted testcase") {
+    flatbuffers::FlatBufferBuilder builder;
+    const std::vector<uint8_t> garbage{1, 2, 3, 4, 5, 6, 7, 8};
+    const std::vector<flatbuffers::Offset<touca::fbs::MessageBuffer>>
+        messages{touca::fbs::CreateMessageBufferDirect(builder, &garbage)};
+    builder.Finish(touca::fbs::CreateMessagesDirect(builder, &messages));
+    TmpFile file;
+    touca::detail::save_binary_file(
+        file.path.string(),
+        {builder.GetBufferPointer(),
+         builder.GetBufferPointer() + builder.GetSize()});
+
+    CHECK_THROWS_AS(touca::load_result_file(file.path),
+                    touca::detail::runtime_error);
+    CHECK_THROWS_AS(
+        touca::load_result_file(file.path, touca::VerifyMode::Checksum),
+        touca::detail::runtime_error);
+    CHECK_NOTHROW(touca::load_result_file(file.path, touca::VerifyMode::Lazy));
+    CHECK_THROWS_AS(touca::deserialize_file(file.path, touca::VerifyMode::Lazy),
+                    touca::detail::runtime_error);
+
+    // testcases are verified as they are read, rather than up front
+    auto verify_testcases = false;
+    CHECK_NOTHROW(touca::load_result_file(file.path, touca::VerifyMode::Full,
+                                          verify_testcases));
+    CHECK(verify_testcases);
+    CHECK_THROWS_AS(touca::deserialize_file(file.path),
+                    touca::detail::runtime_error);
+  }
+}
+
+TEST_CASE("Deserialize json file") {
+  touca::ClientImpl client;
+  REQUIRE_NOTHROW(client.configure([](touca::ClientOptions& x) {
+    x.team = "myteam";
+    x.suite = "mysuite";
+    x.version = "myversion";
+    x.offline = true;
+  }));
+  client.declare_testcase("some-case");
+  client.check("some-int", touca::data_point::number_signed(-3));
+  client.check("some-uint", touca::data_point::number_unsigned(42));
+  client.check("some-float", touca::data_point::number_float(1.5f));
+  client.check("some-string", touca::data_point::string("foo"));
+  client.check("some-array",
+               touca::array().add(true).add(2.25).add(nullptr).add("bar"));
+  client.check("some-object", touca::object("some-name")
+                                  .add("some-member", 1u)
+                                  .add("some-other-member", touca::object()));
+  client.assume("some-assertion", touca::data_point::boolean(true));
+  client.add_metric("some-metric", 10);
+  client.declare_testcase("some-other-case");
+  client.add_hit_count("some-key");
+
+  TmpFile json;
+  TmpFile binary;
+  client.save(json.path, {}, touca::DataFormat::JSON, true);
+  client.save(binary.path, {}, touca::DataFormat::FBS, true);
+
+  SECTION("roundtrip") {
+    const auto& content = touca::deserialize_file(json.path);
+    REQUIRE(content.size() == 2u);
+    REQUIRE(content.count("some-case"));
+    const auto& testcase = content.at("some-case");
+    CHECK(testcase->metadata().teamslug == "myteam");
+    CHECK(testcase->metadata().version == "myversion");
+    CHECK(testcase->overview().keysCount == 7);
+    CHECK(testcase->metrics().at("some-metric").value.as_metric() == 10);
+
+    const auto& expected =
+        client.serialize({"some-case"}, touca::DataFormat::JSON);
+    CHECK(touca::testcases_to_json({testcase.get()}) ==
+          std::string(expected.begin(), expected.end()));
+  }
+
+  SECTION("compare with binary") {
+    for (const auto& paths :
+         {std::make_pair(json.path, binary.path),
+          std::make_pair(binary.path, json.path),
+          std::make_pair(json.path, json.path)}) {
+      const auto& cmp = touca::compare_files(paths.first, paths.second);
+      REQUIRE(cmp.common.size() == 2u);
+      CHECK(cmp.fresh.empty());
+      CHECK(cmp.missing.empty());
+      for (const auto& kvp : cmp.common) {
+        CHECK(kvp.second.overview().keysScore == 1.0);
+      }
+    }
+  }
+
+  SECTION("legacy string values") {
+    TmpFile legacy;
+    legacy.write(
+        R"([{"metadata":{"teamslug":"myteam","testsuite":"mysuite","version":"myversion","testcase":"some-case","builtAt":""},)"
+        R"("results":[{"key":"some-int","value":"-3"},{"key":"some-string","value":"foo"},)"
+        R"({"key":"some-array","value":"[true,2.25,null,\"bar\"]"}],)"
+        R"("assertion":[{"key":"some-assertion","value":"true"}],)"
+        R"("metrics":[{"key":"some-metric","value":"10"}]}])");
+    const auto& content = touca::deserialize_file(legacy.path);
+    REQUIRE(content.count("some-case"));
+    const auto& testcase = content.at("some-case");
+    CHECK(testcase->overview().keysCount == 4);
+    CHECK(testcase->metrics().at("some-metric").value.as_metric() == 10);
+    const auto& cmp = touca::compare_files(legacy.path, binary.path);
+    REQUIRE(cmp.common.count("some-case"));
+    const auto& overview = cmp.common.at("some-case").overview();
+    CHECK(overview.keysCountCommon == 3);
+    CHECK(overview.keysCountMissing == 3);
+    CHECK(overview.keysScore == 0.5);
+
+    // strings that look like json stay strings in files with a version
+    TmpFile native;
+    native.write(
+        R"([{"formatVersion":2,"metadata":{"testcase":"some-case"},)"
+        R"("results":[{"key":"some-int","value":"-3"}]}])");
+    const auto& strings = touca::deserialize_file(native.path);
+    REQUIRE(strings.count("some-case"));
+    CHECK_THAT(touca::testcases_to_json({strings.at("some-case").get()}),
+               Catch::Contains(R"({"key":"some-int","value":"-3"})"));
+  }
+
+  SECTION("precision") {
+    touca::Testcase testcase("myteam", "mysuite", "myversion", "some-case");
+    testcase.check("some-float", touca::data_point::number_float(0.12345f));
+    testcase.check("some-double", touca::data_point::number_double(0.12345));
+    testcase.check("some-array", touca::array().add(1.0f / 3).add(1.0 / 3));
+    const auto& content = touca::testcases_to_json({&testcase});
+    CHECK_THAT(content, Catch::Contains(R"("value":0.12345})"));
+
+    TmpFile exported;
+    TmpFile original;
+    exported.write(content);
+    touca::detail::save_binary_file(original.path.string(),
+                                    touca::Testcase::serialize({testcase}));
+    for (const auto& paths : {std::make_pair(exported.path, original.path),
+                              std::make_pair(original.path, exported.path)}) {
+      const auto& cmp = touca::compare_files(paths.first, paths.second);
+      REQUIRE(cmp.common.count("some-case"));
+      const auto& overview = cmp.common.at("some-case").overview();
+      CHECK(overview.keysCountCommon == 3);
+      CHECK(overview.keysScore == 1.0);
+    }
+  }
+
+  SECTION("non-finite numbers") {
+    const auto inf = std::numeric_limits<double>::infinity();
+    touca::Testcase testcase("myteam", "mysuite", "myversion", "some-case");
+    testcase.check("some-nan", touca::data_point::number_double(std::nan("")));
+    testcase.check("some-inf", touca::data_point::number_float(
+                                   std::numeric_limits<float>::infinity()));
+    testcase.check("some-array", touca::array().add(-inf).add(1.5));
+    const auto& expected = touca::testcases_to_json({&testcase});
+    CHECK_THAT(expected, Catch::Contains(R"("value":NaN)"));
+    CHECK_THAT(expected, Catch::Contains(R"("value":Infinity)"));
+    CHECK_THAT(expected, Catch::Contains(R"("value":[-Infinity,1.5])"));
+    CHECK(touca::data_point::number_double(-inf).to_string() == "-Infinity");
+
+    TmpFile file;
+    file.write(expected);
+    const auto& content = touca::deserialize_file(file.path);
+    REQUIRE(content.count("some-case"));
+    CHECK(content.at("some-case")->overview().keysCount == 3);
+    CHECK(touca::testcases_to_json({content.at("some-case").get()}) ==
+          expected);
+  }
+
+  SECTION("invalid content") {
+    TmpFile invalid;
+    invalid.write(R"([{"metadata":{"testcase":"some-case"},"results":[)");
+    CHECK_THROWS_AS(touca::deserialize_file(invalid.path),
+                    touca::detail::runtime_error);
+    invalid.write(R"([{"results":[{"key":"some-key"}]}])");
+    CHECK_THROWS_AS(touca::deserialize_file(invalid.path),
+                    touca::detail::runtime_error);
+    invalid.write(R"([{"results":[{"key":"a","value":{"b":1}}]}])");
+    CHECK_THROWS_AS(touca::deserialize_file(invalid.path),
+                    touca::detail::runtime_error);
+  }
 }
@@ -0,0 +1,26 @@
+// Copyright 2022 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/digest.hpp"
+
+#include <string>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("digest") {
+  SECTION("known values") {
+    const std::string input = "The quick brown fox jumps over the lazy dog";
+    CHECK(touca::detail::digest("", 0) == 0xef46db3751d8e999ULL);
+    CHECK(touca::detail::digest("hello world", 11) == 0x45ab6734b21e6968ULL);
+    CHECK(touca::detail::digest(input.data(), input.size()) ==
+          0x0b242d361fda71bcULL);
+  }
+
+  SECTION("incremental") {
+    const std::string input(1000, 'x');
+    touca::detail::xxh64 state;
+    for (std::size_t i = 0; i < input.size(); i += 7) {
+      state.update(input.data() + i, std::min<std::size_t>(7, 1000 - i));
+    }
+    CHECK(state.digest() == touca::detail::digest(input.data(), input.size()));
+  }
+}
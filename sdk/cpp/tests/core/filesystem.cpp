@@ -3,6 +3,7 @@
 #include "touca/core/filesystem.hpp"
 
 #include "catch2/catch.hpp"
+#include "tests/core/shared.hpp"
 
 TEST_CASE("string formatting") {
   SECTION("format") {
@@ -16,3 +17,51 @@ TEST_CASE("string formatting") {
                       "failed to read file");
   }
 }
+
+TEST_CASE("saving files") {
+  TmpFile file;
+  const auto& path = file.path.string();
+
+  SECTION("replace") {
+    touca::detail::save_text_file(path, "first");
+    touca::detail::save_binary_file(path, {'s', 'e', 'c', 'o', 'n', 'd'});
+    CHECK(touca::detail::load_text_file(path) == "second");
+    CHECK_FALSE(touca::filesystem::exists(path + ".tmp"));
+  }
+
+  SECTION("temporary files") {
+    const auto& count_files = [&file]() {
+      return std::distance(touca::filesystem::directory_iterator(file.path),
+                           touca::filesystem::directory_iterator());
+    };
+    const auto& target = (file.path / "result.json").string();
+    touca::detail::save_file(target, "content", 7, false, false);
+    CHECK(touca::detail::load_text_file(target) == "content");
+    CHECK(count_files() == 1);
+
+    const auto& fail = [](std::FILE*) {
+      throw touca::detail::runtime_error("interrupted");
+    };
+    CHECK_THROWS_AS(touca::detail::save_file(target, fail),
+                    touca::detail::runtime_error);
+    CHECK(touca::detail::load_text_file(target) == "content");
+    CHECK(count_files() == 1);
+  }
+
+  SECTION("sync") {
+    touca::detail::save_text_file(path, "content", true);
+    CHECK(touca::detail::load_text_file(path) == "content");
+    CHECK_NOTHROW(touca::detail::sync_file(path));
+    CHECK_THROWS_AS(touca::detail::sync_file(path + ".missing"),
+                    touca::detail::runtime_error);
+  }
+
+  SECTION("sync policy") {
+    CHECK(touca::detail::parse_sync_policy("never") ==
+          touca::detail::SyncPolicy::Never);
+    CHECK(touca::detail::parse_sync_policy("batch") ==
+          touca::detail::SyncPolicy::PerBatch);
+    CHECK_THROWS_AS(touca::detail::parse_sync_policy("always"),
+                    touca::detail::runtime_error);
+  }
+}
@@ -133,4 +133,11 @@ TEST_CASE("configure") {
     CHECK(client.configure(b) == true);
     CHECK(!opts.concurrency);
   }
+  SECTION("compression") {
+    auto a = [](touca::ClientOptions& x) { x.compression = "gzip"; };
+    CHECK(client.configure(a) == false);
+    CHECK_THAT(client.configuration_error(), Catch::Contains("gzip"));
+    auto b = [](touca::ClientOptions& x) { x.compression = "none"; };
+    CHECK(client.configure(b) == true);
+  }
 }
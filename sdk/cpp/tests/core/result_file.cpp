@@ -0,0 +1,343 @@
+// Copyright 2022 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/result_file.hpp"
+
+#include <fstream>
+
+#include "catch2/catch.hpp"
+#include "tests/core/shared.hpp"
+#include "touca/client/detail/client.hpp"
+#include "touca/core/comparison.hpp"
+#include "touca/core/deserialize.hpp"
+#include "touca/impl/schema.hpp"
+
+TEST_CASE("Result File Index") {
+  touca::ClientImpl client;
+  REQUIRE_NOTHROW(client.configure([](touca::ClientOptions& x) {
+    x.team = "acme";
+    x.suite = "students";
+    x.version = "1.0";
+    x.offline = true;
+  }));
+  client.declare_testcase("aanderson");
+  client.check("firstname", touca::data_point::string("alice"));
+  client.declare_testcase("bbrown");
+  client.check("firstname", touca::data_point::string("bob"));
+  client.check("lastname", touca::data_point::string("brown"));
+
+  TmpFile file;
+  client.save(file.path, {}, touca::DataFormat::FBS, true);
+
+  SECTION("read_index") {
+    const auto& index = touca::read_index(file.path);
+    REQUIRE(index.size() == 2u);
+    REQUIRE(index.count("aanderson"));
+    REQUIRE(index.count("bbrown"));
+    CHECK(index.at("aanderson").size != 0u);
+    CHECK(index.at("aanderson").offset != index.at("bbrown").offset);
+  }
+
+  SECTION("read_testcase") {
+    const auto& testcase = touca::read_testcase(file.path, "bbrown");
+    CHECK(testcase.metadata().testcase == "bbrown");
+    CHECK(testcase.overview().keysCount == 2);
+    CHECK_THROWS_AS(touca::read_testcase(file.path, "cchen"),
+                    touca::detail::runtime_error);
+  }
+
+  SECTION("reader") {
+    const touca::ResultFileReader reader(file.path);
+    CHECK(reader.index().size() == 2u);
+    const auto& testcase = touca::deserialize_testcase(
+        reader.read_message("bbrown"), reader.dictionary());
+    CHECK(testcase.metadata().testcase == "bbrown");
+    CHECK(testcase.overview().keysCount == 2);
+    CHECK_THROWS_AS(reader.read_message("cchen"),
+                    touca::detail::runtime_error);
+    const touca::ResultFileReader trusted(file.path,
+                                          touca::VerifyMode::Checksum);
+    CHECK(trusted.read_message("bbrown") == reader.read_message("bbrown"));
+  }
+
+  SECTION("reader with corrupted file") {
+    const auto& entry = touca::read_index(file.path).at("aanderson");
+    auto content = touca::detail::load_text_file(
+        file.path.string(), std::ios::in | std::ios::binary);
+    content[entry.offset + entry.size / 2] ^= 0x5a;
+    std::ofstream ofs(file.path.string(), std::ios::binary);
+    ofs << content;
+    ofs.close();
+    // the checksum is checked once, before any testcase is read
+    CHECK_THROWS_AS(
+        touca::ResultFileReader(file.path, touca::VerifyMode::Checksum),
+        touca::detail::runtime_error);
+    const touca::ResultFileReader reader(file.path, touca::VerifyMode::Lazy);
+    CHECK_NOTHROW(reader.read_message("bbrown"));
+    CHECK_THROWS_AS(reader.read_message("aanderson"),
+                    touca::detail::runtime_error);
+  }
+
+  SECTION("backward compatibility") {
+    const auto& content = touca::deserialize_file(file.path);
+    CHECK(content.size() == 2u);
+
+    TmpFile legacy;
+    const auto& buffer = touca::Testcase::serialize(
+        {touca::read_testcase(file.path, "aanderson")});
+    touca::detail::save_binary_file(legacy.path.string(), buffer);
+    CHECK(touca::read_index(legacy.path).empty());
+    const auto& testcase = touca::read_testcase(legacy.path, "aanderson");
+    CHECK(testcase.overview().keysCount == 1);
+  }
+
+  SECTION("corrupted message") {
+    const auto& entry = touca::read_index(file.path).at("aanderson");
+    auto content = touca::detail::load_text_file(
+        file.path.string(), std::ios::in | std::ios::binary);
+    content[entry.offset + entry.size / 2] ^= 0x5a;
+    std::ofstream ofs(file.path.string(), std::ios::binary);
+    ofs << content;
+    ofs.close();
+    CHECK_THROWS_AS(touca::read_testcase(file.path, "aanderson"),
+                    touca::detail::runtime_error);
+  }
+
+  SECTION("corrupted footer") {
+    // a footer that passes verification but has no index of testcases
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(touca::fbs::CreateFooter(builder));
+    const auto& ptr = builder.GetBufferPointer();
+    std::string content(ptr, ptr + builder.GetSize());
+    const auto size = static_cast<std::uint32_t>(builder.GetSize());
+    for (auto i = 0u; i < 4u; ++i) {
+      content.push_back(static_cast<char>(size >> (8 * i)));
+    }
+    content.append("TIDX");
+    std::ofstream ofs(file.path.string(), std::ios::binary);
+    ofs << content;
+    ofs.close();
+    CHECK_THROWS_AS(touca::read_index(file.path),
+                    touca::detail::runtime_error);
+    CHECK_THROWS_AS(touca::read_testcase(file.path, "aanderson"),
+                    touca::detail::runtime_error);
+  }
+
+  SECTION("checksum") {
+    const auto& read_file = [&file]() {
+      return touca::detail::load_text_file(file.path.string(),
+                                           std::ios::in | std::ios::binary);
+    };
+    CHECK(touca::verify_checksum(read_file()) == touca::ChecksumStatus::Match);
+    CHECK_NOTHROW(
+        touca::load_result_file(file.path, touca::VerifyMode::Checksum));
+
+    const auto& entry = touca::read_index(file.path).at("bbrown");
+    auto content = read_file();
+    content[entry.offset + entry.size / 2] ^= 0x5a;
+    std::ofstream ofs(file.path.string(), std::ios::binary);
+    ofs << content;
+    ofs.close();
+    CHECK(touca::verify_checksum(read_file()) ==
+          touca::ChecksumStatus::Mismatch);
+    CHECK_THROWS_AS(
+        touca::load_result_file(file.path, touca::VerifyMode::Checksum),
+        touca::detail::runtime_error);
+
+    const auto& buffer = touca::Testcase::serialize(
+        {touca::read_testcase(file.path, "aanderson")});
+    CHECK(touca::verify_checksum({buffer.begin(), buffer.end()}) ==
+          touca::ChecksumStatus::Missing);
+  }
+
+  SECTION("string table") {
+    touca::SerializationOptions options;
+    options.string_table = true;
+    auto content = touca::Testcase::serialize(
+        {touca::read_testcase(file.path, "aanderson"),
+         touca::read_testcase(file.path, "bbrown")},
+        options);
+    touca::append_footer(content);
+    TmpFile compact;
+    touca::detail::save_binary_file(compact.path.string(), content);
+
+    CHECK(touca::read_index(compact.path).size() == 2u);
+    const auto& testcase = touca::read_testcase(compact.path, "bbrown");
+    CHECK(testcase.metadata().testsuite == "students");
+    CHECK(testcase.overview().keysCount == 2);
+  }
+
+  SECTION("compression") {
+    const std::vector<touca::Testcase> testcases{
+        touca::read_testcase(file.path, "aanderson"),
+        touca::read_testcase(file.path, "bbrown")};
+    for (const auto codec :
+         {touca::Compression::Zstd, touca::Compression::Lz4}) {
+      if (!touca::is_supported(codec)) {
+        continue;
+      }
+      touca::SerializationOptions options;
+      options.compression = codec;
+      auto content = touca::Testcase::serialize(testcases, options);
+      touca::append_footer(content);
+      TmpFile compressed;
+      touca::detail::save_binary_file(compressed.path.string(), content);
+
+      const auto& index = touca::read_index(compressed.path);
+      REQUIRE(index.count("bbrown"));
+      CHECK(index.at("bbrown").compression == codec);
+      const auto& testcase = touca::read_testcase(compressed.path, "bbrown");
+      CHECK(testcase.overview().keysCount == 2);
+      CHECK(touca::deserialize_file(compressed.path).size() == 2u);
+      const auto& cmp = touca::compare_files(file.path, compressed.path);
+      REQUIRE(cmp.common.count("bbrown"));
+      CHECK(cmp.common.at("bbrown").overview().keysScore == 1.0);
+    }
+  }
+}
+
+TEST_CASE("Result File Writer") {
+  touca::Testcase alice("acme", "students", "1.0", "aanderson");
+  alice.check("firstname", touca::data_point::string("alice"));
+  touca::Testcase bob("acme", "students", "1.0", "bbrown");
+  bob.check("firstname", touca::data_point::string("bob"));
+  bob.check("lastname", touca::data_point::string("brown"));
+  TmpFile file;
+  const auto& read_file = [&file]() {
+    return touca::detail::load_text_file(file.path.string(),
+                                         std::ios::in | std::ios::binary);
+  };
+
+  SECTION("finalize") {
+    touca::ResultFileWriter writer(file.path);
+    writer.append(alice);
+    writer.append(bob);
+    writer.finalize();
+    CHECK_THROWS_AS(writer.append(alice), touca::detail::runtime_error);
+
+    CHECK(touca::is_result_stream(read_file()));
+    CHECK(touca::verify_checksum(read_file()) == touca::ChecksumStatus::Match);
+    CHECK(touca::read_index(file.path).size() == 2u);
+    const auto& testcase = touca::read_testcase(file.path, "bbrown");
+    CHECK(testcase.overview().keysCount == 2);
+    for (const auto mode :
+         {touca::VerifyMode::Full, touca::VerifyMode::Checksum,
+          touca::VerifyMode::Lazy}) {
+      CHECK(touca::deserialize_file(file.path, mode).size() == 2u);
+    }
+  }
+
+  SECTION("interrupted") {
+    {
+      touca::ResultFileWriter writer(file.path);
+      writer.append(alice);
+      writer.append(bob);
+    }
+    // simulate a testcase that was only partially written
+    std::ofstream ofs(file.path.string(), std::ios::binary | std::ios::app);
+    ofs << std::string(20, 'x');
+    ofs.close();
+
+    CHECK(touca::read_records(read_file()).size() == 2u);
+    CHECK(touca::read_index(file.path).empty());
+    CHECK(touca::deserialize_file(file.path).size() == 2u);
+    const auto& testcase = touca::read_testcase(file.path, "aanderson");
+    CHECK(testcase.overview().keysCount == 1);
+
+    touca::Testcase carol("acme", "students", "1.0", "cchen");
+    touca::ResultFileWriter writer(file.path);
+    CHECK(writer.index().size() == 2u);
+    writer.append(carol);
+    writer.finalize();
+    CHECK(touca::read_index(file.path).size() == 3u);
+    CHECK(touca::verify_checksum(read_file()) == touca::ChecksumStatus::Match);
+  }
+
+  SECTION("reopen") {
+    touca::ResultFileWriter first(file.path);
+    first.append(alice);
+    first.finalize();
+    touca::ResultFileWriter second(file.path);
+    second.append(bob);
+    second.finalize();
+    CHECK(touca::read_index(file.path).size() == 2u);
+    CHECK(touca::compare_files(file.path, file.path).common.size() == 2u);
+  }
+
+  SECTION("compaction") {
+    {
+      touca::ResultFileWriter writer(file.path);
+      writer.append(alice);
+      writer.append(bob);
+      writer.finalize();
+    }
+    touca::ResultFileWriter writer(file.path);
+    writer.append(alice);
+    writer.attach("bbrown", "stdout.txt", "first");
+    writer.attach("bbrown", "stdout.txt", "second");
+    writer.append(bob);
+    writer.append(bob);
+    const auto size = read_file().size();
+    writer.finalize();
+
+    // superseded records are dropped once the file is finalized
+    CHECK(read_file().size() < size);
+    CHECK(touca::verify_checksum(read_file()) == touca::ChecksumStatus::Match);
+    CHECK(touca::read_records(read_file()).size() == 2u);
+    CHECK(touca::read_index(file.path).size() == 2u);
+    CHECK(touca::read_testcase(file.path, "bbrown").overview().keysCount == 2);
+    CHECK(touca::read_attachment(file.path, "bbrown", "stdout.txt") ==
+          "second");
+  }
+
+  SECTION("compression") {
+    for (const auto codec :
+         {touca::Compression::Zstd, touca::Compression::Lz4}) {
+      if (!touca::is_supported(codec)) {
+        continue;
+      }
+      TmpFile compressed;
+      touca::SerializationOptions options;
+      options.compression = codec;
+      touca::ResultFileWriter writer(compressed.path, options);
+      writer.append(bob);
+      writer.finalize();
+      const auto& testcase = touca::read_testcase(compressed.path, "bbrown");
+      CHECK(testcase.overview().keysCount == 2);
+      CHECK(touca::deserialize_file(compressed.path).size() == 1u);
+    }
+  }
+
+  SECTION("attachments") {
+    {
+      touca::ResultFileWriter writer(file.path);
+      writer.append(alice);
+      writer.attach("aanderson", "stdout.txt", "first");
+      writer.append(alice);
+      writer.attach("aanderson", "stdout.txt", "second");
+      writer.attach("aanderson", "stderr.txt", std::string("\0x", 2));
+      CHECK(writer.attachments().at("aanderson").size() == 2u);
+    }
+    CHECK(touca::read_records(read_file()).size() == 2u);
+    CHECK(touca::read_attachment(file.path, "aanderson", "stdout.txt") ==
+          "second");
+    CHECK(touca::deserialize_file(file.path).size() == 1u);
+
+    touca::ResultFileWriter writer(file.path);
+    CHECK(writer.index().size() == 1u);
+    CHECK(writer.attachments().at("aanderson").size() == 2u);
+    writer.append(bob);
+    writer.finalize();
+    CHECK(touca::read_index(file.path).size() == 2u);
+    CHECK(touca::read_attachment(file.path, "aanderson", "stderr.txt") ==
+          std::string("\0x", 2));
+    CHECK_THROWS_AS(touca::read_attachment(file.path, "bbrown", "stdout.txt"),
+                    touca::detail::runtime_error);
+  }
+
+  SECTION("not a stream") {
+    touca::detail::save_binary_file(file.path.string(),
+                                    touca::Testcase::serialize({alice}));
+    CHECK_THROWS_AS(touca::ResultFileWriter(file.path),
+                    touca::detail::runtime_error);
+  }
+}
@@ -9,6 +9,8 @@
 #include "fmt/printf.h"
 #include "tests/core/shared.hpp"
 #include "touca/core/config.hpp"
+#include "touca/core/deserialize.hpp"
+#include "touca/core/result_file.hpp"
 #include "touca/runner/detail/helpers.hpp"
 #include "touca/touca.hpp"
 
@@ -354,7 +356,7 @@ TEST_CASE("runner-simple-workflow-valid-use") {
         Catch::Contains(
             R"("teamslug":"some-team","testsuite":"some-suite","version":"1.0","testcase":"4")"));
     CHECK_THAT(fileJson,
-               Catch::Contains(R"({"key":"some-number","value":"1024"})"));
+               Catch::Contains(R"({"key":"some-number","value":1024})"));
     CHECK_THAT(fileJson,
                Catch::Contains(R"({"key":"some-string","value":"foo"})"));
     CHECK_THAT(fileJson, Catch::Contains(R"("assertion":[])"));
@@ -385,3 +387,67 @@ TEST_CASE("runner-redirect-output-disabled") {
   }
   touca::detail::reset_test_runner();
 }
+
+TEST_CASE("runner-archive-results") {
+  using fnames = std::vector<touca::filesystem::path>;
+  touca::workflow("simple_workflow", simple_workflow);
+  MainCaller caller;
+  TmpFile outputDir;
+  TmpFile configFile;
+  configFile.write(
+      R"({ "touca": { "api-url": "https://api.touca.io/@/some-team/some-suite" } })");
+  const std::vector<std::string> args = {
+      "--offline",          "--revision",     "1.0",
+      "--output-directory", outputDir.path.string(),
+      "--config-file",      configFile.path.string(),
+      "--testcase",         "4,8,15,16,23,42",
+      "--save-as-binary",   "--archive",      "--no-color"};
+  caller.call_with(args);
+  touca::filesystem::path archive = outputDir.path;
+  archive = archive / "some-suite" / "1.0" / "touca.bin";
+
+  SECTION("first-run") {
+    CHECK(caller.exit_code() == EXIT_SUCCESS);
+    CHECK_THAT(caller.cout(),
+               Catch::Contains("5 submitted, 1 failed, 6 total"));
+    CHECK(caller.cerr().empty());
+
+    const auto& revisionDirs =
+        ResultChecker(fnames({outputDir.path, "some-suite"}))
+            .get_directories("1.0");
+    CHECK(revisionDirs.empty());
+    const auto& index = touca::read_index(archive);
+    CHECK(index.size() == 5u);
+    CHECK_FALSE(index.count("42"));
+    CHECK(touca::read_testcase(archive, "4").overview().keysCount == 3);
+    CHECK(touca::read_attachment(archive, "8", "stdout.txt") ==
+          "simple message in output stream\n");
+    CHECK(touca::read_attachment(archive, "8", "stderr.txt") ==
+          "simple message in error stream\n");
+  }
+
+  SECTION("second-run-without-overwrite") {
+    caller.call_with(args);
+    CHECK(caller.exit_code() == EXIT_SUCCESS);
+    CHECK_THAT(caller.cout(), Catch::Contains("5.  SKIP   23"));
+    CHECK_THAT(caller.cout(), Catch::Contains("6.  FAIL   42    (0 ms)"));
+    CHECK_THAT(caller.cout(), Catch::Contains("5 skipped, 1 failed, 6 total"));
+    CHECK(touca::read_index(archive).size() == 5u);
+  }
+
+  SECTION("second-run-with-overwrite") {
+    auto overwrite = args;
+    overwrite.push_back("--overwrite");
+    caller.call_with(overwrite);
+    CHECK(caller.exit_code() == EXIT_SUCCESS);
+    CHECK_THAT(caller.cout(),
+               Catch::Contains("5 submitted, 1 failed, 6 total"));
+    CHECK(touca::read_index(archive).size() == 5u);
+    CHECK(touca::deserialize_file(archive).size() == 5u);
+    // results of the first run are dropped when the archive is finalized
+    const auto& content = touca::detail::load_text_file(
+        archive.string(), std::ios::in | std::ios::binary);
+    CHECK(touca::read_records(content).size() == 5u);
+  }
+  touca::detail::reset_test_runner();
+}
@@ -37,7 +37,7 @@ TEST_CASE("Testcase") {
       testcase.add_hit_count("some-other-key");
       testcase.add_hit_count("some-key");
       const auto expected =
-          R"("results":[{"key":"some-key","value":"2"},{"key":"some-other-key","value":"1"}])";
+          R"("results":[{"key":"some-key","value":2},{"key":"some-other-key","value":1}])";
       const auto output = make_json([&testcase](touca::RJAllocator& allocator) {
         return testcase.json(allocator);
       });
@@ -72,7 +72,7 @@ TEST_CASE("Testcase") {
         testcase.add_array_element("some-key", value);
       }
       const auto expected =
-          R"("results":[{"key":"some-key","value":"[0,1,2]"}])";
+          R"("results":[{"key":"some-key","value":[0,1,2]}])";
       const auto output = make_json([&testcase](touca::RJAllocator& allocator) {
         return testcase.json(allocator);
       });
@@ -113,10 +113,10 @@ TEST_CASE("Testcase") {
     });
 
     const auto check1 =
-        R"("results":[{"key":"some-array","value":"[true]"},{"key":"some-key","value":"true"},{"key":"some-new-key","value":"1"}])";
+        R"("results":[{"key":"some-array","value":[true]},{"key":"some-key","value":true},{"key":"some-new-key","value":1}])";
     const auto check2 =
-        R"("assertion":[{"key":"some-other-key","value":"true"}])";
-    const auto check3 = R"("metrics":[{"key":"some-metric","value":"0"}])";
+        R"("assertion":[{"key":"some-other-key","value":true}])";
+    const auto check3 = R"("metrics":[{"key":"some-metric","value":0}])";
     const auto check4 = R"("results":[],"assertion":[],"metrics":[])";
     CHECK_THAT(before, Catch::Contains(check1));
     CHECK_THAT(before, Catch::Contains(check2));
@@ -124,6 +124,32 @@ TEST_CASE("Testcase") {
     CHECK_THAT(after, Catch::Contains(check4));
   }
 
+  SECTION("write_json") {
+    testcase.check("some-key", touca::object("some-name")
+                                   .add("some-member", 1.5)
+                                   .add("some-other-member", "foo"));
+    testcase.assume("some-other-key", data_point::number_signed(-2));
+    testcase.add_metric("some-metric", 10);
+    const auto expected =
+        make_json([&testcase](touca::RJAllocator& allocator) {
+          return testcase.json(allocator);
+        });
+    REQUIRE_THAT(
+        expected,
+        Catch::Contains(
+            R"({"key":"some-key","value":{"some-name":{"some-member":1.5,"some-other-member":"foo"}}})"));
+
+    const std::vector<const touca::Testcase*> testcases{&testcase};
+    CHECK(touca::testcases_to_json(testcases) == '[' + expected + ']');
+
+    TmpFile file;
+    touca::detail::save_file(file.path.string(), [&testcases](std::FILE* out) {
+      touca::write_json(out, testcases);
+    });
+    CHECK(touca::detail::load_text_file(file.path.string()) ==
+          '[' + expected + ']');
+  }
+
   SECTION("overview") {
     const auto value = data_point::boolean(true);
     const auto check_counters =
@@ -0,0 +1,61 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/text_diff.hpp"
+
+#include <string>
+
+#include "catch2/catch.hpp"
+
+using touca::detail::compare_lines;
+
+TEST_CASE("compare lines") {
+  SECTION("identical") {
+    const auto& cmp = compare_lines("a\nb\n", "a\nb\n", 5, 100);
+    CHECK(cmp.src_lines == 3u);
+    CHECK(cmp.common_lines == 3u);
+    CHECK(cmp.complete);
+    CHECK(cmp.hunk_count == 0u);
+    CHECK(cmp.similarity() == 1.0);
+    CHECK(compare_lines("", "", 5, 0).similarity() == 1.0);
+  }
+
+  SECTION("different") {
+    const auto& cmp = compare_lines("a\nb\nc\nd", "a\nx\nc\nd\ne", 1, 100);
+    CHECK(cmp.src_lines == 4u);
+    CHECK(cmp.dst_lines == 5u);
+    CHECK(cmp.common_lines == 3u);
+    CHECK(cmp.similarity() == Approx(2.0 / 3));
+    CHECK(cmp.complete);
+    CHECK(cmp.hunk_count == 2u);
+    REQUIRE(cmp.hunks.size() == 1u);
+    CHECK(cmp.hunks[0].src_line == 1u);
+    CHECK(cmp.hunks[0].src_count == 1u);
+    CHECK(cmp.hunks[0].dst_line == 1u);
+    CHECK(cmp.hunks[0].dst_count == 1u);
+  }
+
+  SECTION("inserted and removed") {
+    const auto& cmp = compare_lines("a\nb\nc", "b\nc\nd", 5, 100);
+    CHECK(cmp.common_lines == 2u);
+    REQUIRE(cmp.hunks.size() == 2u);
+    CHECK(cmp.hunks[0].src_line == 0u);
+    CHECK(cmp.hunks[0].src_count == 1u);
+    CHECK(cmp.hunks[0].dst_count == 0u);
+    CHECK(cmp.hunks[1].src_line == 3u);
+    CHECK(cmp.hunks[1].src_count == 0u);
+    CHECK(cmp.hunks[1].dst_line == 2u);
+    CHECK(cmp.hunks[1].dst_count == 1u);
+  }
+
+  SECTION("budget") {
+    const auto& cmp = compare_lines("a\nb\nc\nd", "a\nx\ny\nd", 5, 3);
+    CHECK_FALSE(cmp.complete);
+    CHECK(cmp.common_lines == 2u);
+    CHECK(cmp.hunk_count == 1u);
+    REQUIRE(cmp.hunks.size() == 1u);
+    CHECK(cmp.hunks[0].src_line == 1u);
+    CHECK(cmp.hunks[0].src_count == 2u);
+    CHECK(cmp.hunks[0].dst_count == 2u);
+    CHECK(compare_lines("a\nb\nc\nd", "a\nx\ny\nd", 5, 4).complete);
+  }
+}
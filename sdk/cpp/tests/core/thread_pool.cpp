@@ -0,0 +1,62 @@
+// Copyright 2023 Touca, Inc. Subject to Apache-2.0 License.
+
+#include "touca/core/thread_pool.hpp"
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "touca/core/filesystem.hpp"
+
+TEST_CASE("thread pool") {
+  touca::detail::ThreadPool pool(4);
+
+  SECTION("size") {
+    CHECK(pool.size() == 4u);
+    CHECK(touca::detail::ThreadPool(1).size() == 1u);
+    CHECK(touca::detail::ThreadPool(0).size() >= 1u);
+  }
+
+  SECTION("run") {
+    std::vector<int> values(1000);
+    std::vector<std::function<void()>> tasks;
+    for (auto i = 0; i < 1000; ++i) {
+      tasks.emplace_back([&values, i]() { values[i] = i; });
+    }
+    pool.run(std::move(tasks));
+    for (auto i = 0; i < 1000; ++i) {
+      CHECK(values[i] == i);
+    }
+  }
+
+  SECTION("nested") {
+    std::atomic<int> sum{0};
+    std::vector<std::function<void()>> tasks;
+    for (auto i = 0; i < 100; ++i) {
+      tasks.emplace_back([&pool, &sum]() {
+        std::vector<std::function<void()>> inner;
+        for (auto j = 0; j < 10; ++j) {
+          inner.emplace_back([&sum]() { ++sum; });
+        }
+        pool.run(std::move(inner));
+      });
+    }
+    pool.run(std::move(tasks));
+    CHECK(sum == 1000);
+  }
+
+  SECTION("errors") {
+    std::atomic<int> count{0};
+    std::vector<std::function<void()>> tasks;
+    tasks.emplace_back([]() { throw std::runtime_error("some error"); });
+    for (auto i = 0; i < 10; ++i) {
+      tasks.emplace_back([&count]() { ++count; });
+    }
+    CHECK_THROWS_WITH(pool.run(std::move(tasks)), "some error");
+    CHECK(count == 10);
+    CHECK_NOTHROW(pool.run({[&count]() { ++count; }}));
+    CHECK(count == 11);
+  }
+}
@@ -228,6 +228,31 @@ TEST_CASE("Simple Data Types") {
       CHECK(cmp.desc.empty());
     }
 
+    SECTION("compare: mismatch lines") {
+      const auto& value = data_point::string("a\nb\nc\nd\nf");
+      const auto& right = data_point::string("a\nx\ny\nc\nd\ne");
+      const auto& cmp = compare(value, right);
+      CHECK(MatchType::None == cmp.match);
+      CHECK(cmp.score == Approx(6.0 / 11));
+      CHECK(cmp.desc.size() == 2u);
+      CHECK(cmp.desc.count("lines 2-3 replaced by line 2"));
+      CHECK(cmp.desc.count("line 6 replaced by line 5"));
+
+      touca::ComparisonOptions options;
+      options.max_hunks = 1;
+      const auto& first = compare(value, right, options);
+      CHECK(first.score == cmp.score);
+      CHECK(first.desc.count("lines 2-3 replaced by line 2"));
+      CHECK(first.desc.count("1 more ranges of lines are different"));
+
+      options.max_line_edits = 2;
+      const auto& partial = compare(value, right, options);
+      CHECK(partial.score == Approx(2.0 / 11));
+      CHECK(partial.desc.count("lines 2-6 replaced by lines 2-5"));
+      CHECK(partial.desc.count(
+          "too many lines are different to compare line by line"));
+    }
+
     SECTION("compare: mismatch type") {
       const auto& value = data_point::string("some_value");
       const auto& right = data_point::boolean(false);
@@ -240,6 +265,19 @@ TEST_CASE("Simple Data Types") {
       CHECK(cmp.score == 0.0);
       CHECK(cmp.desc.count("result types are different"));
     }
+
+    SECTION("compare: preview") {
+      const auto& value = data_point::string("caf\xc3\xa9 au lait");
+      const auto& cmp = compare(value, value);
+      CHECK(cmp.srcValue.str() == "caf\xc3\xa9 au lait");
+      CHECK(cmp.srcValue.str(4) == "caf...");
+      CHECK(cmp.srcValue.str(5) == "caf\xc3\xa9...");
+      auto frozen = cmp.srcValue;
+      frozen.freeze(5);
+      CHECK(frozen.str() == "caf\xc3\xa9...");
+      CHECK(frozen.str(3) == "caf...");
+      CHECK(cmp.dstValue.empty());
+    }
   }
 
   SECTION("type: array") {
@@ -328,6 +366,38 @@ TEST_CASE("Simple Data Types") {
       CHECK(cmp.desc.count("[5]:value is larger by 14.000000"));
     }
 
+    SECTION("compare: mismatch values of type double") {
+      const auto& makeArray = [](const std::vector<double>& vec) {
+        touca::array ret;
+        for (const auto& v : vec) {
+          ret.add(v);
+        }
+        return data_point(ret);
+      };
+      std::vector<double> elements(200, 2.0);
+      const auto left = makeArray(elements);
+      for (auto i = 0u; i < 30u; i++) {
+        elements[i * 5] = 4.0;
+      }
+      const auto right = makeArray(elements);
+      const auto& cmp = compare(left, right);
+      CHECK(MatchType::None == cmp.match);
+      CHECK(cmp.score == Approx(170.0 / 200));
+      CHECK(cmp.desc.size() == 30u);
+      CHECK(cmp.desc.count("[0]:value is smaller by 2.000000"));
+      CHECK(cmp.desc.count("[112]:value is smaller by 2.000000"));
+      CHECK(cmp.dstValue == right.to_string());
+
+      for (auto i = 0u; i < 10u; i++) {
+        elements[i * 5 + 1] = 4.0;
+      }
+      const auto other = makeArray(elements);
+      const auto& cmp2 = compare(left, other);
+      CHECK(MatchType::None == cmp2.match);
+      CHECK(cmp2.score == 0.0);
+      CHECK(cmp2.desc.empty());
+    }
+
     SECTION("compare: mismatch size") {
       const auto& makeArray = [](const size_t length) -> data_point {
         touca::array ret;
@@ -389,6 +459,80 @@ TEST_CASE("Simple Data Types") {
       CHECK(MatchType::None == cmp.match);
       CHECK(cmp.score == 0.6);
     }
+
+    SECTION("compare: nested") {
+      touca::object left("creature");
+      left.add("heads", std::vector<Head>{Head(1), Head(2)});
+      left.add("legs", std::vector<int>{1, 2, 3});
+      touca::object right("creature");
+      right.add("heads", std::vector<Head>{Head(1), Head(3), Head(4)});
+      right.add("arms", 2);
+      const data_point src(left);
+      const data_point dst(right);
+      const auto& cmp = compare(src, dst);
+
+      CHECK(MatchType::None == cmp.match);
+      CHECK(cmp.score == Approx(1.0 / 7));
+      CHECK(cmp.desc.size() == 6u);
+      CHECK(cmp.desc.count("heads.[1]eyes: value is smaller by 1.000000"));
+      CHECK(cmp.desc.count("heads.[2]eyes: new"));
+      CHECK(cmp.desc.count("legs.[0]: missing"));
+      CHECK(cmp.desc.count("legs.[2]: missing"));
+      CHECK(cmp.desc.count("arms: new"));
+    }
+
+    SECTION("compare: arrays aligned by identity") {
+      const auto& make = [](const std::vector<std::pair<int, int>>& vec) {
+        touca::array ret;
+        for (const auto& v : vec) {
+          ret.add(data_point(touca::object("record")
+                                 .add("id", v.first)
+                                 .add("score", v.second)));
+        }
+        return data_point(ret);
+      };
+      const auto& left = make({{1, 10}, {2, 20}, {3, 30}, {4, 40}, {5, 50}});
+      const auto& right = make({{0, 0}, {1, 10}, {2, 20}, {3, 40}, {4, 40}});
+      touca::ComparisonOptions options;
+      options.array_alignment = touca::ArrayAlignment::Identity;
+      options.identity_member = "id";
+      const auto& cmp = compare(left, right, options);
+      CHECK(MatchType::None == cmp.match);
+      CHECK(cmp.score == Approx(7.0 / 12));
+      CHECK(cmp.desc.size() == 5u);
+      CHECK(cmp.desc.count("[2]score: value is smaller by 10.000000"));
+      CHECK(cmp.desc.count("[4]id: missing"));
+      CHECK(cmp.desc.count("[0]id: new"));
+      CHECK(cmp.dstValue == right.to_string());
+      CHECK(compare(left, right).score < cmp.score);
+
+      options.identity_member.clear();
+      const auto& byContent = compare(left, right, options);
+      CHECK(byContent.score == Approx(6.0 / 14));
+      CHECK(byContent.desc.count("[2]score: missing"));
+      CHECK(byContent.desc.count("[3]score: new"));
+
+      const auto& shuffled =
+          make({{5, 50}, {3, 30}, {1, 10}, {4, 40}, {2, 20}});
+      const auto& moved = compare(left, shuffled, options);
+      CHECK(MatchType::Perfect == moved.match);
+      CHECK(moved.desc.empty());
+    }
+
+    SECTION("to_string: reuse buffer") {
+      touca::object obj("head");
+      obj.add("eyes", 2);
+      obj.add("ratio", 0.25);
+      const auto& value = touca::data_point(obj);
+      std::string buffer = "previous content";
+      value.to_string(buffer);
+      CHECK(buffer == value.to_string());
+      CHECK(buffer == R"({"head":{"eyes":2,"ratio":0.25}})");
+      touca::data_point::number_signed(-7).to_string(buffer);
+      CHECK(buffer == "-7");
+      touca::data_point::string("some_value").to_string(buffer);
+      CHECK(buffer == "some_value");
+    }
   }
 
   SECTION("type: standard") {